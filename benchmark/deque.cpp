@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+#include <cfloat>
+#include <chrono>
+#include <deque>
+#include <queue>
+
+#include <acul/deque.hpp>
+#include <acul/queue.hpp>
+#include <acul/vector.hpp>
+#include <oneapi/tbb/scalable_allocator.h>
+
+#define BENCHMARK_WINDOW_TIME 100
+
+#define RUN_BENCHMARK(state, ops_per_iter, bytes_per_op, SETUP_BLOCK, BODY_BLOCK)                                      \
+    do {                                                                                                               \
+        const double target_ms = BENCHMARK_WINDOW_TIME;                                                                \
+        const double target_s = target_ms / 1000.0;                                                                    \
+        double min_cps = DBL_MAX, max_cps = 0.0;                                                                       \
+        double total_dt = 0.0;                                                                                         \
+        uint64_t total_ops = 0;                                                                                        \
+        for (auto _ : state)                                                                                           \
+        {                                                                                                              \
+            double acc_dt = 0.0;                                                                                       \
+            uint64_t acc_ops = 0;                                                                                      \
+            do {                                                                                                       \
+                state.PauseTiming();                                                                                   \
+                {SETUP_BLOCK} state.ResumeTiming();                                                                    \
+                auto t0 = std::chrono::high_resolution_clock::now();                                                   \
+                {                                                                                                      \
+                    BODY_BLOCK                                                                                         \
+                }                                                                                                      \
+                auto t1 = std::chrono::high_resolution_clock::now();                                                   \
+                double dt = std::chrono::duration<double>(t1 - t0).count();                                            \
+                acc_dt += dt;                                                                                          \
+                acc_ops += (ops_per_iter);                                                                             \
+            } while (acc_dt < target_s);                                                                               \
+            const double cps = acc_ops / acc_dt;                                                                       \
+            if (cps < min_cps) min_cps = cps;                                                                          \
+            if (cps > max_cps) max_cps = cps;                                                                          \
+            total_dt += acc_dt;                                                                                        \
+            total_ops += acc_ops;                                                                                      \
+            state.SetIterationTime(acc_dt);                                                                            \
+        }                                                                                                              \
+        const double cps_avg = (total_dt > 0.0) ? (double(total_ops) / total_dt) : 0.0;                                \
+        state.counters["cps_avg"] = cps_avg;                                                                           \
+        state.counters["cps_min"] = min_cps;                                                                           \
+        state.counters["cps_max"] = max_cps;                                                                           \
+        state.counters["bw_mib_s"] = benchmark::Counter(cps_avg * double(bytes_per_op), benchmark::Counter::kDefaults, \
+                                                        benchmark::Counter::kIs1024);                                  \
+    } while (0)
+
+// The previous acul::deque and acul::queue aliases, kept here as the baseline
+template <typename T>
+using std_deque = std::deque<T, oneapi::tbb::scalable_allocator<T>>;
+
+template <typename T>
+using std_queue = std::queue<T, std_deque<T>>;
+
+template <typename T>
+using native_queue = std::queue<T, acul::deque<T>>;
+
+struct Payload
+{
+    u64 id;
+    u64 data[3];
+};
+
+// Steady FIFO: a window of `n` elements in flight, each round pushes and pops n elements, so the containers
+// cycle through their storage the way task and event queues do.
+
+template <class Q>
+static void BM_fifo_impl(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Q q;
+    for (size_t i = 0; i < n; ++i) q.push(Payload{i, {}});
+    RUN_BENCHMARK(state, n, sizeof(Payload), { (void)0; }, {
+        u64 sum = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += q.front().id;
+            q.pop();
+            q.push(Payload{i, {}});
+        }
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_fifo_std_queue(benchmark::State &state) { BM_fifo_impl<std_queue<Payload>>(state); }
+BENCHMARK(BM_fifo_std_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+static void BM_fifo_deque_queue(benchmark::State &state) { BM_fifo_impl<native_queue<Payload>>(state); }
+BENCHMARK(BM_fifo_deque_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+static void BM_fifo_ring_queue(benchmark::State &state) { BM_fifo_impl<acul::ring_queue<Payload>>(state); }
+BENCHMARK(BM_fifo_ring_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+// Burst: fill an empty queue with n elements and drain it, growth included.
+
+template <class Q>
+static void BM_burst_impl(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    RUN_BENCHMARK(state, n, sizeof(Payload), { (void)0; }, {
+        Q q;
+        for (size_t i = 0; i < n; ++i) q.push(Payload{i, {}});
+        u64 sum = 0;
+        while (!q.empty())
+        {
+            sum += q.front().id;
+            q.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_burst_std_queue(benchmark::State &state) { BM_burst_impl<std_queue<Payload>>(state); }
+BENCHMARK(BM_burst_std_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+static void BM_burst_deque_queue(benchmark::State &state) { BM_burst_impl<native_queue<Payload>>(state); }
+BENCHMARK(BM_burst_deque_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+static void BM_burst_ring_queue(benchmark::State &state) { BM_burst_impl<acul::ring_queue<Payload>>(state); }
+BENCHMARK(BM_burst_ring_queue)->RangeMultiplier(16)->Range(16, 1 << 16)->UseManualTime();
+
+// Both ends: push at the front and back alternately, then index every element.
+
+template <class D>
+static void BM_deque_both_ends_impl(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    RUN_BENCHMARK(state, n, sizeof(u64), { (void)0; }, {
+        D d;
+        for (size_t i = 0; i < n; ++i)
+            if (i & 1) d.push_back(i);
+            else d.push_front(i);
+        u64 sum = 0;
+        for (size_t i = 0; i < n; ++i) sum += d[i];
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_deque_both_ends_std(benchmark::State &state) { BM_deque_both_ends_impl<std_deque<u64>>(state); }
+BENCHMARK(BM_deque_both_ends_std)->RangeMultiplier(16)->Range(256, 1 << 20)->UseManualTime();
+
+static void BM_deque_both_ends_acul(benchmark::State &state) { BM_deque_both_ends_impl<acul::deque<u64>>(state); }
+BENCHMARK(BM_deque_both_ends_acul)->RangeMultiplier(16)->Range(256, 1 << 20)->UseManualTime();
+
+// Random access into a filled deque.
+
+template <class D>
+static void BM_deque_random_index_impl(benchmark::State &state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    D d;
+    for (size_t i = 0; i < n; ++i) d.push_back(i);
+    acul::vector<u32> order(n);
+    u64 x = 0x9E3779B97F4A7C15ULL;
+    for (auto &index : order)
+    {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        index = static_cast<u32>(x % n);
+    }
+    RUN_BENCHMARK(state, n, sizeof(u64), { (void)0; }, {
+        u64 sum = 0;
+        for (u32 index : order) sum += d[index];
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_deque_random_index_std(benchmark::State &state)
+{
+    BM_deque_random_index_impl<std_deque<u64>>(state);
+}
+BENCHMARK(BM_deque_random_index_std)->RangeMultiplier(16)->Range(256, 1 << 20)->UseManualTime();
+
+static void BM_deque_random_index_acul(benchmark::State &state)
+{
+    BM_deque_random_index_impl<acul::deque<u64>>(state);
+}
+BENCHMARK(BM_deque_random_index_acul)->RangeMultiplier(16)->Range(256, 1 << 20)->UseManualTime();
+
+BENCHMARK_MAIN();
@@ -8,6 +8,7 @@
 #include <absl/container/flat_hash_map.h>
 #include <acul/hash/hashmap.hpp>
 #include <acul/hash/hl_hashmap.hpp>
+#include <acul/string/inline_string.hpp>
 #include <acul/string/string.hpp>
 #include <llvm/ADT/DenseMap.h>
 #include <unordered_map>
@@ -167,6 +168,16 @@ static void shuffle(acul::vector<T> &v, uint64_t seed = 1234567)
     std::shuffle(v.begin(), v.end(), rng);
 }
 
+/// 40-character keys: past the SSO buffer of acul::string, inside the capacity of the inline string.
+template <class K>
+static acul::vector<K> gen_inline_strings(size_t N)
+{
+    acul::vector<K> out;
+    out.reserve(N);
+    for (const auto &s : gen_strings(N, 40)) out.emplace_back(s.c_str(), s.size());
+    return out;
+}
+
 template <class K>
 static acul::vector<K> make_keys(size_t N)
 {
@@ -174,6 +185,8 @@ static acul::vector<K> make_keys(size_t N)
         return gen_u64(N);
     else if constexpr (std::is_same_v<K, Vec3f>)
         return gen_vec3(N);
+    else if constexpr (std::is_same_v<K, acul::inline_string<48>>)
+        return gen_inline_strings<K>(N);
     else
         return gen_strings(N);
 }
@@ -569,4 +582,12 @@ REG_ALL_FOR(Absl, acul::string)
 REG_ALL_FOR(LLVMDenseMap, acul::string)
 REG_ALL_FOR(StdMap, acul::string)
 
+// acul::inline_string
+REG_ALL_FOR(Acul, acul::inline_string<48>)
+REG_ALL_FOR(AculHL, acul::inline_string<48>)
+REG_ALL_FOR(EmhashMap5, acul::inline_string<48>)
+REG_ALL_FOR(EmhashMap7, acul::inline_string<48>)
+REG_ALL_FOR(Absl, acul::inline_string<48>)
+REG_ALL_FOR(StdMap, acul::inline_string<48>)
+
 BENCHMARK_MAIN();
\ No newline at end of file
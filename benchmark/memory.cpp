@@ -0,0 +1,207 @@
+#include <benchmark/benchmark.h>
+#include <cfloat>
+#include <chrono>
+
+#include <acul/hash/hashmap.hpp>
+#include <acul/hash/hl_hashmap.hpp>
+#include <acul/list.hpp>
+#include <acul/memory/arena.hpp>
+#include <acul/memory/huge_pages.hpp>
+#include <acul/memory/pool.hpp>
+#include <acul/string/string.hpp>
+#include <acul/vector.hpp>
+
+#define BENCHMARK_WINDOW_TIME 100
+
+#define RUN_BENCHMARK(state, ops_per_iter, bytes_per_op, SETUP_BLOCK, BODY_BLOCK)                                      \
+    do {                                                                                                               \
+        const double target_ms = BENCHMARK_WINDOW_TIME;                                                                \
+        const double target_s = target_ms / 1000.0;                                                                    \
+        double min_cps = DBL_MAX, max_cps = 0.0;                                                                       \
+        double total_dt = 0.0;                                                                                         \
+        uint64_t total_ops = 0;                                                                                        \
+        for (auto _ : state)                                                                                           \
+        {                                                                                                              \
+            double acc_dt = 0.0;                                                                                       \
+            uint64_t acc_ops = 0;                                                                                      \
+            do {                                                                                                       \
+                state.PauseTiming();                                                                                   \
+                {SETUP_BLOCK} state.ResumeTiming();                                                                    \
+                auto t0 = std::chrono::high_resolution_clock::now();                                                   \
+                {                                                                                                      \
+                    BODY_BLOCK                                                                                         \
+                }                                                                                                      \
+                auto t1 = std::chrono::high_resolution_clock::now();                                                   \
+                double dt = std::chrono::duration<double>(t1 - t0).count();                                            \
+                acc_dt += dt;                                                                                          \
+                acc_ops += (ops_per_iter);                                                                             \
+            } while (acc_dt < target_s);                                                                               \
+            const double cps = acc_ops / acc_dt;                                                                       \
+            if (cps < min_cps) min_cps = cps;                                                                          \
+            if (cps > max_cps) max_cps = cps;                                                                          \
+            total_dt += acc_dt;                                                                                        \
+            total_ops += acc_ops;                                                                                      \
+            state.SetIterationTime(acc_dt);                                                                            \
+        }                                                                                                              \
+        const double cps_avg = (total_dt > 0.0) ? (double(total_ops) / total_dt) : 0.0;                                \
+        state.counters["cps_avg"] = cps_avg;                                                                           \
+        state.counters["cps_min"] = min_cps;                                                                           \
+        state.counters["cps_max"] = max_cps;                                                                           \
+        state.counters["bw_mib_s"] = benchmark::Counter(cps_avg * double(bytes_per_op), benchmark::Counter::kDefaults, \
+                                                        benchmark::Counter::kIs1024);                                  \
+    } while (0)
+
+// Build-and-discard workloads: scratch containers filled and dropped once per round, the way per-frame or
+// per-request data is used. The arena variants pay for the reset inside the timed body.
+
+template <template <class> class Alloc>
+static size_t build_containers(size_t n)
+{
+    using str = acul::basic_string<char, Alloc<char>>;
+    acul::vector<u64, Alloc<u64>> numbers;
+    acul::list<u64, Alloc<u64>> nodes;
+    acul::hashmap<u64, u64, Alloc<std::byte>> map;
+    acul::vector<str, Alloc<str>> names;
+    for (size_t i = 0; i < n; ++i)
+    {
+        numbers.push_back(i);
+        nodes.push_back(i);
+        map[i * 0x9E3779B97F4A7C15ULL] = i;
+        names.emplace_back("scratch-name-longer-than-the-inline-buffer");
+    }
+    return numbers.size() + nodes.size() + map.size() + names.size();
+}
+
+static void BM_build_discard_heap(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    RUN_BENCHMARK(state, N, 0, { (void)0; }, { benchmark::DoNotOptimize(build_containers<acul::mem_allocator>(N)); });
+}
+BENCHMARK(BM_build_discard_heap)->Arg(1'000)->Arg(100'000)->UseManualTime();
+
+static void BM_build_discard_arena(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    acul::arena arena;
+    RUN_BENCHMARK(state, N, 0, { (void)0; }, {
+        {
+            acul::arena_scope scope(arena);
+            benchmark::DoNotOptimize(build_containers<acul::arena_allocator>(N));
+        }
+        arena.reset();
+    });
+}
+BENCHMARK(BM_build_discard_arena)->Arg(1'000)->Arg(100'000)->UseManualTime();
+
+template <template <class> class Alloc>
+static size_t build_nodes(size_t n)
+{
+    acul::list<u64, Alloc<u64>> nodes;
+    for (size_t i = 0; i < n; ++i) nodes.push_back(i);
+    return nodes.size();
+}
+
+static void BM_list_nodes_heap(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    RUN_BENCHMARK(state, N, sizeof(u64), { (void)0; },
+                  { benchmark::DoNotOptimize(build_nodes<acul::mem_allocator>(N)); });
+}
+BENCHMARK(BM_list_nodes_heap)->Arg(100'000)->UseManualTime();
+
+static void BM_list_nodes_arena(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    acul::arena arena;
+    RUN_BENCHMARK(state, N, sizeof(u64), { (void)0; }, {
+        {
+            acul::arena_scope scope(arena);
+            benchmark::DoNotOptimize(build_nodes<acul::arena_allocator>(N));
+        }
+        arena.reset();
+    });
+}
+BENCHMARK(BM_list_nodes_arena)->Arg(100'000)->UseManualTime();
+
+template <typename T>
+using pool_alloc = acul::pool_allocator<T>;
+
+static void BM_list_nodes_pool(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    RUN_BENCHMARK(state, N, sizeof(u64), { (void)0; }, { benchmark::DoNotOptimize(build_nodes<pool_alloc>(N)); });
+}
+BENCHMARK(BM_list_nodes_pool)->Arg(100'000)->UseManualTime();
+
+// Churn: nodes leave at the front and come back at the back between traversals, interleaved with other
+// allocations of the same size the way unrelated code shares the heap.
+template <template <class> class Alloc>
+static void BM_list_churn_impl(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    acul::list<u64, Alloc<u64>> nodes;
+    acul::vector<acul::list<u64, Alloc<u64>>> noise(64);
+    for (size_t i = 0; i < N; ++i)
+    {
+        nodes.push_back(i);
+        noise[i & 63].push_back(i);
+    }
+    RUN_BENCHMARK(state, N, sizeof(u64), { (void)0; }, {
+        for (size_t i = 0; i < N / 4; ++i)
+        {
+            nodes.pop_front();
+            noise[i & 63].pop_front();
+            noise[i & 63].push_back(i);
+            nodes.push_back(i);
+        }
+        u64 sum = 0;
+        for (u64 v : nodes) sum += v;
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_list_churn_heap(benchmark::State &state) { BM_list_churn_impl<acul::mem_allocator>(state); }
+BENCHMARK(BM_list_churn_heap)->Arg(100'000)->UseManualTime();
+
+static void BM_list_churn_pool(benchmark::State &state) { BM_list_churn_impl<pool_alloc>(state); }
+BENCHMARK(BM_list_churn_pool)->Arg(100'000)->UseManualTime();
+
+// Random lookups in a table far beyond the TLB reach of 4 KiB pages. The argument is the number of entries,
+// 1 << 27 of them take 2^28 buckets of 16 bytes, a 4 GiB table.
+template <class Allocator>
+static void BM_hl_find_random_impl(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    acul::hl_hashmap<u64, u64, std::hash<u64>, std::equal_to<u64>, Allocator> map;
+    map.reserve(N);
+    for (size_t i = 0; i < N; ++i) map[i * 0x9E3779B97F4A7C15ULL] = i;
+
+    acul::vector<u64> keys(1 << 20);
+    u64 x = 88172645463325252ULL;
+    for (auto &k : keys)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        k = (x % N) * 0x9E3779B97F4A7C15ULL;
+    }
+    RUN_BENCHMARK(state, keys.size(), 0, { (void)0; }, {
+        u64 sum = 0;
+        for (u64 k : keys) sum += map.find(k)->second;
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+static void BM_hl_find_random_heap(benchmark::State &state)
+{
+    BM_hl_find_random_impl<acul::mem_allocator<std::byte>>(state);
+}
+BENCHMARK(BM_hl_find_random_heap)->Arg(1 << 27)->UseManualTime();
+
+static void BM_hl_find_random_huge_pages(benchmark::State &state)
+{
+    BM_hl_find_random_impl<acul::huge_page_allocator<std::byte>>(state);
+}
+BENCHMARK(BM_hl_find_random_huge_pages)->Arg(1 << 27)->UseManualTime();
+
+BENCHMARK_MAIN();
@@ -6,6 +6,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <acul/memory/intrusive_ptr.hpp>
 #include <acul/memory/smart_ptr.hpp>
 #include <acul/string/string.hpp>
 #include <acul/vector.hpp>
@@ -78,7 +79,7 @@ struct is_std_shared_ptr<std::shared_ptr<T>> : std::true_type
 
 namespace acul
 {
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, typename RefPolicy>
     class shared_ptr;
 }
 
@@ -86,8 +87,8 @@ template <class>
 struct is_acul_shared_ptr : std::false_type
 {
 };
-template <class T, class Alloc>
-struct is_acul_shared_ptr<acul::shared_ptr<T, Alloc>> : std::true_type
+template <class T, class Alloc, class Policy>
+struct is_acul_shared_ptr<acul::shared_ptr<T, Alloc, Policy>> : std::true_type
 {
 };
 
@@ -98,8 +99,8 @@ struct pointee<std::shared_ptr<T>>
 {
     using type = T;
 };
-template <class T, class Alloc>
-struct pointee<acul::shared_ptr<T, Alloc>>
+template <class T, class Alloc, class Policy>
+struct pointee<acul::shared_ptr<T, Alloc, Policy>>
 {
     using type = T;
 };
@@ -118,6 +119,10 @@ Ptr make_shared_for_ptr(Args &&...args)
     using P = std::decay_t<Ptr>;
     using T = pointee_t<P>;
     if constexpr (is_std_shared_ptr<P>::value) { return std::make_shared<T>(std::forward<Args>(args)...); }
+    else if constexpr (std::is_same_v<P, acul::ts_shared_ptr<T>>)
+    {
+        return acul::make_ts_shared<T>(std::forward<Args>(args)...);
+    }
     else if constexpr (is_acul_shared_ptr<P>::value) { return acul::make_shared<T>(std::forward<Args>(args)...); }
     else { static_assert(dependent_false<P>::value, "Ptr must be std::shared_ptr<T> or acul::shared_ptr<T, Alloc>"); }
 }
@@ -151,6 +156,10 @@ template <class T>
 using AculSP = acul::shared_ptr<T>;
 template <class T>
 using AculWP = acul::weak_ptr<T>;
+template <class T>
+using TsSP = acul::ts_shared_ptr<T>;
+template <class T>
+using TsWP = acul::ts_weak_ptr<T>;
 
 template <class T>
 static const char *type_name()
@@ -164,6 +173,8 @@ static const char *sp_name()
 {
     if constexpr (std::is_same_v<SP<T>, AculSP<T>>)
         return "acul::shared_ptr";
+    else if constexpr (std::is_same_v<SP<T>, TsSP<T>>)
+        return "acul::ts_shared_ptr";
     else
         return "std::shared_ptr";
 }
@@ -172,6 +183,8 @@ static const char *wp_name()
 {
     if constexpr (std::is_same_v<WP<T>, AculWP<T>>)
         return "acul::weak_ptr";
+    else if constexpr (std::is_same_v<WP<T>, TsWP<T>>)
+        return "acul::ts_weak_ptr";
     else
         return "std::weak_ptr";
 }
@@ -393,6 +406,144 @@ static void BM_sp_deref(benchmark::State &state)
 }
 
 
+// Every thread copies and drops owners of the same object, so the count lives in a contended cache line.
+// Only the thread-safe pointers take part: the local policy is not meant to be shared across threads.
+template <template <class> class SP, class T>
+static void BM_sp_mt_copy_reset(benchmark::State &state)
+{
+    using SPT = SP<T>;
+    static SPT shared;
+    if (state.thread_index() == 0) shared = make_shared_for_ptr<SPT>(T{});
+    const size_t N = size_t(state.range(0));
+
+    state.SetLabel(std::string("mt_copy_reset<") + type_name<T>() + "> " + sp_name<SP, T>());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            SPT p = shared;
+            benchmark::DoNotOptimize(p);
+            p.reset();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(N));
+    if (state.thread_index() == 0) shared.reset();
+}
+
+// Hot shared objects: the same payload held by pointers with a separate control block and by intrusive_ptr,
+// which keeps the count inside the object.
+struct HotNode
+{
+    uint64_t value;
+    explicit HotNode(uint64_t v = 0) noexcept : value(v) {}
+};
+
+template <class Policy>
+struct IntrusiveHotNode : acul::ref_counted<IntrusiveHotNode<Policy>, Policy>
+{
+    uint64_t value;
+    explicit IntrusiveHotNode(uint64_t v = 0) noexcept : value(v) {}
+};
+
+using HotAcul = acul::shared_ptr<HotNode>;
+using HotAculTs = acul::ts_shared_ptr<HotNode>;
+using HotStd = std::shared_ptr<HotNode>;
+using HotIntrusive = acul::intrusive_ptr<IntrusiveHotNode<acul::local_ref_policy>>;
+using HotIntrusiveTs = acul::intrusive_ptr<IntrusiveHotNode<acul::atomic_ref_policy>>;
+
+template <class Ptr>
+static const char *hot_name()
+{
+    if constexpr (std::is_same_v<Ptr, HotAcul>) return "acul::shared_ptr";
+    if constexpr (std::is_same_v<Ptr, HotAculTs>) return "acul::ts_shared_ptr";
+    if constexpr (std::is_same_v<Ptr, HotStd>) return "std::shared_ptr";
+    if constexpr (std::is_same_v<Ptr, HotIntrusive>) return "acul::intrusive_ptr";
+    return "acul::intrusive_ptr (atomic)";
+}
+
+template <class Ptr>
+static Ptr make_hot(uint64_t v)
+{
+    if constexpr (std::is_same_v<Ptr, HotAcul>) return acul::make_shared<HotNode>(v);
+    else if constexpr (std::is_same_v<Ptr, HotAculTs>) return acul::make_ts_shared<HotNode>(v);
+    else if constexpr (std::is_same_v<Ptr, HotStd>) return std::make_shared<HotNode>(v);
+    else return acul::make_intrusive<typename Ptr::element_type>(v);
+}
+
+/// Takes ownership of an object created without the pointer, the case that costs shared_ptr a control block.
+template <class Ptr>
+static Ptr adopt_hot(uint64_t v)
+{
+    if constexpr (std::is_same_v<Ptr, HotStd>) return HotStd(new HotNode(v));
+    else if constexpr (is_acul_shared_ptr<Ptr>::value) return Ptr(acul::alloc<HotNode>(v));
+    else return Ptr(acul::alloc<typename Ptr::element_type>(v));
+}
+
+template <class Ptr>
+static void BM_hot_make_reset(benchmark::State &state)
+{
+    const size_t N = size_t(state.range(0));
+    state.SetLabel(std::string("make_reset ") + hot_name<Ptr>());
+
+    RUN_BENCHMARK(state, N, sizeof(HotNode), {/* no-op */}, ([&] {
+                      for (size_t i = 0; i < N; ++i)
+                      {
+                          Ptr p = make_hot<Ptr>(i);
+                          benchmark::DoNotOptimize(p);
+                      }
+                      benchmark::ClobberMemory();
+                  }()););
+}
+
+template <class Ptr>
+static void BM_hot_adopt_reset(benchmark::State &state)
+{
+    const size_t N = size_t(state.range(0));
+    state.SetLabel(std::string("adopt_reset ") + hot_name<Ptr>());
+
+    RUN_BENCHMARK(state, N, sizeof(HotNode), {/* no-op */}, ([&] {
+                      for (size_t i = 0; i < N; ++i)
+                      {
+                          Ptr p = adopt_hot<Ptr>(i);
+                          benchmark::DoNotOptimize(p);
+                      }
+                      benchmark::ClobberMemory();
+                  }()););
+}
+
+// A caller takes a reference to a shared object, reads it and lets it go: the pattern of tasks and handlers
+// passed around by value.
+template <class Ptr>
+static void BM_hot_copy_deref_release(benchmark::State &state)
+{
+    const size_t N = size_t(state.range(0));
+    acul::vector<Ptr> owners;
+    owners.reserve(N);
+    for (size_t i = 0; i < N; ++i) owners.push_back(adopt_hot<Ptr>(i));
+    // Visit the objects out of allocation order, so each one is a cache miss as it is for hot objects
+    acul::vector<size_t> order(N);
+    for (size_t i = 0; i < N; ++i) order[i] = (i * 7919) % N;
+
+    state.SetLabel(std::string("copy_deref_release ") + hot_name<Ptr>());
+
+    RUN_BENCHMARK(state, N, sizeof(HotNode), {/* no-op */}, ([&] {
+                      uint64_t sink = 0;
+                      for (size_t i = 0; i < N; ++i)
+                      {
+                          Ptr p = owners[order[i]];
+                          sink += p->value;
+                      }
+                      benchmark::DoNotOptimize(sink);
+                      benchmark::ClobberMemory();
+                  }()););
+}
+
+#define REG_HOT_SET(Ptr, N)                                                      \
+    BENCHMARK_TEMPLATE(BM_hot_make_reset, Ptr)->Arg(N)->UseManualTime();        \
+    BENCHMARK_TEMPLATE(BM_hot_adopt_reset, Ptr)->Arg(N)->UseManualTime();       \
+    BENCHMARK_TEMPLATE(BM_hot_copy_deref_release, Ptr)->Arg(N)->UseManualTime();
+
 #define REG_SHARED_SET(SP, WP, T, N)                                         \
     BENCHMARK_TEMPLATE(BM_sp_make_reset, SP, T)->Arg(N)->UseManualTime();    \
     BENCHMARK_TEMPLATE(BM_sp_copy, SP, T)->Arg(N)->UseManualTime();          \
@@ -412,8 +563,19 @@ using AculWP = acul::weak_ptr<T>;
 
 REG_SHARED_SET(AculSP, AculWP, uint64_t, 10000)
 REG_SHARED_SET(StdSP, StdWP, uint64_t, 10000)
+REG_SHARED_SET(TsSP, TsWP, uint64_t, 10000)
 
 REG_SHARED_SET(AculSP, AculWP, NonTriv, 10000)
 REG_SHARED_SET(StdSP, StdWP, NonTriv, 10000)
+REG_SHARED_SET(TsSP, TsWP, NonTriv, 10000)
+
+REG_HOT_SET(HotAcul, 1 << 20)
+REG_HOT_SET(HotAculTs, 1 << 20)
+REG_HOT_SET(HotStd, 1 << 20)
+REG_HOT_SET(HotIntrusive, 1 << 20)
+REG_HOT_SET(HotIntrusiveTs, 1 << 20)
+
+BENCHMARK_TEMPLATE(BM_sp_mt_copy_reset, TsSP, uint64_t)->Arg(10000)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_sp_mt_copy_reset, StdSP, uint64_t)->Arg(10000)->ThreadRange(1, 8)->UseRealTime();
 
 BENCHMARK_MAIN();
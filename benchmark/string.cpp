@@ -1,15 +1,24 @@
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <cfloat>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <random>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <acul/io/fs/file.hpp>
 #include <acul/io/path.hpp>
+#include <acul/string/line_index.hpp>
+#include <acul/string/multi_search.hpp>
 #include <acul/string/sstream.hpp>
 #include <acul/string/string.hpp>
+#include <acul/string/string_view_pool.hpp>
+#include <acul/string/tokenizer.hpp>
 #include <acul/string/utils.hpp>
 #include <acul/vector.hpp>
 
@@ -248,6 +257,103 @@ static void BM_to_string_u64_std(benchmark::State &state)
 }
 BENCHMARK(BM_to_string_u64_std)->Arg(5'000'000)->UseManualTime();
 
+static std::vector<double> gen_doubles(size_t N, uint64_t seed = 1234567)
+{
+    std::vector<double> out;
+    out.reserve(N);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+    for (size_t i = 0; i < N; ++i) out.push_back(mantissa(rng) * std::pow(10.0, exponent(rng)));
+    return out;
+}
+
+static void BM_to_string_f64_acul(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    auto data = gen_doubles(N);
+    const size_t OPS = N;
+    const size_t BYTES = sizeof(double);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            char buf[64];
+            size_t total = 0;
+            for (size_t i = 0; i < N; ++i) total += acul::to_string(data[i], buf, sizeof(buf));
+            benchmark::DoNotOptimize(total);
+        });
+}
+BENCHMARK(BM_to_string_f64_acul)->Arg(1'000'000)->UseManualTime();
+
+static void BM_to_string_f64_to_chars(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    auto data = gen_doubles(N);
+    const size_t OPS = N;
+    const size_t BYTES = sizeof(double);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            char buf[64];
+            size_t total = 0;
+            for (size_t i = 0; i < N; ++i) total += std::to_chars(buf, buf + sizeof(buf), data[i]).ptr - buf;
+            benchmark::DoNotOptimize(total);
+        });
+}
+BENCHMARK(BM_to_string_f64_to_chars)->Arg(1'000'000)->UseManualTime();
+
+static void BM_to_string_f64_snprintf(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    auto data = gen_doubles(N);
+    const size_t OPS = N;
+    const size_t BYTES = sizeof(double);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            char buf[64];
+            size_t total = 0;
+            for (size_t i = 0; i < N; ++i) total += snprintf(buf, sizeof(buf), "%.17g", data[i]);
+            benchmark::DoNotOptimize(total);
+        });
+}
+BENCHMARK(BM_to_string_f64_snprintf)->Arg(1'000'000)->UseManualTime();
+
+static void BM_to_string_f32_fixed_acul(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    auto data = gen_doubles(N);
+    const size_t OPS = N;
+    const size_t BYTES = sizeof(float);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            char buf[64];
+            size_t total = 0;
+            for (size_t i = 0; i < N; ++i)
+                total += acul::to_string((float)data[i], buf, sizeof(buf), acul::float_format::fixed, 3);
+            benchmark::DoNotOptimize(total);
+        });
+}
+BENCHMARK(BM_to_string_f32_fixed_acul)->Arg(1'000'000)->UseManualTime();
+
+static void BM_to_string_f32_fixed_snprintf(benchmark::State &state)
+{
+    const size_t N = state.range(0);
+    auto data = gen_doubles(N);
+    const size_t OPS = N;
+    const size_t BYTES = sizeof(float);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            char buf[64];
+            size_t total = 0;
+            for (size_t i = 0; i < N; ++i) total += snprintf(buf, sizeof(buf), "%.3f", (double)(float)data[i]);
+            benchmark::DoNotOptimize(total);
+        });
+}
+BENCHMARK(BM_to_string_f32_fixed_snprintf)->Arg(1'000'000)->UseManualTime();
+
 static void BM_stoull_acul(benchmark::State &state)
 {
     const size_t N = state.range(0);
@@ -288,6 +394,602 @@ static void BM_stoull_std(benchmark::State &state)
 }
 BENCHMARK(BM_stoull_std)->Arg(1'000'000)->UseManualTime();
 
+// Number-heavy text in the shape of a mesh or config dump: vertices of three floats per line
+static const std::string &float_text(size_t bytes)
+{
+    static std::string text;
+    if (text.size() >= bytes) return text;
+    text.clear();
+    text.reserve(bytes + 64);
+    std::mt19937_64 rng(1234567);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    char line[96];
+    while (text.size() < bytes)
+    {
+        int len = snprintf(line, sizeof(line), "v %.6f %.9g %.17g\n", dist(rng), dist(rng), dist(rng));
+        text.append(line, len);
+    }
+    return text;
+}
+
+static size_t count_floats(const std::string &text)
+{
+    size_t count = 0;
+    for (char c : text) count += c == ' ';
+    return count;
+}
+
+static void BM_stod_acul(benchmark::State &state)
+{
+    const std::string &text = float_text(state.range(0));
+    const size_t OPS = count_floats(text);
+    const size_t BYTES = text.size() / OPS;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            double sum = 0.0;
+            const char *p = text.c_str();
+            while (*p)
+            {
+                p += 2;
+                f64 value;
+                for (int i = 0; i < 3; ++i)
+                    if (acul::stod(p, value)) sum += value;
+                ++p;
+            }
+            benchmark::DoNotOptimize(sum);
+        });
+}
+BENCHMARK(BM_stod_acul)->Arg(100 << 20)->UseManualTime();
+
+static void BM_stof_acul(benchmark::State &state)
+{
+    const std::string &text = float_text(state.range(0));
+    const size_t OPS = count_floats(text);
+    const size_t BYTES = text.size() / OPS;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            float sum = 0.0f;
+            const char *p = text.c_str();
+            while (*p)
+            {
+                p += 2;
+                f32 value;
+                for (int i = 0; i < 3; ++i)
+                    if (acul::stof(p, value)) sum += value;
+                ++p;
+            }
+            benchmark::DoNotOptimize(sum);
+        });
+}
+BENCHMARK(BM_stof_acul)->Arg(100 << 20)->UseManualTime();
+
+static void BM_stod_strtod(benchmark::State &state)
+{
+    const std::string &text = float_text(state.range(0));
+    const size_t OPS = count_floats(text);
+    const size_t BYTES = text.size() / OPS;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            double sum = 0.0;
+            const char *p = text.c_str();
+            while (*p)
+            {
+                p += 2;
+                for (int i = 0; i < 3; ++i)
+                {
+                    char *end;
+                    sum += strtod(p, &end);
+                    p = end;
+                }
+                ++p;
+            }
+            benchmark::DoNotOptimize(sum);
+        });
+}
+BENCHMARK(BM_stod_strtod)->Arg(100 << 20)->UseManualTime();
+
+static void BM_stod_from_chars(benchmark::State &state)
+{
+    const std::string &text = float_text(state.range(0));
+    const size_t OPS = count_floats(text);
+    const size_t BYTES = text.size() / OPS;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            double sum = 0.0;
+            const char *p = text.c_str();
+            const char *end = p + text.size();
+            while (p < end)
+            {
+                p += 2;
+                for (int i = 0; i < 3; ++i)
+                {
+                    double value;
+                    p = std::from_chars(p, end, value).ptr + 1;
+                    sum += value;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        });
+}
+BENCHMARK(BM_stod_from_chars)->Arg(100 << 20)->UseManualTime();
+
+static acul::string gen_utf8_text(size_t bytes, bool ascii_only)
+{
+    static const char *const words[] = {"lorem ", "ipsum ", "dolor ", "caf\xC3\xA9 ", "\xD0\xBC\xD0\xB8\xD1\x80 ",
+                                        "\xE6\x97\xA5\xE6\x9C\xAC ", "\xF0\x9F\x98\x80 "};
+    std::mt19937_64 rng(1234567);
+    acul::string out;
+    out.reserve(bytes + 16);
+    while (out.size() < bytes) out += words[rng() % (ascii_only ? 3 : 7)];
+    return out;
+}
+
+static void BM_utf8_to_utf16_acul(benchmark::State &state)
+{
+    const acul::string text = gen_utf8_text(1 << 20, state.range(0) == 0);
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            acul::u16string out = acul::utf8_to_utf16(text);
+            benchmark::DoNotOptimize(out);
+        });
+}
+BENCHMARK(BM_utf8_to_utf16_acul)->Arg(0)->Arg(1)->UseManualTime();
+
+static void BM_utf16_to_utf8_acul(benchmark::State &state)
+{
+    const acul::u16string text = acul::utf8_to_utf16(gen_utf8_text(1 << 20, state.range(0) == 0));
+    const size_t OPS = 1;
+    const size_t BYTES = text.size() * sizeof(c16);
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            acul::string out = acul::utf16_to_utf8(text);
+            benchmark::DoNotOptimize(out);
+        });
+}
+BENCHMARK(BM_utf16_to_utf8_acul)->Arg(0)->Arg(1)->UseManualTime();
+
+static void BM_validate_utf8_acul(benchmark::State &state)
+{
+    const acul::string text = gen_utf8_text(1 << 20, state.range(0) == 0);
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            bool valid = acul::validate_utf8(text.data(), text.size());
+            benchmark::DoNotOptimize(valid);
+        });
+}
+BENCHMARK(BM_validate_utf8_acul)->Arg(0)->Arg(1)->UseManualTime();
+
+/// Lower-case words with the single needle "Needle|" at the very end.
+static std::string gen_search_text(size_t size)
+{
+    std::mt19937_64 rng(4242);
+    std::string out;
+    out.reserve(size + 8);
+    while (out.size() < size)
+    {
+        const size_t len = 2 + rng() % 8;
+        for (size_t i = 0; i < len; ++i) out.push_back(static_cast<char>('a' + rng() % 26));
+        out.push_back(' ');
+    }
+    out += "Needle|";
+    return out;
+}
+
+static void BM_search_find_acul(benchmark::State &state)
+{
+    const std::string src = gen_search_text(1 << 20);
+    const acul::string text(src.data(), src.size());
+    const acul::string needle("Needle|");
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t pos = state.range(0) == 0 ? text.find(needle) : text.rfind("lorem");
+            benchmark::DoNotOptimize(pos);
+        });
+}
+BENCHMARK(BM_search_find_acul)->Arg(0)->Arg(1)->UseManualTime();
+
+static void BM_search_find_std(benchmark::State &state)
+{
+    const std::string text = gen_search_text(1 << 20);
+    const std::string needle("Needle|");
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t pos = state.range(0) == 0 ? text.find(needle) : text.rfind("lorem");
+            benchmark::DoNotOptimize(pos);
+        });
+}
+BENCHMARK(BM_search_find_std)->Arg(0)->Arg(1)->UseManualTime();
+
+static void BM_search_find_first_of_acul(benchmark::State &state)
+{
+    const std::string src = gen_search_text(1 << 20);
+    const acul::string text(src.data(), src.size());
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t pos = text.find_first_of("|;,\t\"");
+            benchmark::DoNotOptimize(pos);
+        });
+}
+BENCHMARK(BM_search_find_first_of_acul)->UseManualTime();
+
+static void BM_search_find_first_of_std(benchmark::State &state)
+{
+    const std::string text = gen_search_text(1 << 20);
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t pos = text.find_first_of("|;,\t\"");
+            benchmark::DoNotOptimize(pos);
+        });
+}
+BENCHMARK(BM_search_find_first_of_std)->UseManualTime();
+
+static void BM_search_count_acul(benchmark::State &state)
+{
+    const std::string src = gen_search_text(1 << 20);
+    const acul::string text(src.data(), src.size());
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t n = acul::count(text, ' ');
+            benchmark::DoNotOptimize(n);
+        });
+}
+BENCHMARK(BM_search_count_acul)->UseManualTime();
+
+static void BM_search_count_std(benchmark::State &state)
+{
+    const std::string text = gen_search_text(1 << 20);
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t n = std::count(text.begin(), text.end(), ' ');
+            benchmark::DoNotOptimize(n);
+        });
+}
+BENCHMARK(BM_search_count_std)->UseManualTime();
+
+static void BM_search_icase_acul(benchmark::State &state)
+{
+    const std::string src = gen_search_text(1 << 20);
+    const acul::string text(src.data(), src.size());
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t pos = acul::find_insensitive_case(text, "NEEDLE|");
+            benchmark::DoNotOptimize(pos);
+        });
+}
+BENCHMARK(BM_search_icase_acul)->UseManualTime();
+
+static void BM_search_icase_strcasestr(benchmark::State &state)
+{
+    const std::string text = gen_search_text(1 << 20);
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            const char *p = strcasestr(text.c_str(), "NEEDLE|");
+            benchmark::DoNotOptimize(p);
+        });
+}
+BENCHMARK(BM_search_icase_strcasestr)->UseManualTime();
+
+/// Words of 4-8 letters that mostly miss gen_search_text, the last one is its needle.
+static std::vector<std::string> gen_search_patterns(size_t count)
+{
+    std::mt19937_64 rng(777);
+    std::vector<std::string> out;
+    for (size_t i = 0; i + 1 < count; ++i)
+    {
+        std::string word;
+        const size_t len = 4 + rng() % 5;
+        for (size_t j = 0; j < len; ++j) word.push_back(static_cast<char>('a' + rng() % 26));
+        out.push_back(word);
+    }
+    out.push_back("Needle|");
+    return out;
+}
+
+static void BM_multi_search_acul(benchmark::State &state)
+{
+    const std::string text = gen_search_text(1 << 20);
+    const auto words = gen_search_patterns(state.range(0));
+    acul::vector<acul::string> patterns;
+    for (const auto &word : words) patterns.emplace_back(word.c_str());
+    const acul::multi_matcher matcher(patterns);
+    acul::vector<acul::multi_match> matches;
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { matches.clear(); },
+        {
+            size_t found = matcher.find_all(text.data(), text.size(), matches);
+            benchmark::DoNotOptimize(found);
+        });
+}
+BENCHMARK(BM_multi_search_acul)->Arg(8)->Arg(64)->Arg(1000)->UseManualTime();
+
+static void BM_multi_search_std(benchmark::State &state)
+{
+    // Baseline: one pass over the text per pattern
+    const std::string text = gen_search_text(1 << 20);
+    const auto patterns = gen_search_patterns(state.range(0));
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t found = 0;
+            for (const auto &pattern : patterns)
+                for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+                    ++found;
+            benchmark::DoNotOptimize(found);
+        });
+}
+BENCHMARK(BM_multi_search_std)->Arg(8)->Arg(64)->Arg(1000)->UseManualTime();
+
+static void BM_search_to_lower_acul(benchmark::State &state)
+{
+    const std::string src = gen_search_text(1 << 20);
+    const acul::string text = acul::to_upper(acul::string(src.data(), src.size()));
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            acul::string out = acul::to_lower(text);
+            benchmark::DoNotOptimize(out);
+        });
+}
+BENCHMARK(BM_search_to_lower_acul)->UseManualTime();
+
+static void BM_search_to_lower_std(benchmark::State &state)
+{
+    std::string text = gen_search_text(1 << 20);
+    for (char &c : text) c = static_cast<char>(toupper(c));
+    const size_t OPS = 1;
+    const size_t BYTES = text.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            std::string out(text.size(), '\0');
+            std::transform(text.begin(), text.end(), out.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+            benchmark::DoNotOptimize(out);
+        });
+}
+BENCHMARK(BM_search_to_lower_std)->UseManualTime();
+
+/// Log-like text file of about `size` bytes with CRLF line endings, written once per process.
+static const std::string &line_file(size_t size)
+{
+    static std::string path;
+    if (!path.empty()) return path;
+    path = (std::filesystem::temp_directory_path() / "acul_bench_lines.txt").string();
+    std::mt19937_64 rng(99);
+    std::string text;
+    text.reserve(size + 256);
+    while (text.size() < size)
+    {
+        const size_t len = 20 + rng() % 100;
+        for (size_t i = 0; i < len; ++i) text.push_back(static_cast<char>('a' + rng() % 26));
+        text += "\r\n";
+    }
+    FILE *f = fopen(path.c_str(), "wb");
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+    return path;
+}
+
+static void BM_read_lines_stream_acul(benchmark::State &state)
+{
+    const acul::string path = line_file(64 << 20).c_str();
+    const size_t OPS = 1;
+    const size_t BYTES = std::filesystem::file_size(path.c_str());
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t lines = 0;
+            acul::fs::read_lines(
+                path, [&](const acul::string_view_pool<char> &batch) { lines += batch.size(); }, state.range(0));
+            benchmark::DoNotOptimize(lines);
+        });
+}
+BENCHMARK(BM_read_lines_stream_acul)->Arg(64 << 10)->Arg(1 << 20)->UseManualTime();
+
+static void BM_read_lines_whole_acul(benchmark::State &state)
+{
+    const acul::string path = line_file(64 << 20).c_str();
+    const size_t OPS = 1;
+    const size_t BYTES = std::filesystem::file_size(path.c_str());
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t lines = 0;
+            acul::fs::read_by_block(path, [&](char *data, size_t size) {
+                acul::string_view_pool<char> pool;
+                acul::fill_line_buffer(data, size, pool);
+                lines += pool.size();
+            });
+            benchmark::DoNotOptimize(lines);
+        });
+}
+BENCHMARK(BM_read_lines_whole_acul)->UseManualTime();
+
+static void BM_fill_line_buffer_acul(benchmark::State &state)
+{
+    acul::vector<char> data;
+    acul::fs::read_binary(line_file(64 << 20).c_str(), data);
+    const bool parallel = state.range(0) != 0;
+    state.SetLabel(parallel ? "parallel" : "single");
+    const size_t OPS = 1;
+    const size_t BYTES = data.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            acul::string_view_pool<char> pool;
+            if (parallel) acul::fill_line_buffer_parallel(data.data(), data.size(), pool);
+            else acul::fill_line_buffer(data.data(), data.size(), pool);
+            benchmark::DoNotOptimize(pool);
+        });
+}
+BENCHMARK(BM_fill_line_buffer_acul)->Arg(0)->Arg(1)->UseManualTime();
+
+template <typename Index>
+static void BM_line_index_impl(benchmark::State &state, const char *label)
+{
+    acul::vector<char> data;
+    acul::fs::read_binary(line_file(64 << 20).c_str(), data);
+    state.SetLabel(label);
+    size_t index_bytes = 0;
+    const size_t OPS = 1;
+    const size_t BYTES = data.size();
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            // Build the index, then walk every line as a scan would
+            Index index;
+            acul::fill_line_buffer(data.data(), data.size(), index);
+            size_t total = 0;
+            for (acul::string_view line : index) total += line.size();
+            benchmark::DoNotOptimize(total);
+            if constexpr (std::is_same_v<Index, acul::string_view_pool<char>>)
+                index_bytes = index.size() * sizeof(acul::string_view);
+            else index_bytes = index.memory_size();
+        });
+    state.counters["index_mib"] = static_cast<double>(index_bytes) / (1 << 20);
+}
+
+static void BM_line_index_pool(benchmark::State &state)
+{
+    BM_line_index_impl<acul::string_view_pool<char>>(state, "string_view_pool");
+}
+BENCHMARK(BM_line_index_pool)->UseManualTime();
+
+static void BM_line_index_u32(benchmark::State &state)
+{
+    BM_line_index_impl<acul::line_index<u32>>(state, "line_index<u32>");
+}
+BENCHMARK(BM_line_index_u32)->UseManualTime();
+
+static void BM_line_index_u64(benchmark::State &state)
+{
+    BM_line_index_impl<acul::line_index<u64>>(state, "line_index<u64>");
+}
+BENCHMARK(BM_line_index_u64)->UseManualTime();
+
+/// 1 GB CSV with quoted fields, written once per process. No quoted field contains a newline.
+static const std::string &csv_file()
+{
+    static std::string path;
+    if (!path.empty()) return path;
+    path = (std::filesystem::temp_directory_path() / "acul_bench_1g.csv").string();
+    const size_t size = size_t(1) << 30;
+    if (std::filesystem::exists(path) && std::filesystem::file_size(path) >= size) return path;
+    std::mt19937_64 rng(31337);
+    FILE *f = fopen(path.c_str(), "wb");
+    std::string row;
+    for (size_t written = 0; written < size; written += row.size())
+    {
+        row = std::to_string(rng() % 1000000) + ',' + std::to_string(rng() % 100000 / 100.0) + ",\"";
+        for (size_t i = 0, n = 5 + rng() % 20; i < n; ++i) row.push_back(i % 6 == 5 ? ',' : 'a' + rng() % 26);
+        row += "\",2024-01-";
+        row += std::to_string(10 + rng() % 20);
+        row += ",ok\n";
+        fwrite(row.data(), 1, row.size(), f);
+    }
+    fclose(f);
+    return path;
+}
+
+/// Calls `fn` on 8 MB slices of the mapped CSV that end on a record boundary.
+template <typename F>
+static void for_each_csv_slice(char *data, size_t size, F &&fn)
+{
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t end = std::min(pos + (8 << 20), size);
+        if (end < size) end = static_cast<const char *>(memrchr(data + pos, '\n', end - pos)) - data + 1;
+        fn(data + pos, end - pos);
+        pos = end;
+    }
+}
+
+static void BM_csv_tokenize_acul(benchmark::State &state)
+{
+    const acul::string path = csv_file().c_str();
+    const size_t OPS = 1;
+    const size_t BYTES = std::filesystem::file_size(path.c_str());
+    acul::token_table table;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t fields = 0;
+            acul::fs::read_by_block(path, [&](char *data, size_t size) {
+                for_each_csv_slice(data, size, [&](const char *slice, size_t n) {
+                    table.clear();
+                    acul::tokenize(slice, n, {}, table);
+                    fields += table.fields().size();
+                });
+            });
+            benchmark::DoNotOptimize(fields);
+        });
+}
+BENCHMARK(BM_csv_tokenize_acul)->Iterations(1)->UseManualTime();
+
+static void BM_csv_split_lines_acul(benchmark::State &state)
+{
+    // Baseline: lines split into a vector<string> each, quotes are not understood
+    const acul::string path = csv_file().c_str();
+    const size_t OPS = 1;
+    const size_t BYTES = std::filesystem::file_size(path.c_str());
+    acul::string_view_pool<char> lines;
+    RUN_BENCHMARK(
+        state, OPS, BYTES, { (void)0; },
+        {
+            size_t fields = 0;
+            acul::fs::read_by_block(path, [&](char *data, size_t size) {
+                for_each_csv_slice(data, size, [&](const char *slice, size_t n) {
+                    lines.clear();
+                    acul::fill_line_buffer(slice, n, lines);
+                    for (auto &line : lines) fields += acul::split(acul::string(line.data(), line.size()), ',').size();
+                });
+            });
+            benchmark::DoNotOptimize(fields);
+        });
+}
+BENCHMARK(BM_csv_split_lines_acul)->Iterations(1)->UseManualTime();
+
 static void BM_sstream_write_acul(benchmark::State &state)
 {
     const size_t N = state.range(0);
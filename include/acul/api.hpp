@@ -21,6 +21,12 @@
 #define ACUL_COLD        __attribute__((cold))
 #define ACUL_FORCEINLINE __attribute__((always_inline)) inline
 
+#ifdef _MSC_VER
+    #define ACUL_NOINLINE __declspec(noinline)
+#else
+    #define ACUL_NOINLINE __attribute__((noinline))
+#endif
+
 #if defined(__cpp_consteval) && __cpp_consteval >= 201811
     #define ACUL_CONSTEVAL consteval
 #else
@@ -86,6 +86,46 @@ namespace acul
 #endif
     }
 
+    static ACUL_FORCEINLINE unsigned clz64(u64 x)
+    {
+#if defined(_MSC_VER)
+        unsigned long r;
+        _BitScanReverse64(&r, x);
+        return 63u - (unsigned)r;
+#else
+        return (unsigned)__builtin_clzll(x);
+#endif
+    }
+
+    static ACUL_FORCEINLINE unsigned popcount32(u32 x)
+    {
+#if defined(_MSC_VER)
+        return (unsigned)__popcnt(x);
+#else
+        return (unsigned)__builtin_popcount(x);
+#endif
+    }
+
+    static ACUL_FORCEINLINE unsigned popcount64(u64 x)
+    {
+#if defined(_MSC_VER)
+        return (unsigned)__popcnt64(x);
+#else
+        return (unsigned)__builtin_popcountll(x);
+#endif
+    }
+
+    static ACUL_FORCEINLINE unsigned ctz64(u64 x)
+    {
+#if defined(_MSC_VER)
+        unsigned long r;
+        _BitScanForward64(&r, x);
+        return (unsigned)r;
+#else
+        return (unsigned)__builtin_ctzll(x);
+#endif
+    }
+
     static ACUL_FORCEINLINE u32 pop_lsb(u32 &m)
     {
         u32 r = ctz32(m);
@@ -111,13 +151,13 @@ namespace acul
 
     ACUL_FORCEINLINE u64 load_u64u_le(const void *p) noexcept { return ACUL_U64_IN_EXPECTED_ORDER(load_u64u(p)); }
 
-    ACUL_FORCEINLINE u64 ror64(u64 v, unsigned s) noexcept { return s ? ((v >> s) | (v << (64u - s))) : v; }
+    ACUL_FORCEINLINE constexpr u64 ror64(u64 v, unsigned s) noexcept { return s ? ((v >> s) | (v << (64u - s))) : v; }
 
-    ACUL_FORCEINLINE u64 shift_mix(u64 v) noexcept { return v ^ (v >> 47); }
+    ACUL_FORCEINLINE constexpr u64 shift_mix(u64 v) noexcept { return v ^ (v >> 47); }
 
     typedef pair<u64, u64> u128;
 
-    ACUL_FORCEINLINE u64 low64(const u128 &x) noexcept { return x.first; }
-    ACUL_FORCEINLINE u64 high64(const u128 &x) noexcept { return x.second; }
+    ACUL_FORCEINLINE constexpr u64 low64(const u128 &x) noexcept { return x.first; }
+    ACUL_FORCEINLINE constexpr u64 high64(const u128 &x) noexcept { return x.second; }
 
 } // namespace acul
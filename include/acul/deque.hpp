@@ -1,10 +1,608 @@
 #pragma once
 
-#include <deque>
-#include <oneapi/tbb/scalable_allocator.h>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include "exception/exception.hpp"
+#include "iterator.hpp"
+#include "memory/alloc.hpp"
+#include "type_traits.hpp"
 
 namespace acul
 {
-    template <typename T>
-    using deque = std::deque<T, oneapi::tbb::scalable_allocator<T>>;
-}
\ No newline at end of file
+    template <typename T, typename Allocator = mem_allocator<T>, size_t SegmentBytes = 4096>
+    class deque;
+
+    namespace detail
+    {
+        /// Elements per deque segment: `SegmentBytes` worth rounded down to a power of two, at least 16.
+        template <typename T, size_t SegmentBytes>
+        constexpr size_t deque_segment_size() noexcept
+        {
+            constexpr size_t count = SegmentBytes / sizeof(T);
+            return std::bit_floor(count < 16 ? size_t(16) : count);
+        }
+
+        /// Iterator over the segments of acul::deque. `T` is const qualified for the const iterator.
+        template <typename T, size_t Shift>
+        class deque_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            static constexpr difference_type segment_size = difference_type(1) << Shift;
+
+            deque_iterator() noexcept : _cur(nullptr), _first(nullptr), _node(nullptr) {}
+
+            template <typename U, std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>, int> = 0>
+            deque_iterator(const deque_iterator<U, Shift> &other) noexcept
+                : _cur(other._cur), _first(other._first), _node(other._node)
+            {
+            }
+
+            reference operator*() const noexcept { return *_cur; }
+
+            pointer operator->() const noexcept { return _cur; }
+
+            reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+            deque_iterator &operator++() noexcept
+            {
+                if (++_cur == _first + segment_size)
+                {
+                    set_node(_node + 1);
+                    _cur = _first;
+                }
+                return *this;
+            }
+
+            deque_iterator operator++(int) noexcept
+            {
+                deque_iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            deque_iterator &operator--() noexcept
+            {
+                if (_cur == _first)
+                {
+                    set_node(_node - 1);
+                    _cur = _first + segment_size;
+                }
+                --_cur;
+                return *this;
+            }
+
+            deque_iterator operator--(int) noexcept
+            {
+                deque_iterator tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            deque_iterator &operator+=(difference_type n) noexcept
+            {
+                const difference_type offset = n + (_cur - _first);
+                if (offset >= 0 && offset < segment_size) _cur += n;
+                else
+                {
+                    // Arithmetic shift floors negative offsets to the previous segments
+                    set_node(_node + (offset >> Shift));
+                    _cur = _first + (offset & (segment_size - 1));
+                }
+                return *this;
+            }
+
+            deque_iterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+            deque_iterator operator+(difference_type n) const noexcept
+            {
+                deque_iterator tmp = *this;
+                return tmp += n;
+            }
+
+            friend deque_iterator operator+(difference_type n, const deque_iterator &it) noexcept { return it + n; }
+
+            deque_iterator operator-(difference_type n) const noexcept
+            {
+                deque_iterator tmp = *this;
+                return tmp -= n;
+            }
+
+            template <typename U>
+            difference_type operator-(const deque_iterator<U, Shift> &other) const noexcept
+            {
+                return ((_node - other._node) << Shift) + (_cur - _first) - (other._cur - other._first);
+            }
+
+            template <typename U>
+            bool operator==(const deque_iterator<U, Shift> &other) const noexcept
+            {
+                return _cur == other._cur;
+            }
+
+            template <typename U>
+            auto operator<=>(const deque_iterator<U, Shift> &other) const noexcept
+            {
+                return _node == other._node ? _cur <=> other._cur : _node <=> other._node;
+            }
+
+        private:
+            using node_pointer = value_type **;
+
+            T *_cur;
+            T *_first;
+            node_pointer _node;
+
+            void set_node(node_pointer node) noexcept
+            {
+                _node = node;
+                _first = *node;
+            }
+
+            template <typename, size_t>
+            friend class deque_iterator;
+
+            template <typename, typename, size_t>
+            friend class acul::deque;
+        };
+    } // namespace detail
+
+    /**
+     * @brief Double-ended queue of fixed-size segments.
+     *
+     * Elements live in power-of-two segments of `SegmentBytes` (at least 16 elements each) referenced from a
+     * map of segment pointers, so indexing is a shift and a mask and growth at either end never moves the
+     * elements: references stay valid across push and pop at the ends. Segments emptied by pop are kept
+     * aside and reused by the next push, so a deque used as a FIFO settles on a fixed set of segments and
+     * stops calling the allocator. The map itself only holds pointers and is moved with memmove.
+     *
+     * An empty deque owns no memory until the first insertion.
+     *
+     * @tparam T The element type.
+     * @tparam Allocator The allocator for segments.
+     * @tparam SegmentBytes The target segment size in bytes, a power of two.
+     */
+    template <typename T, typename Allocator, size_t SegmentBytes>
+    class deque
+    {
+        static_assert(std::has_single_bit(SegmentBytes), "SegmentBytes must be a power of two");
+
+        using map_allocator = typename Allocator::template rebind<T *>::other;
+
+    public:
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = typename Allocator::pointer;
+        using const_pointer = typename Allocator::const_pointer;
+        using size_type = typename Allocator::size_type;
+        using difference_type = std::ptrdiff_t;
+        using trivially_relocatable = relocatable_tag<deque>;
+
+        static constexpr size_type segment_size = detail::deque_segment_size<T, SegmentBytes>();
+
+    private:
+        static constexpr size_t shift = std::countr_zero(segment_size);
+        static constexpr size_type mask = segment_size - 1;
+
+        /// Emptied segments kept for reuse before they are given back to the allocator.
+        static constexpr size_type max_spare_segments = 2;
+
+    public:
+        using iterator = detail::deque_iterator<T, shift>;
+        using const_iterator = detail::deque_iterator<const T, shift>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        deque() noexcept : _map(nullptr), _map_size(0), _spare(nullptr), _spare_count(0) {}
+
+        explicit deque(size_type size) : deque() { resize(size); }
+
+        deque(size_type size, const_reference value) : deque() { resize(size, value); }
+
+        template <typename InputIt, std::enable_if_t<is_input_iterator_based<InputIt>::value, int> = 0>
+        deque(InputIt first, InputIt last) : deque()
+        {
+            for (; first != last; ++first) emplace_back(*first);
+        }
+
+        deque(std::initializer_list<value_type> ilist) : deque(ilist.begin(), ilist.end()) {}
+
+        deque(const deque &other) : deque()
+        {
+            for (const auto &value : other) emplace_back(value);
+        }
+
+        deque(deque &&other) noexcept : deque() { swap(other); }
+
+        ~deque() noexcept
+        {
+            if (!_map) return;
+            destroy_range(begin(), end());
+            for (T **node = _start._node; node <= _finish._node; ++node) Allocator::deallocate(*node, segment_size);
+            shrink_to_fit();
+            map_allocator::deallocate(_map, _map_size);
+        }
+
+        deque &operator=(const deque &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (const auto &value : other) emplace_back(value);
+            }
+            return *this;
+        }
+
+        deque &operator=(deque &&other) noexcept
+        {
+            if (this != &other) deque(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        deque &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            for (const auto &value : ilist) emplace_back(value);
+            return *this;
+        }
+
+        ACUL_FORCEINLINE reference operator[](size_type index) noexcept { return *locate(index); }
+
+        ACUL_FORCEINLINE const_reference operator[](size_type index) const noexcept { return *locate(index); }
+
+        template <typename A, size_t S>
+        bool operator==(const deque<T, A, S> &other) const
+        {
+            if (size() != other.size()) return false;
+            auto it = other.begin();
+            for (const auto &value : *this)
+                if (value != *it++) return false;
+            return true;
+        }
+
+        reference at(size_type index)
+        {
+            if (index >= size()) throw out_of_range(size(), index);
+            return *locate(index);
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index >= size()) throw out_of_range(size(), index);
+            return *locate(index);
+        }
+
+        ACUL_FORCEINLINE reference front() noexcept { return *_start._cur; }
+
+        ACUL_FORCEINLINE const_reference front() const noexcept { return *_start._cur; }
+
+        ACUL_FORCEINLINE reference back() noexcept { return *last(); }
+
+        ACUL_FORCEINLINE const_reference back() const noexcept { return *last(); }
+
+        iterator begin() noexcept { return _start; }
+
+        const_iterator begin() const noexcept { return _start; }
+
+        const_iterator cbegin() const noexcept { return _start; }
+
+        iterator end() noexcept { return _finish; }
+
+        const_iterator end() const noexcept { return _finish; }
+
+        const_iterator cend() const noexcept { return _finish; }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        ACUL_FORCEINLINE bool empty() const noexcept { return _start._cur == _finish._cur; }
+
+        ACUL_FORCEINLINE size_type size() const noexcept { return static_cast<size_type>(_finish - _start); }
+
+        ACUL_FORCEINLINE size_type max_size() const noexcept { return Allocator::max_size(); }
+
+        template <typename... Args>
+        reference emplace_back(Args &&...args)
+        {
+            if (!_map) initialize_map();
+            if (_finish._cur != _finish._first + mask)
+            {
+                Allocator::construct(_finish._cur, std::forward<Args>(args)...);
+                return *_finish._cur++;
+            }
+
+            // The end iterator always points into a segment, so the next one is taken before moving on
+            reserve_map_at_back();
+            T *segment = take_segment();
+            try
+            {
+                Allocator::construct(_finish._cur, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                give_segment(segment);
+                throw;
+            }
+            _finish._node[1] = segment;
+            pointer element = _finish._cur;
+            _finish.set_node(_finish._node + 1);
+            _finish._cur = _finish._first;
+            return *element;
+        }
+
+        template <typename... Args>
+        reference emplace_front(Args &&...args)
+        {
+            if (!_map) initialize_map();
+            if (_start._cur != _start._first)
+            {
+                Allocator::construct(_start._cur - 1, std::forward<Args>(args)...);
+                return *--_start._cur;
+            }
+
+            reserve_map_at_front();
+            T *segment = take_segment();
+            try
+            {
+                Allocator::construct(segment + mask, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                give_segment(segment);
+                throw;
+            }
+            _start._node[-1] = segment;
+            _start.set_node(_start._node - 1);
+            _start._cur = _start._first + mask;
+            return *_start._cur;
+        }
+
+        void push_back(const_reference value) { emplace_back(value); }
+
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+
+        void push_front(const_reference value) { emplace_front(value); }
+
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            if (_finish._cur == _finish._first)
+            {
+                give_segment(_finish._first);
+                _finish.set_node(_finish._node - 1);
+                _finish._cur = _finish._first + segment_size;
+            }
+            --_finish._cur;
+            if constexpr (!std::is_trivially_destructible_v<T>) Allocator::destroy(_finish._cur);
+        }
+
+        void pop_front() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>) Allocator::destroy(_start._cur);
+            if (++_start._cur == _start._first + segment_size)
+            {
+                give_segment(_start._first);
+                _start.set_node(_start._node + 1);
+                _start._cur = _start._first;
+            }
+        }
+
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            const size_type index = pos - cbegin();
+            if (index == 0)
+            {
+                emplace_front(std::forward<Args>(args)...);
+                return begin();
+            }
+            if (index == size())
+            {
+                emplace_back(std::forward<Args>(args)...);
+                return end() - 1;
+            }
+
+            // Build the value first, `args` may refer to an element that is about to move
+            value_type value(std::forward<Args>(args)...);
+            if (index < size() / 2)
+            {
+                emplace_front(std::move(front()));
+                iterator it = begin() + index;
+                std::move(begin() + 2, it + 1, begin() + 1);
+                *it = std::move(value);
+                return it;
+            }
+            emplace_back(std::move(back()));
+            iterator it = begin() + index;
+            std::move_backward(it, end() - 2, end() - 1);
+            *it = std::move(value);
+            return it;
+        }
+
+        iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+        iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            const size_type index = first - cbegin();
+            const size_type count = last - first;
+            if (count == 0) return begin() + index;
+
+            // Shift the shorter side over the gap and drop the elements left at that end
+            if (index < (size() - count) / 2)
+            {
+                std::move_backward(begin(), begin() + index, begin() + index + count);
+                for (size_type i = 0; i < count; ++i) pop_front();
+            }
+            else
+            {
+                std::move(begin() + index + count, end(), begin() + index);
+                for (size_type i = 0; i < count; ++i) pop_back();
+            }
+            return begin() + index;
+        }
+
+        void resize(size_type new_size)
+        {
+            while (size() > new_size) pop_back();
+            while (size() < new_size) emplace_back();
+        }
+
+        void resize(size_type new_size, const_reference value)
+        {
+            while (size() > new_size) pop_back();
+            while (size() < new_size) emplace_back(value);
+        }
+
+        /// Destroys the elements and keeps the first segment and the spare ones for reuse.
+        void clear() noexcept
+        {
+            if (!_map) return;
+            destroy_range(begin(), end());
+            for (T **node = _start._node + 1; node <= _finish._node; ++node) give_segment(*node);
+            _finish = _start;
+            _start._cur = _finish._cur = _start._first;
+        }
+
+        /// Gives the spare segments back to the allocator.
+        void shrink_to_fit() noexcept
+        {
+            while (_spare)
+            {
+                T *segment = _spare;
+                memcpy(&_spare, (const void *)segment, sizeof(T *));
+                Allocator::deallocate(segment, segment_size);
+            }
+            _spare_count = 0;
+        }
+
+        void swap(deque &other) noexcept
+        {
+            std::swap(_map, other._map);
+            std::swap(_map_size, other._map_size);
+            std::swap(_start, other._start);
+            std::swap(_finish, other._finish);
+            std::swap(_spare, other._spare);
+            std::swap(_spare_count, other._spare_count);
+        }
+
+    private:
+        T **_map;
+        size_type _map_size;
+        iterator _start;
+        iterator _finish;
+        T *_spare;
+        size_type _spare_count;
+
+        ACUL_FORCEINLINE pointer locate(size_type index) const noexcept
+        {
+            const size_type offset = index + static_cast<size_type>(_start._cur - _start._first);
+            return _start._node[offset >> shift] + (offset & mask);
+        }
+
+        pointer last() const noexcept
+        {
+            return _finish._cur != _finish._first ? _finish._cur - 1 : _finish._node[-1] + mask;
+        }
+
+        static void destroy_range(iterator first, iterator last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (; first != last; ++first) Allocator::destroy(first._cur);
+        }
+
+        T *take_segment()
+        {
+            if (_spare)
+            {
+                // Spare segments are chained through their first bytes
+                T *segment = _spare;
+                memcpy(&_spare, (const void *)segment, sizeof(T *));
+                --_spare_count;
+                return segment;
+            }
+            T *segment = Allocator::allocate(segment_size);
+            if (!segment) throw bad_alloc(segment_size);
+            return segment;
+        }
+
+        void give_segment(T *segment) noexcept
+        {
+            if (_spare_count == max_spare_segments) return Allocator::deallocate(segment, segment_size);
+            memcpy((void *)segment, &_spare, sizeof(T *));
+            _spare = segment;
+            ++_spare_count;
+        }
+
+        void initialize_map()
+        {
+            constexpr size_type initial_map_size = 8;
+            _map = map_allocator::allocate(initial_map_size);
+            if (!_map) throw bad_alloc(initial_map_size);
+            _map_size = initial_map_size;
+
+            // Start in the middle so either end can grow before the map has to
+            T **node = _map + initial_map_size / 2;
+            *node = take_segment();
+            _start.set_node(node);
+            _start._cur = _start._first;
+            _finish = _start;
+        }
+
+        void reserve_map_at_back()
+        {
+            if (_finish._node + 1 == _map + _map_size) reallocate_map(false);
+        }
+
+        void reserve_map_at_front()
+        {
+            if (_start._node == _map) reallocate_map(true);
+        }
+
+        /// Makes room for one more node at an end, recentering the nodes in the map when it has room to spare.
+        void reallocate_map(bool at_front)
+        {
+            const size_type old_nodes = _finish._node - _start._node + 1;
+            const size_type new_nodes = old_nodes + 1;
+            T **new_start;
+            if (_map_size > 2 * new_nodes)
+            {
+                new_start = _map + (_map_size - new_nodes) / 2 + (at_front ? 1 : 0);
+                memmove(new_start, _start._node, old_nodes * sizeof(T *));
+            }
+            else
+            {
+                const size_type new_map_size = _map_size * 2 + 2;
+                T **new_map = map_allocator::allocate(new_map_size);
+                if (!new_map) throw bad_alloc(new_map_size);
+                new_start = new_map + (new_map_size - new_nodes) / 2 + (at_front ? 1 : 0);
+                memcpy(new_start, _start._node, old_nodes * sizeof(T *));
+                map_allocator::deallocate(_map, _map_size);
+                _map = new_map;
+                _map_size = new_map_size;
+            }
+            _start.set_node(new_start);
+            _finish.set_node(new_start + old_nodes - 1);
+        }
+    };
+} // namespace acul
@@ -12,6 +12,11 @@ namespace acul::detail
         isa_flags flags;
         PFN_crc32 crc32;
         PFN_fill_line_buffer fill_line_buffer;
+        line_index_kernels line_index;
+        PFN_tokenize tokenize;
+        utf_kernels utf;
+        search_kernels search;
+        PFN_teddy_find teddy_find;
 
         isa_dispatch();
     } g_isa_dispatcher;
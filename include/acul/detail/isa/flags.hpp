@@ -15,6 +15,7 @@ namespace acul::detail
             avx = 0x0004,
             sse42 = 0x0008,
             pclmul = 0x00010,
+            avx512bw = 0x0020,
         };
         using flag_bitmask = std::true_type;
     };
@@ -2,8 +2,13 @@
 
 #include <cassert>
 #include "api.hpp"
+#include "exception/exception.hpp"
+#include "functional/unique_function.hpp"
 #include "hash/hashmap.hpp"
+#include "memory/pool.hpp"
 #include "scalars.hpp"
+#include "small_vector.hpp"
+#include "string/hash.hpp"
 #include "type_traits.hpp"
 #include "vector.hpp"
 
@@ -23,9 +28,18 @@ namespace acul::events
         bool operator!=(const event &event) const { return !(*this == event); }
     };
 
-    inline u64 make_pre_event_id(u64 id) { return id | 0x4000000000000000ULL; }
+    constexpr u64 make_pre_event_id(u64 id) { return id | 0x4000000000000000ULL; }
 
-    inline u64 make_post_event_id(u64 id) { return id | 0x8000000000000000ULL; }
+    constexpr u64 make_post_event_id(u64 id) { return id | 0x8000000000000000ULL; }
+
+    /// Event id derived from a name: its hash_string() with the pre & post bits cleared.
+    constexpr u64 make_event_id(string_view name) { return hash_string(name) & 0x3FFFFFFFFFFFFFFFULL; }
+
+    namespace literals
+    {
+        /// Compile-time event id of a name, e.g. `"asset.loaded"_id`. See make_event_id().
+        ACUL_CONSTEVAL u64 operator""_id(const char *name, size_t len) { return make_event_id({name, len}); }
+    } // namespace literals
 
     template <typename T>
     struct data_event final : event
@@ -63,6 +77,27 @@ namespace acul::events
         void invoke(E &event) { _listener(event); }
     };
 
+    /// Listeners come from a pool rather than the heap: all listener<E> have the size of listener<event>.
+    using listener_pool = pool<sizeof(listener<event>), alignof(listener<event>)>;
+
+    template <typename E>
+    inline listener<E> *make_listener(unique_function<void(E &)> &&fn)
+    {
+        static_assert(sizeof(listener<E>) == sizeof(listener<event>) &&
+                          alignof(listener<E>) == alignof(listener<event>),
+                      "listener size must not depend on the event type");
+        void *memory = listener_pool::allocate();
+        if (!memory) throw bad_alloc(sizeof(listener<E>));
+        return new (memory) listener<E>(std::move(fn));
+    }
+
+    inline void release_listener(listener_base *l) noexcept
+    {
+        if (!l) return;
+        l->~listener_base();
+        listener_pool::deallocate(l);
+    }
+
     struct listener_info
     {
         listener_base *listener;
@@ -86,9 +121,12 @@ namespace acul::events
 
     class event_group
     {
+        // Most events have a handful of listeners, which then live in the group itself
+        using node_list = small_vector<event_node, 4>;
+
     public:
-        using iterator = vector<event_node>::iterator;
-        using const_iterator = vector<event_node>::const_iterator;
+        using iterator = node_list::iterator;
+        using const_iterator = node_list::const_iterator;
 
         iterator begin() { return _nodes.begin(); }
         iterator end() { return _nodes.end(); }
@@ -162,7 +200,7 @@ namespace acul::events
 
         void clear_release_all()
         {
-            for (auto &n : _nodes) acul::release(reinterpret_cast<listener_base *>(n.ctx));
+            for (auto &n : _nodes) release_listener(reinterpret_cast<listener_base *>(n.ctx));
             _nodes.clear();
         }
 
@@ -196,7 +234,7 @@ namespace acul::events
             _nodes.pop_back();
         }
 
-        vector<event_node> _nodes;
+        node_list _nodes;
     };
 
     template <class E, typename = std::enable_if_t<std::is_base_of_v<event, E>>, typename... Args>
@@ -228,7 +266,7 @@ namespace acul::events
         iterator add_listener(void *owner, u64 id, unique_function<void(E &)> &&fn, int priority = 5)
         {
             static_assert(std::is_base_of_v<event, E>, "E must inherit event");
-            auto *L = alloc<listener<E>>(std::move(fn));
+            auto *L = make_listener<E>(std::move(fn));
             auto *eg = ensure(id);
             eg->template add<E>(owner, L, priority);
             return iterator{id, priority, L};
@@ -302,12 +340,12 @@ namespace acul::events
             if (eg->find_owner_ptr_prio(owner, to_free, prio))
             {
                 eg->remove_by_owner(owner);
-                release(to_free);
+                release_listener(to_free);
             }
 
             if (eg->empty())
             {
-                release(eg);
+                release_group(eg);
                 _slots.erase(it);
             }
         }
@@ -328,12 +366,12 @@ namespace acul::events
                 if (eg->find_owner_ptr_prio(owner, ptr, prio))
                 {
                     eg->remove_by_owner(owner);
-                    release(ptr);
+                    release_listener(ptr);
                 }
 
                 if (eg->empty())
                 {
-                    release(eg);
+                    release_group(eg);
                     it = _slots.erase(it);
                 }
                 else ++it;
@@ -347,7 +385,7 @@ namespace acul::events
                 if (kv.second)
                 {
                     kv.second->clear_release_all();
-                    acul::release(kv.second);
+                    release_group(kv.second);
                 }
             }
             _slots.clear();
@@ -356,13 +394,23 @@ namespace acul::events
         ~dispatcher() { clear(); }
 
     private:
+        using group_pool = pool<sizeof(event_group), alignof(event_group)>;
+
         hashmap<u64, event_group *> _slots;
 
+        static void release_group(event_group *eg) noexcept
+        {
+            eg->~event_group();
+            group_pool::deallocate(eg);
+        }
+
         event_group *ensure(u64 id)
         {
             auto it = _slots.find(id);
             if (it != _slots.end() && it->second) return it->second;
-            auto *eg = alloc<event_group>();
+            void *memory = group_pool::allocate();
+            if (!memory) throw bad_alloc(sizeof(event_group));
+            auto *eg = new (memory) event_group();
             _slots[id] = eg;
             return eg;
         }
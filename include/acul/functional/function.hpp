@@ -4,10 +4,11 @@
 #include <type_traits>
 #include <utility>
 #include "../fwd/functional.hpp"
+#include "../type_traits.hpp"
 
 namespace acul
 {
-    template <class R, class... A, size_t S, template <class> class Alloc>
+    template <class R, class... A, size_t S, template <class...> class Alloc>
     class function<R(A...), S, Alloc>
     {
         static constexpr size_t storage_align = alignof(void *);
@@ -101,7 +102,8 @@ namespace acul
             static_assert(std::is_copy_constructible_v<Fn>, "function target must be copy constructible");
             reset();
 
-            if constexpr (sizeof(Fn) <= S && alignof(Fn) <= storage_align)
+            // Only targets that survive a byte copy are kept inline, which keeps the wrapper relocatable
+            if constexpr (sizeof(Fn) <= S && alignof(Fn) <= storage_align && is_trivially_relocatable_v<Fn>)
             {
                 Alloc<Fn>::construct(reinterpret_cast<Fn *>(_storage), std::forward<F>(f));
                 _vt = vt_inplace<Fn>();
@@ -133,6 +135,7 @@ namespace acul
 
     public:
         using result_type = R;
+        using trivially_relocatable = relocatable_tag<function>;
 
         function() noexcept = default;
         function(std::nullptr_t) noexcept {}
@@ -180,7 +183,7 @@ namespace acul
             return *this;
         }
 
-        R operator()(A... args) const noexcept
+        R operator()(A... args) const
         {
             assert(_vt);
             return _vt->invoke((void *)_storage, std::forward<A>(args)...);
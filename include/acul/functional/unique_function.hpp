@@ -4,10 +4,11 @@
 #include <type_traits>
 #include <utility>
 #include "../fwd/functional.hpp"
+#include "../type_traits.hpp"
 
 namespace acul
 {
-    template <class R, class... A, size_t S, template <class> class Alloc>
+    template <class R, class... A, size_t S, template <class...> class Alloc>
     class unique_function<R(A...), S, Alloc>
     {
         static constexpr size_t storage_align = alignof(void *);
@@ -90,7 +91,8 @@ namespace acul
             if constexpr (std::is_pointer_v<Fn> && std::is_function_v<std::remove_pointer_t<Fn>>)
                 if (!f) return;
 
-            if constexpr (sizeof(Fn) <= S && alignof(Fn) <= storage_align)
+            // Only targets that survive a byte copy are kept inline, which keeps the wrapper relocatable
+            if constexpr (sizeof(Fn) <= S && alignof(Fn) <= storage_align && is_trivially_relocatable_v<Fn>)
             {
                 Alloc<Fn>::construct(reinterpret_cast<Fn *>(_storage), std::forward<F>(f));
                 _vt = vt_inplace<Fn>();
@@ -115,6 +117,7 @@ namespace acul
 
     public:
         using result_type = R;
+        using trivially_relocatable = relocatable_tag<unique_function>;
 
         unique_function() noexcept = default;
         unique_function(std::nullptr_t) noexcept {}
@@ -154,7 +157,7 @@ namespace acul
             return *this;
         }
 
-        R operator()(A... args) const noexcept
+        R operator()(A... args) const
         {
             assert(_vt);
             return _vt->invoke((void *)_storage, std::forward<A>(args)...);
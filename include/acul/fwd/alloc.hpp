@@ -0,0 +1,7 @@
+#pragma once
+
+namespace acul
+{
+    template <typename T, typename Tag = void>
+    class mem_allocator;
+} // namespace acul
@@ -1,15 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include "alloc.hpp"
 
 namespace acul
 {
-    template <class>
-    class mem_allocator;
-
-    template <class Sig, size_t S = sizeof(void *) * 2, template <class> class Alloc = mem_allocator>
+    template <class Sig, size_t S = sizeof(void *) * 2, template <class...> class Alloc = mem_allocator>
     class unique_function;
 
-    template <class Sig, size_t S = sizeof(void *) * 2, template <class> class Alloc = mem_allocator>
+    template <class Sig, size_t S = sizeof(void *) * 2, template <class...> class Alloc = mem_allocator>
     class function;
 } // namespace acul
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../scalars.hpp"
+
+namespace acul
+{
+    template <typename Offset = u32>
+    class line_index;
+}
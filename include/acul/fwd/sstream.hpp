@@ -5,7 +5,7 @@
 namespace acul
 {
 
-    template <typename T, typename Allocator = mem_allocator<T>>
+    template <typename T, typename Allocator = mem_allocator<T, mem_tags::string>>
     class basic_stringstream;
     
     using stringstream = basic_stringstream<char>;
@@ -4,7 +4,7 @@
 
 namespace acul
 {
-    template <typename T, typename Allocator = mem_allocator<T>>
+    template <typename T, typename Allocator = mem_allocator<T, mem_tags::string>>
     class basic_string;
 
     using string = basic_string<char>;
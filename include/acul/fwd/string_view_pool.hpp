@@ -4,6 +4,6 @@
 
 namespace acul
 {
-    template <typename T, typename Allocator = mem_allocator<T>>
+    template <typename T, typename Allocator = mem_allocator<T, mem_tags::string>, size_t InlineCapacity = 0>
     class string_view_pool;
 }
\ No newline at end of file
@@ -40,7 +40,7 @@ namespace acul::detail
     {
         while (idx < cap && (idx & 31u))
         {
-            if (ctrl[idx] < 0x7F) return idx;
+            if (ctrl[idx] != 0x7F) return idx;
             ++idx;
         }
         const __m256i e = _mm256_set1_epi8(0x7F);
@@ -59,7 +59,7 @@ namespace acul::detail
         }
         while (idx < cap)
         {
-            if (ctrl[idx] < 0x7F) return idx;
+            if (ctrl[idx] != 0x7F) return idx;
             ++idx;
         }
         return idx;
@@ -83,7 +83,7 @@ namespace acul::detail
         else
         {
             for (uint32_t k = 0; k < limit; ++k)
-                if (ctrl[base + k] < 0x7F) m |= (1u << k);
+                if (ctrl[base + k] != 0x7F) m |= (1u << k);
         }
         uint32_t shift = (uint32_t)(idx - base);
         if (shift + 1u >= limit) m = 0;
@@ -107,7 +107,7 @@ namespace acul::detail
         {
             uint32_t m = 0;
             for (uint32_t k = 0; k < limit; ++k)
-                if (ctrl[base + k] < 0x7F) m |= (1u << k);
+                if (ctrl[base + k] != 0x7F) m |= (1u << k);
             return m;
         }
     }
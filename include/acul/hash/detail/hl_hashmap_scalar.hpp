@@ -87,7 +87,7 @@ namespace acul::detail
 
         while (idx < cap && (idx & 7u))
         {
-            if (ctrl[idx] < 0x7F) return idx;
+            if (ctrl[idx] != 0x7F) return idx;
             ++idx;
         }
 
@@ -113,7 +113,7 @@ namespace acul::detail
 
         while (idx < cap)
         {
-            if (ctrl[idx] < 0x7F) return idx;
+            if (ctrl[idx] != 0x7F) return idx;
             ++idx;
         }
         return idx;
@@ -141,7 +141,7 @@ namespace acul::detail
         else
         {
             for (uint32_t k = 0; k < limit; ++k)
-                if (ctrl[base + k] < 0x7F) m |= (1u << k);
+                if (ctrl[base + k] != 0x7F) m |= (1u << k);
         }
 
         const uint32_t shift = (uint32_t)(idx - base);
@@ -168,7 +168,7 @@ namespace acul::detail
         {
             uint32_t m = 0;
             for (uint32_t k = 0; k < limit; ++k)
-                if (ctrl[base + k] < 0x7F) m |= (1u << k);
+                if (ctrl[base + k] != 0x7F) m |= (1u << k);
             return m;
         }
     }
@@ -731,13 +731,7 @@ namespace acul::detail
             _next[i] = AHM_INACTIVE;
         }
 
-        ACUL_FORCEINLINE void place_move(value_type &src, value_type *dst)
-        {
-            if constexpr (std::is_trivially_copyable_v<value_type>)
-                memcpy((void *)dst, (void *)&src, sizeof(value_type));
-            else ::new ((void *)dst) value_type(std::move(src));
-            if constexpr (!std::is_trivially_destructible_v<value_type>) src.~value_type();
-        }
+        ACUL_FORCEINLINE void place_move(value_type &src, value_type *dst) { relocate(&src, 1, dst); }
 
         struct aux_mem
         {
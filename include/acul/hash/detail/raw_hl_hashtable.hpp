@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iterator>
+#include "../../exception/exception.hpp"
 #include "../../memory/alloc.hpp"
 #include "../../pair.hpp"
 #if defined(__AVX2__)
@@ -169,7 +170,7 @@ namespace acul::detail
                 memcpy(_values, rhs._values, size_t(_num_buckets) * sizeof(value_type));
             else
                 for (size_type i = 0; i < _num_buckets; ++i)
-                    if (_ctrl[i] < AHM_HL_CTRL_EMPTY) ::new (_values + i) value_type(rhs._values[i]);
+                    if (_ctrl[i] != AHM_HL_CTRL_EMPTY) ::new (_values + i) value_type(rhs._values[i]);
         }
 
         // --- move ctor
@@ -199,7 +200,7 @@ namespace acul::detail
             // free current
             if (_allocation)
             {
-                Allocator::deallocate(_allocation);
+                Allocator::deallocate_aligned(_allocation);
                 _allocation = nullptr;
                 _values = nullptr;
                 _ctrl = nullptr;
@@ -220,7 +221,7 @@ namespace acul::detail
                 memcpy(_values, rhs._values, size_t(_num_buckets) * sizeof(value_type));
             else
                 for (size_type i = 0; i < _num_buckets; ++i)
-                    if (_ctrl[i] < AHM_HL_CTRL_EMPTY) ::new (_values + i) value_type(rhs._values[i]);
+                    if (_ctrl[i] != AHM_HL_CTRL_EMPTY) ::new (_values + i) value_type(rhs._values[i]);
             return *this;
         }
 
@@ -229,7 +230,7 @@ namespace acul::detail
         {
             if (this == &rhs) return *this;
 
-            if (_allocation) Allocator::deallocate(_allocation);
+            if (_allocation) Allocator::deallocate_aligned(_allocation);
 
             _allocation = rhs._allocation;
             _values = rhs._values;
@@ -287,7 +288,7 @@ namespace acul::detail
 
         ~raw_hl_hashtable()
         {
-            if (_allocation) Allocator::deallocate(_allocation);
+            if (_allocation) Allocator::deallocate_aligned(_allocation);
         }
 
         bool empty() const noexcept { return _num_filled == 0; }
@@ -303,7 +304,7 @@ namespace acul::detail
         size_type bucket_size(size_type n) const
         {
             if (n >= _num_buckets) return 0;
-            return (_ctrl[n] < AHM_HL_CTRL_EMPTY) ? 1 : 0;
+            return (_ctrl[n] != AHM_HL_CTRL_EMPTY) ? 1 : 0;
         }
 
         ACUL_HOT size_type bucket(const key_type &key) const noexcept
@@ -404,15 +405,12 @@ namespace acul::detail
             const size_type new_b = (size_type)get_growth_size_aligned((u32)required);
             const size_type new_mask = new_b - 1;
 
-            const size_t bytes_values = size_t(new_b) * sizeof(value_type);
+            const size_t bytes_values = align_up(size_t(new_b) * sizeof(value_type), 64);
             const size_t bytes_ctrl = size_t(new_b) + AHM_HL_CTRL_PAD;
-            const size_t total_bytes = bytes_values + bytes_ctrl + 127;
 
-            raw_pointer new_raw = Allocator::allocate(total_bytes);
-            u8 *raw = align_up_ptr(reinterpret_cast<u8 *>(new_raw), 64);
-            value_type *new_values = reinterpret_cast<value_type *>(raw);
-            u8 *ctrl_base = raw + bytes_values;
-            u8 *new_ctrl = align_up_ptr(ctrl_base, 64);
+            raw_pointer new_raw = Allocator::allocate_aligned(bytes_values + bytes_ctrl, 64);
+            value_type *new_values = reinterpret_cast<value_type *>(new_raw);
+            u8 *new_ctrl = reinterpret_cast<u8 *>(new_raw) + bytes_values;
             std::memset(new_ctrl, AHM_HL_CTRL_EMPTY, new_b + AHM_HL_CTRL_PAD);
 
             value_type *old_values = _values;
@@ -442,10 +440,8 @@ namespace acul::detail
                     const u8 c = old_ctrl[i];
                     if (c == AHM_HL_CTRL_EMPTY) continue;
 
-                    value_type kv;
-                    if constexpr (std::is_trivially_copyable_v<value_type>) kv = old_values[i];
-                    else kv = std::move(old_values[i]);
-
+                    // Elements are relocated straight from the old block, with memcpy when the type allows it
+                    value_type &kv = old_values[i];
                     const u64 hphi = hash_mixed(Traits::get_key(kv));
                     const u8 h2 = h2_from(hphi);
                     const u32 h1 = (u32)(hphi >> 7);
@@ -460,8 +456,7 @@ namespace acul::detail
                         const u32 off = ctz32(m);
                         free_masks[g] &= ~(1u << off);
                         const u32 j = (g << GSHIFT) | off;
-                        if constexpr (std::is_trivially_copyable_v<value_type>) _values[j] = kv;
-                        else ::new ((void *)&_values[j]) value_type(std::move(kv));
+                        relocate(&kv, 1, _values + j);
                         set_ctrl(j, h2);
                         ++inserted;
                         continue;
@@ -476,8 +471,7 @@ namespace acul::detail
                             const u32 off = ctz32(mm);
                             free_masks[gg] = (mm & (mm - 1u));
                             const u32 j = (gg << GSHIFT) | off;
-                            if constexpr (std::is_trivially_copyable_v<value_type>) _values[j] = kv;
-                            else ::new ((void *)&_values[j]) value_type(std::move(kv));
+                            relocate(&kv, 1, _values + j);
                             set_ctrl(j, h2);
                             ++inserted;
                             break;
@@ -485,7 +479,7 @@ namespace acul::detail
                     }
                 }
 
-                if (_allocation) Allocator::deallocate(_allocation);
+                if (_allocation) Allocator::deallocate_aligned(_allocation);
             }
             _allocation = new_raw;
             _num_filled = inserted;
@@ -740,7 +734,7 @@ namespace acul::detail
             if constexpr (!std::is_trivially_destructible_v<value_type>)
             {
                 for (size_type i = 0; i < _num_buckets; ++i)
-                    if (_ctrl[i] < AHM_HL_CTRL_EMPTY) _values[i].~value_type();
+                    if (_ctrl[i] != AHM_HL_CTRL_EMPTY) _values[i].~value_type();
             }
             std::memset(_ctrl, AHM_HL_CTRL_EMPTY, size_t(_num_buckets + AHM_HL_GROUP_SIZE) * sizeof(u8));
             _num_filled = 0;
@@ -986,10 +980,10 @@ namespace acul::detail
 
         inline void allocate_blocks(size_type buckets) noexcept
         {
-            const size_t bytes_values = size_t(buckets) * sizeof(value_type);
+            const size_t bytes_values = align_up(size_t(buckets) * sizeof(value_type), 64);
             const size_t bytes_ctrl = size_t(buckets + AHM_HL_CTRL_PAD) * sizeof(u8);
 
-            _allocation = Allocator::allocate(bytes_values + bytes_ctrl);
+            _allocation = Allocator::allocate_aligned(bytes_values + bytes_ctrl, 64);
             _values = reinterpret_cast<value_type *>(_allocation);
             _ctrl = reinterpret_cast<u8 *>(_allocation + bytes_values);
 
@@ -5,7 +5,7 @@
 
 namespace acul
 {
-    template <typename K, typename V, typename Allocator = mem_allocator<std::byte>, typename H = std::hash<K>,
-              typename Eq = std::equal_to<K>>
+    template <typename K, typename V, typename Allocator = mem_allocator<std::byte, mem_tags::hash_table>,
+              typename H = std::hash<K>, typename Eq = std::equal_to<K>>
     using hashmap = detail::raw_hashtable<Allocator, detail::map_traits<K, V, H, Eq>>;
 } // namespace acul
\ No newline at end of file
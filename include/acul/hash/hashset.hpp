@@ -5,7 +5,7 @@
 
 namespace acul
 {
-    template <typename K, typename Allocator = mem_allocator<std::byte>, typename H = std::hash<K>,
-              typename Eq = std::equal_to<K>>
+    template <typename K, typename Allocator = mem_allocator<std::byte, mem_tags::hash_table>,
+              typename H = std::hash<K>, typename Eq = std::equal_to<K>>
     using hashset = detail::raw_hashtable<Allocator, detail::set_traits<K, H, Eq>>;
 }
\ No newline at end of file
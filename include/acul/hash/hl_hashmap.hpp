@@ -5,6 +5,7 @@
 
 namespace acul
 {
-    template <typename K, typename V, typename H = std::hash<K>, typename Eq = std::equal_to<K>>
-    using hl_hashmap = detail::raw_hl_hashtable<mem_allocator<std::byte>, detail::map_traits<K, V, H, Eq>>;
-} // namespace acul
\ No newline at end of file
+    template <typename K, typename V, typename H = std::hash<K>, typename Eq = std::equal_to<K>,
+              typename Allocator = mem_allocator<std::byte, mem_tags::hash_table>>
+    using hl_hashmap = detail::raw_hl_hashtable<Allocator, detail::map_traits<K, V, H, Eq>>;
+} // namespace acul
@@ -5,6 +5,7 @@
 
 namespace acul
 {
-    template <typename K, typename H = std::hash<K>, typename Eq = std::equal_to<K>>
-    using hl_hashset = detail::raw_hl_hashtable<mem_allocator<std::byte>, detail::set_traits<K, H, Eq>>;
-} // namespace acul
\ No newline at end of file
+    template <typename K, typename H = std::hash<K>, typename Eq = std::equal_to<K>,
+              typename Allocator = mem_allocator<std::byte, mem_tags::hash_table>>
+    using hl_hashset = detail::raw_hl_hashtable<Allocator, detail::set_traits<K, H, Eq>>;
+} // namespace acul
@@ -4,7 +4,9 @@
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/parallel_for.h>
 #include "../../api.hpp"
+#include "../../functional/unique_function.hpp"
 #include "../../op_result.hpp"
+#include "../../string/string_view_pool.hpp"
 #include "../../vector.hpp"
 
 #ifdef _WIN32
@@ -77,6 +79,20 @@ namespace acul::fs
 
     APPLIB_API op_result read_by_block(const string &filename, unique_function<void(char *, size_t)> callback);
 
+    /**
+     * Streams a text file line by line with bounded memory.
+     *
+     * The file is read in chunks of `chunk_size` bytes and split with acul::line_reader, so lines crossing
+     * a chunk boundary are delivered whole. Line endings are stripped as in fill_line_buffer.
+     * @param filename The name of the file to read.
+     * @param callback Called with each batch of lines; the views are valid only during the call.
+     * @param chunk_size The number of bytes read at a time.
+     * @return op_state::success if the whole file was read and processed, op_state::error otherwise.
+     */
+    APPLIB_API op_result read_lines(const string &filename,
+                                    unique_function<void(const string_view_pool<char> &)> callback,
+                                    size_t chunk_size = 1 << 20);
+
     /**
      * Writes data to a file in blocks.
      *
@@ -7,6 +7,7 @@
 #include "../../functional/function.hpp"
 #include "../../op_result.hpp"
 #include "../../shared_mutex.hpp"
+#include "../../string/format.hpp"
 #include "../../string/utils.hpp"
 #include "../../task.hpp"
 #include "../path.hpp"
@@ -115,8 +116,7 @@ namespace acul
 
             string path(entrypoint *entrypoint, entrygroup *group)
             {
-                string name = format("entrypoint-%s-%llx.jatc", group->name.c_str(), entrypoint->id);
-                return _path / name;
+                return _path / fmt::format("entrypoint-{}-{:x}.jatc", group->name, entrypoint->id);
             }
 
             entrypoint *register_entrypoint(entrygroup *group);
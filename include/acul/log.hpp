@@ -4,21 +4,106 @@
 #include <fstream>
 #include <iostream>
 #include <oneapi/tbb/concurrent_queue.h>
+#include "bin_stream.hpp"
 #include "hash/hashmap.hpp"
 #include "io/path.hpp"
 #include "string/sstream.hpp"
 #include "task.hpp"
 
+#define ACUL_LOG_LEVEL_FATAL 0
+#define ACUL_LOG_LEVEL_ERROR 1
+#define ACUL_LOG_LEVEL_WARN  2
+#define ACUL_LOG_LEVEL_INFO  3
+#define ACUL_LOG_LEVEL_DEBUG 4
+#define ACUL_LOG_LEVEL_TRACE 5
+
+// Maximum verbosity compiled into the LOG_* macros. Call sites above this level expand to nothing,
+// so their arguments are never evaluated.
+#ifndef ACUL_LOG_MIN_LEVEL
+    #define ACUL_LOG_MIN_LEVEL ACUL_LOG_LEVEL_TRACE
+#endif
+
 namespace acul::log
 {
     enum class level
     {
-        fatal,
-        error,
-        warn,
-        info,
-        debug,
-        trace
+        fatal = ACUL_LOG_LEVEL_FATAL,
+        error = ACUL_LOG_LEVEL_ERROR,
+        warn = ACUL_LOG_LEVEL_WARN,
+        info = ACUL_LOG_LEVEL_INFO,
+        debug = ACUL_LOG_LEVEL_DEBUG,
+        trace = ACUL_LOG_LEVEL_TRACE
+    };
+
+    enum class field_type : u8
+    {
+        signed_int,
+        unsigned_int,
+        floating,
+        boolean,
+        string
+    };
+
+    /**
+     * @brief Typed key/value pair attached to a structured record.
+     *
+     * Values are kept in their native representation and only turned into text by the encoder
+     * on the dispatch thread.
+     */
+    struct field
+    {
+        string key;
+        field_type type;
+        union
+        {
+            i64 i;
+            u64 u;
+            f64 f;
+            bool b;
+        };
+        string str;
+
+        field() : type(field_type::signed_int), i(0) {}
+
+        field(const string &key, bool value) : key(key), type(field_type::boolean), b(value) {}
+
+        template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+        field(const string &key, T value)
+            : key(key), type(std::is_signed_v<T> ? field_type::signed_int : field_type::unsigned_int)
+        {
+            if constexpr (std::is_signed_v<T>) i = value;
+            else u = value;
+        }
+
+        template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+        field(const string &key, T value) : key(key), type(field_type::floating), f(value)
+        {
+        }
+
+        field(const string &key, const string &value) : key(key), type(field_type::string), i(0), str(value) {}
+
+        // Character arrays are copied: the record outlives the call and the array may be a stack buffer
+        template <typename T, std::enable_if_t<std::is_convertible_v<const T &, const char *>, int> = 0>
+        field(const string &key, const T &value)
+            : key(key), type(field_type::string), i(0), str(static_cast<const char *>(value))
+        {
+        }
+
+        template <typename T, std::enable_if_t<std::is_same_v<T, string_view>, int> = 0>
+        field(const string &key, const T &value)
+            : key(key), type(field_type::string), i(0), str(value.data(), value.size())
+        {
+        }
+    };
+
+    /// Structured log entry as seen by encoders.
+    struct record
+    {
+        enum level level = level::info;
+        u64 timestamp = 0; ///< Nanoseconds since the system clock epoch
+        int thread_id = 0;
+        string message;
+        vector<field> fields;
     };
 
     class token_handler_base
@@ -26,9 +111,16 @@ namespace acul::log
     public:
         virtual ~token_handler_base() = default;
         virtual void handle(level level, const char *message, stringstream &ss) const = 0;
+
+        /// Used by the text encoder, which runs on the dispatch thread. Tokens that depend on the
+        /// call site rather than the moment of encoding should take their values from the record.
+        virtual void handle_record(const record &record, const char *message, stringstream &ss) const
+        {
+            handle(record.level, message, ss);
+        }
     };
 
-    using token_handler_list = vector<shared_ptr<token_handler_base>>;
+    using token_handler_list = vector<ts_shared_ptr<token_handler_base>>;
 
     class text_handler final : public token_handler_base
     {
@@ -45,12 +137,18 @@ namespace acul::log
     {
     public:
         void handle(level level, const char *message, stringstream &ss) const override;
+        void handle_record(const record &record, const char *message, stringstream &ss) const override;
     };
 
     class thread_id_handler final : public token_handler_base
     {
     public:
         void handle(level level, const char *message, stringstream &ss) const override { ss << task::get_thread_id(); }
+
+        void handle_record(const record &record, const char *, stringstream &ss) const override
+        {
+            ss << record.thread_id;
+        }
     };
 
     class level_name_handler final : public token_handler_base
@@ -88,10 +186,67 @@ namespace acul::log
         void handle(level level, const char *message, stringstream &ss) const override { ss << colors::reset; }
     };
 
+    class logger_base;
+
+    /**
+     * @brief Turns a structured record into the bytes written by a logger.
+     *
+     * Encoders are invoked on the dispatch thread only, so they may be stateless and shared
+     * between loggers.
+     */
+    class encoder_base
+    {
+    public:
+        virtual ~encoder_base() = default;
+        virtual void encode(logger_base &logger, const record &record, stringstream &ss) const = 0;
+    };
+
+    /// Human-readable output. Applies the logger pattern with the fields appended to the message as key=value.
+    class APPLIB_API text_encoder final : public encoder_base
+    {
+    public:
+        void encode(logger_base &logger, const record &record, stringstream &ss) const override;
+    };
+
+    /// One JSON object per line.
+    class APPLIB_API json_encoder final : public encoder_base
+    {
+    public:
+        void encode(logger_base &logger, const record &record, stringstream &ss) const override;
+    };
+
+    /// One logfmt line per record: key=value pairs separated by spaces.
+    class APPLIB_API logfmt_encoder final : public encoder_base
+    {
+    public:
+        void encode(logger_base &logger, const record &record, stringstream &ss) const override;
+    };
+
+    /**
+     * @brief Compact binary output written through bin_stream.
+     *
+     * Every record is prefixed with its payload size as u32, followed by the level (u8), timestamp (u64),
+     * thread id (i32), the message and a u16 field count. Strings are stored as u32 length and raw bytes,
+     * each field as key, type tag (u8) and value.
+     */
+    class APPLIB_API binary_encoder final : public encoder_base
+    {
+    public:
+        void encode(logger_base &logger, const record &record, stringstream &ss) const override;
+
+        /**
+         * @brief Reads the next record from the stream.
+         * @return False if the stream has no complete record left.
+         */
+        static bool decode(bin_stream &stream, record &record);
+    };
+
+    class record_builder;
+
     class APPLIB_API logger_base
     {
     public:
-        logger_base(const string &name) : _name(name), _tokens(make_shared<token_handler_list>()) {}
+        logger_base(const string &name) : _name(name), _tokens(make_ts_shared<token_handler_list>()) {}
 
         virtual ~logger_base() = default;
 
@@ -99,6 +254,13 @@ namespace acul::log
 
         string name() const { return _name; }
 
+        /// Sets the most verbose level this logger accepts. Messages above it are dropped before formatting.
+        void set_level(enum level level) noexcept { _level.store(level, std::memory_order_relaxed); }
+
+        enum level get_level() const noexcept { return _level.load(std::memory_order_relaxed); }
+
+        bool is_enabled(enum level level) const noexcept { return level <= _level.load(std::memory_order_relaxed); }
+
         virtual std::ostream &stream() = 0;
 
         virtual void write(const string &message) = 0;
@@ -108,9 +270,29 @@ namespace acul::log
             for (auto &token : *_tokens) token->handle(level, message, ss);
         }
 
+        void parse_tokens(const record &record, const char *message, stringstream &ss)
+        {
+            for (auto &token : *_tokens) token->handle_record(record, message, ss);
+        }
+
+        /// Sets the encoder used for structured records. Passing nullptr restores the text encoder.
+        void set_encoder(const shared_ptr<encoder_base> &encoder) { _encoder = encoder; }
+
+        const encoder_base &encoder() const;
+
+        /**
+         * @brief Starts a structured record with a typed field.
+         *
+         * Usage: logger->with("asset", id).with("bytes", size).info("loaded");
+         */
+        template <typename T>
+        inline record_builder with(const string &key, T &&value);
+
     private:
         string _name;
-        shared_ptr<token_handler_list> _tokens;
+        ts_shared_ptr<token_handler_list> _tokens;
+        shared_ptr<encoder_base> _encoder;
+        std::atomic<enum level> _level{level::trace};
     };
 
     class APPLIB_API file_logger final : public logger_base
@@ -131,7 +313,7 @@ namespace acul::log
 
         virtual void write(const string &message) override
         {
-            if (_fs.is_open()) _fs << message.c_str();
+            if (_fs.is_open()) _fs.write(message.data(), message.size());
         }
 
     private:
@@ -150,7 +332,7 @@ namespace acul::log
 
         virtual void write(const string &message) override
         {
-            if (_fs.is_open()) _fs << message.c_str();
+            if (_fs.is_open()) _fs.write(message.data(), message.size());
         }
 
     private:
@@ -164,7 +346,7 @@ namespace acul::log
 
         std::ostream &stream() override { return std::cout; }
 
-        virtual void write(const string &message) override { std::cout << message.c_str(); }
+        virtual void write(const string &message) override { std::cout.write(message.data(), message.size()); }
     };
 
     /**
@@ -223,6 +405,9 @@ namespace acul::log
         __attribute__((format(printf, 4, 5))) void log(logger_base *logger, enum level level, const char *message, ...);
         void vlog(logger_base *logger, enum level level, const char *message, va_list args);
 
+        /// Queues a structured record. Fields are encoded later by the logger encoder on the dispatch thread.
+        void submit(logger_base *logger, enum level level, const string &message, vector<field> &&fields);
+
         virtual std::chrono::steady_clock::time_point dispatch() override;
 
         virtual void await(bool force = false) override
@@ -230,14 +415,22 @@ namespace acul::log
             if (force)
             {
                 _queue.clear();
+                _count.store(0, std::memory_order_relaxed);
                 return;
             }
             while (_count.load(std::memory_order_relaxed) > 0) std::this_thread::yield();
         }
 
     private:
+        struct entry
+        {
+            logger_base *logger = nullptr;
+            bool structured = false; ///< False if the message is already formatted by the logger pattern
+            record data;
+        };
+
         hashmap<string, logger_base *> _loggers;
-        oneapi::tbb::concurrent_queue<pair<logger_base *, string>> _queue;
+        oneapi::tbb::concurrent_queue<entry, mem_allocator<entry, mem_tags::log>> _queue;
         std::atomic<int> _count{0};
     };
 
@@ -268,17 +461,175 @@ namespace acul::log
         return get_log_service()->get_logger(name);
     }
 
+    /// Checks the service and logger thresholds. Used by the LOG_* macros before any argument is evaluated.
+    ACUL_FORCEINLINE bool is_enabled(logger_base *logger, enum level level)
+    {
+        auto *service = detail::g_log_ctx.log_service;
+        return service && level <= service->level && logger->is_enabled(level);
+    }
+
+    /**
+     * @brief Fixed one-second window limiter backing the LOG_*_RATE_LIMITED macros.
+     *
+     * Every call site owns a static instance. The window switch is not exact under contention,
+     * which may let a few extra messages through at a boundary.
+     */
+    class rate_limiter
+    {
+    public:
+        explicit rate_limiter(u32 per_sec) noexcept : _per_sec(per_sec) {}
+
+        bool try_acquire() noexcept
+        {
+            using namespace std::chrono;
+            const i64 now = duration_cast<seconds>(steady_clock::now().time_since_epoch()).count();
+            i64 window = _window.load(std::memory_order_relaxed);
+            if (window != now && _window.compare_exchange_strong(window, now, std::memory_order_relaxed))
+                _count.store(0, std::memory_order_relaxed);
+            return _count.fetch_add(1, std::memory_order_relaxed) < _per_sec;
+        }
+
+    private:
+        const u32 _per_sec;
+        std::atomic<i64> _window{-1};
+        std::atomic<u32> _count{0};
+    };
+
+    /// Collects fields for a structured record and submits it on one of the level calls.
+    class record_builder
+    {
+    public:
+        explicit record_builder(logger_base *logger) : _logger(logger) {}
+
+        template <typename T>
+        record_builder &with(const string &key, T &&value)
+        {
+            _fields.emplace_back(key, std::forward<T>(value));
+            return *this;
+        }
+
+        void log(enum level level, const string &message)
+        {
+            if (!is_enabled(_logger, level)) return;
+            detail::g_log_ctx.log_service->submit(_logger, level, message, std::move(_fields));
+        }
+
+        void fatal(const string &message) { log(level::fatal, message); }
+        void error(const string &message) { log(level::error, message); }
+        void warn(const string &message) { log(level::warn, message); }
+        void info(const string &message) { log(level::info, message); }
+        void debug(const string &message) { log(level::debug, message); }
+        void trace(const string &message) { log(level::trace, message); }
+
+    private:
+        logger_base *_logger;
+        vector<field> _fields;
+    };
+
+    template <typename T>
+    inline record_builder logger_base::with(const string &key, T &&value)
+    {
+        record_builder builder(this);
+        builder.with(key, std::forward<T>(value));
+        return builder;
+    }
+
     __attribute__((format(printf, 4, 5))) APPLIB_API void write(log_service *log_service, logger_base *logger,
                                                                 enum level level, const char *message, ...);
 
 } // namespace acul::log
 
-#define ACUL_LOG_DEFAULT(level, ...) \
-    acul::log::get_log_service()->log(acul::log::get_default_logger(), level, __VA_ARGS__)
-#define LOG_INFO(...)  ACUL_LOG_DEFAULT(acul::log::level::info, __VA_ARGS__)
-#define LOG_DEBUG(...) ACUL_LOG_DEFAULT(acul::log::level::debug, __VA_ARGS__)
-#define LOG_TRACE(...) ACUL_LOG_DEFAULT(acul::log::level::trace, __VA_ARGS__)
-#define LOG_WARN(...)  ACUL_LOG_DEFAULT(acul::log::level::warn, __VA_ARGS__)
-#define LOG_ERROR(...) ACUL_LOG_DEFAULT(acul::log::level::error, __VA_ARGS__)
-#define LOG_FATAL(...) ACUL_LOG_DEFAULT(acul::log::level::fatal, __VA_ARGS__)
+#define ACUL_LOG_NOOP() \
+    do {                \
+    } while (0)
+
+#define ACUL_LOG_DEFAULT(level, ...)                                                 \
+    do {                                                                             \
+        acul::log::logger_base *acul_log_logger_ = acul::log::get_default_logger();  \
+        if (acul::log::is_enabled(acul_log_logger_, level))                          \
+            acul::log::get_log_service()->log(acul_log_logger_, level, __VA_ARGS__); \
+    } while (0)
+
+#define ACUL_LOG_EVERY_N(level, n, ...)                                                                       \
+    do {                                                                                                      \
+        acul::log::logger_base *acul_log_logger_ = acul::log::get_default_logger();                           \
+        if (acul::log::is_enabled(acul_log_logger_, level))                                                   \
+        {                                                                                                     \
+            static std::atomic<u64> acul_log_hits_{0};                                                        \
+            const auto acul_log_n_ = (n);                                                                     \
+            if (acul_log_n_ > 0 && acul_log_hits_.fetch_add(1, std::memory_order_relaxed) % acul_log_n_ == 0) \
+                acul::log::get_log_service()->log(acul_log_logger_, level, __VA_ARGS__);                      \
+        }                                                                                                     \
+    } while (0)
+
+#define ACUL_LOG_RATE_LIMITED(level, per_sec, ...)                                       \
+    do {                                                                                 \
+        acul::log::logger_base *acul_log_logger_ = acul::log::get_default_logger();      \
+        if (acul::log::is_enabled(acul_log_logger_, level))                              \
+        {                                                                                \
+            static acul::log::rate_limiter acul_log_limiter_{per_sec};                   \
+            if (acul_log_limiter_.try_acquire())                                         \
+                acul::log::get_log_service()->log(acul_log_logger_, level, __VA_ARGS__); \
+        }                                                                                \
+    } while (0)
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_FATAL
+    #define LOG_FATAL(...)                       ACUL_LOG_DEFAULT(acul::log::level::fatal, __VA_ARGS__)
+    #define LOG_FATAL_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::fatal, n, __VA_ARGS__)
+    #define LOG_FATAL_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::fatal, per_sec, __VA_ARGS__)
+#else
+    #define LOG_FATAL(...)                       ACUL_LOG_NOOP()
+    #define LOG_FATAL_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_FATAL_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_ERROR
+    #define LOG_ERROR(...)                       ACUL_LOG_DEFAULT(acul::log::level::error, __VA_ARGS__)
+    #define LOG_ERROR_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::error, n, __VA_ARGS__)
+    #define LOG_ERROR_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::error, per_sec, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...)                       ACUL_LOG_NOOP()
+    #define LOG_ERROR_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_ERROR_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_WARN
+    #define LOG_WARN(...)                       ACUL_LOG_DEFAULT(acul::log::level::warn, __VA_ARGS__)
+    #define LOG_WARN_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::warn, n, __VA_ARGS__)
+    #define LOG_WARN_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::warn, per_sec, __VA_ARGS__)
+#else
+    #define LOG_WARN(...)                       ACUL_LOG_NOOP()
+    #define LOG_WARN_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_WARN_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_INFO
+    #define LOG_INFO(...)                       ACUL_LOG_DEFAULT(acul::log::level::info, __VA_ARGS__)
+    #define LOG_INFO_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::info, n, __VA_ARGS__)
+    #define LOG_INFO_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::info, per_sec, __VA_ARGS__)
+#else
+    #define LOG_INFO(...)                       ACUL_LOG_NOOP()
+    #define LOG_INFO_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_INFO_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...)                       ACUL_LOG_DEFAULT(acul::log::level::debug, __VA_ARGS__)
+    #define LOG_DEBUG_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::debug, n, __VA_ARGS__)
+    #define LOG_DEBUG_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::debug, per_sec, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...)                       ACUL_LOG_NOOP()
+    #define LOG_DEBUG_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_DEBUG_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
+
+#if ACUL_LOG_MIN_LEVEL >= ACUL_LOG_LEVEL_TRACE
+    #define LOG_TRACE(...)                       ACUL_LOG_DEFAULT(acul::log::level::trace, __VA_ARGS__)
+    #define LOG_TRACE_EVERY_N(n, ...)            ACUL_LOG_EVERY_N(acul::log::level::trace, n, __VA_ARGS__)
+    #define LOG_TRACE_RATE_LIMITED(per_sec, ...) ACUL_LOG_RATE_LIMITED(acul::log::level::trace, per_sec, __VA_ARGS__)
+#else
+    #define LOG_TRACE(...)                       ACUL_LOG_NOOP()
+    #define LOG_TRACE_EVERY_N(n, ...)            ACUL_LOG_NOOP()
+    #define LOG_TRACE_RATE_LIMITED(per_sec, ...) ACUL_LOG_NOOP()
+#endif
 #endif
\ No newline at end of file
@@ -3,15 +3,110 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+    #include <atomic>
+    #include <cstdint>
+#endif
 #include <limits>
 #include <oneapi/tbb/scalable_allocator.h>
 #include <type_traits>
 #include <utility>
+#include "../api.hpp"
+#include "../fwd/alloc.hpp"
+#include "../scalars.hpp"
 #include "../type_traits.hpp"
 
 namespace acul
 {
-    template <typename T>
+    /// Tags of the library's own allocations for memory accounting. A tag is any type with a static `name`.
+    namespace mem_tags
+    {
+        struct string
+        {
+            static constexpr const char *name = "string";
+        };
+
+        struct hash_table
+        {
+            static constexpr const char *name = "hash_table";
+        };
+
+        struct jatc
+        {
+            static constexpr const char *name = "jatc";
+        };
+
+        struct log
+        {
+            static constexpr const char *name = "log";
+        };
+    } // namespace mem_tags
+
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+    namespace detail
+    {
+        /// Index of the counters of a tag name, the same for every type with that name. 0 is untagged memory.
+        APPLIB_API u32 register_mem_tag(const char *name) noexcept;
+
+        APPLIB_API void account_alloc(u32 tag, size_t bytes) noexcept;
+
+        APPLIB_API void account_free(u32 tag, size_t bytes) noexcept;
+
+        template <typename Tag>
+        inline u32 mem_tag_index() noexcept
+        {
+            if constexpr (std::is_void_v<Tag>) return 0;
+            else
+            {
+                static const u32 index = register_mem_tag(Tag::name);
+                return index;
+            }
+        }
+    } // namespace detail
+#endif
+
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+    namespace detail
+    {
+        /// Bytes the calling thread may still allocate before the next allocation is sampled. Zero on a new
+        /// thread, whose first allocation draws the first distance. Defined once in the library so that
+        /// allocations inlined into other binaries count down the same value.
+        extern APPLIB_API constinit thread_local i64 heap_sample_countdown;
+
+        /// Counting filter over the addresses of live samples, so a free looks at the sample table only
+        /// when the block may have been sampled.
+        constexpr size_t heap_sample_filter_size = 1 << 16;
+        extern APPLIB_API std::atomic<u16> heap_sample_filter[heap_sample_filter_size];
+
+        inline size_t heap_sample_slot(const void *p) noexcept
+        {
+            return static_cast<size_t>((reinterpret_cast<uintptr_t>(p) >> 4) * 0x9E3779B97F4A7C15ULL >> 48);
+        }
+
+        APPLIB_API void heap_profiler_sample(void *p, size_t bytes) noexcept;
+
+        APPLIB_API void heap_profiler_free(void *p) noexcept;
+
+        inline void heap_profiler_on_alloc(void *p, size_t bytes) noexcept
+        {
+            if ((heap_sample_countdown -= static_cast<i64>(bytes)) <= 0) heap_profiler_sample(p, bytes);
+        }
+
+        inline void heap_profiler_on_free(void *p) noexcept
+        {
+            if (heap_sample_filter[heap_sample_slot(p)].load(std::memory_order_relaxed)) heap_profiler_free(p);
+        }
+    } // namespace detail
+#endif
+
+    /**
+     * @brief Allocator on the scalable heap.
+     *
+     * `Tag` names the subsystem the memory is counted under when the library is built with
+     * ACUL_MEM_ACCOUNTING_ENABLE, see mem_stats.hpp. Without it the tag only tells the types apart.
+     */
+    template <typename T, typename Tag>
     class mem_allocator
     {
     public:
@@ -21,20 +116,92 @@ namespace acul
         using size_type = size_t;
         using difference_type = ptrdiff_t;
 
+        mem_allocator() noexcept = default;
+
+        template <typename U>
+        mem_allocator(const mem_allocator<U, Tag> &) noexcept
+        {
+        }
+
         static inline pointer allocate(size_type num, const void *hint = 0) noexcept
         {
             if (num > std::numeric_limits<size_type>::max() / sizeof(T)) return nullptr;
-            if (auto p = static_cast<pointer>(scalable_malloc(num * sizeof(T)))) return p;
+            if (auto p = static_cast<pointer>(scalable_malloc(num * sizeof(T))))
+            {
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+                detail::account_alloc(detail::mem_tag_index<Tag>(), scalable_msize(p));
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+                detail::heap_profiler_on_alloc(p, num * sizeof(T));
+#endif
+                return p;
+            }
+            return nullptr;
+        }
+
+        /// Allocates `num` objects at an address aligned to `alignment`, a power of two. The memory is released
+        /// with deallocate_aligned() and must not be passed to reallocate().
+        static inline pointer allocate_aligned(size_type num, size_t alignment) noexcept
+        {
+            if (num > std::numeric_limits<size_type>::max() / sizeof(T)) return nullptr;
+            if (auto p = static_cast<pointer>(scalable_aligned_malloc(num * sizeof(T), alignment)))
+            {
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+                detail::account_alloc(detail::mem_tag_index<Tag>(), scalable_msize(p));
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+                detail::heap_profiler_on_alloc(p, num * sizeof(T));
+#endif
+                return p;
+            }
             return nullptr;
         }
 
         static inline pointer reallocate(pointer p, size_type new_size) noexcept
         {
-            return reinterpret_cast<pointer>(p ? scalable_realloc(p, new_size * sizeof(T))
-                                               : scalable_malloc(new_size * sizeof(T)));
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            const size_t old_size = p ? scalable_msize(p) : 0;
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            if (p) detail::heap_profiler_on_free(p);
+#endif
+            auto new_p = reinterpret_cast<pointer>(p ? scalable_realloc(p, new_size * sizeof(T))
+                                                     : scalable_malloc(new_size * sizeof(T)));
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            if (new_p)
+            {
+                if (p) detail::account_free(detail::mem_tag_index<Tag>(), old_size);
+                detail::account_alloc(detail::mem_tag_index<Tag>(), scalable_msize(new_p));
+            }
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            if (new_p) detail::heap_profiler_on_alloc(new_p, new_size * sizeof(T));
+#endif
+            return new_p;
         }
 
-        static inline void deallocate(pointer p, size_type num = 0) noexcept { scalable_free(p); }
+        static inline void deallocate(pointer p, size_type num = 0) noexcept
+        {
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            if (p) detail::account_free(detail::mem_tag_index<Tag>(), scalable_msize(p));
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            if (p) detail::heap_profiler_on_free(p);
+#endif
+            scalable_free(p);
+        }
+
+        /// Releases memory from allocate_aligned().
+        static inline void deallocate_aligned(pointer p, size_type = 0) noexcept
+        {
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            if (p) detail::account_free(detail::mem_tag_index<Tag>(), scalable_msize(p));
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            if (p) detail::heap_profiler_on_free(p);
+#endif
+            scalable_aligned_free(p);
+        }
 
         static inline size_type max_size() noexcept { return std::numeric_limits<size_type>::max() / sizeof(T); }
 
@@ -60,18 +227,18 @@ namespace acul
         template <typename U>
         struct rebind
         {
-            using other = mem_allocator<U>;
+            using other = mem_allocator<U, Tag>;
         };
     };
 
-    template <typename T, typename U>
-    bool operator==(const mem_allocator<T> &, const mem_allocator<U> &)
+    template <typename T, typename U, typename TagT, typename TagU>
+    bool operator==(const mem_allocator<T, TagT> &, const mem_allocator<U, TagU> &)
     {
         return true;
     }
 
-    template <typename T, typename U>
-    bool operator!=(const mem_allocator<T> &, const mem_allocator<U> &)
+    template <typename T, typename U, typename TagT, typename TagU>
+    bool operator!=(const mem_allocator<T, TagT> &, const mem_allocator<U, TagU> &)
     {
         return false;
     }
@@ -128,6 +295,25 @@ namespace acul
         return std::max(csize * 2, std::max((size_t)8UL, msize));
     }
 
+    /**
+     * @brief Moves `count` objects to the uninitialized memory at `dst` and ends the lifetime of the
+     * sources, with a single memcpy for trivially relocatable types. The ranges must not overlap.
+     */
+    template <typename T>
+    inline void relocate(T *src, size_t count, T *dst) noexcept
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (count) memcpy((void *)dst, (const void *)src, count * sizeof(T));
+        }
+        else
+            for (size_t i = 0; i < count; ++i)
+            {
+                ::new ((void *)(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+    }
+
     inline uint32_t get_growth_size_aligned(uint32_t x)
     {
         if (x <= 8) return 8;
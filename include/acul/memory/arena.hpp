@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../api.hpp"
+#include "alloc.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Monotonic bump allocator.
+     *
+     * Serves allocations from a chain of blocks by advancing a cursor, so an allocation is a few instructions
+     * and freeing is a no-op. Memory comes back all at once: reset() rewinds to the first block in O(1) and
+     * keeps the chain for the next round, the destructor returns the blocks to the heap. Only the latest
+     * allocation can be given back or grown in place. Not thread-safe.
+     */
+    class APPLIB_API arena
+    {
+    public:
+        static constexpr size_t default_block_size = 64 << 10;
+        /// Alignment of the allocations unless asked for more, the same as the heap guarantees.
+        static constexpr size_t default_alignment = alignof(std::max_align_t);
+
+        explicit arena(size_t block_size = default_block_size) noexcept;
+
+        arena(const arena &) = delete;
+        arena &operator=(const arena &) = delete;
+
+        ~arena();
+
+        /// Returns `size` bytes aligned to `alignment`, a power of two. Null when the heap is exhausted.
+        void *allocate(size_t size, size_t alignment = default_alignment) noexcept
+        {
+            const uintptr_t p = align_up(reinterpret_cast<uintptr_t>(_cursor), alignment);
+            const uintptr_t end = reinterpret_cast<uintptr_t>(_end);
+            if (ACUL_LIKELY(p <= end && size <= end - p))
+            {
+                _last = reinterpret_cast<char *>(p);
+                _cursor = _last + size;
+                return _last;
+            }
+            return allocate_slow(size, alignment);
+        }
+
+        /// Takes back the memory of `p` if it is the latest allocation, otherwise does nothing.
+        void deallocate(void *p) noexcept
+        {
+            if (p && p == _last)
+            {
+                _cursor = _last;
+                _last = nullptr;
+            }
+        }
+
+        /// Resizes the latest allocation to `size` bytes without moving it. False for other pointers or when
+        /// the block has no room.
+        bool resize(void *p, size_t size) noexcept
+        {
+            if (!p || p != _last || size > static_cast<size_t>(_end - _last)) return false;
+            _cursor = _last + size;
+            return true;
+        }
+
+        /// Bytes readable from `p` up to the end of the memory handed out by this arena, 0 when `p` is not
+        /// in the allocated part of its blocks.
+        size_t extent(const void *p) const noexcept;
+
+        /// Makes all memory available again, keeping the blocks.
+        void reset() noexcept;
+
+        /// Returns all blocks to the heap.
+        void release() noexcept;
+
+        /// Bytes handed out since the last reset, alignment padding and skipped block tails included.
+        size_t used() const noexcept;
+
+        /// Bytes held in blocks.
+        size_t reserved() const noexcept { return _reserved; }
+
+    private:
+        struct block
+        {
+            block *next;
+            size_t size;
+
+            char *data() noexcept { return reinterpret_cast<char *>(this + 1); }
+        };
+
+        block *_head = nullptr;
+        block *_current = nullptr;
+        char *_cursor = nullptr;
+        char *_end = nullptr;
+        char *_last = nullptr;
+        size_t _block_size;
+        size_t _reserved = 0;
+
+        void *allocate_slow(size_t size, size_t alignment) noexcept;
+    };
+
+    class arena_scope;
+
+    namespace detail
+    {
+        /// Innermost arena_scope of the calling thread.
+        APPLIB_API arena_scope *&current_arena_scope() noexcept;
+
+        APPLIB_API void *arena_reallocate(void *p, size_t size, size_t alignment) noexcept;
+    } // namespace detail
+
+    /**
+     * @brief Makes an arena current for arena_allocator on the calling thread until the scope ends.
+     *
+     * Scopes nest, the innermost one wins. Containers allocate from the arena that is current when they
+     * allocate, so a container must not outlive the arenas its memory came from.
+     */
+    class arena_scope
+    {
+    public:
+        explicit arena_scope(arena &a) noexcept : _arena(a), _previous(detail::current_arena_scope())
+        {
+            detail::current_arena_scope() = this;
+        }
+
+        arena_scope(const arena_scope &) = delete;
+        arena_scope &operator=(const arena_scope &) = delete;
+
+        ~arena_scope() noexcept { detail::current_arena_scope() = _previous; }
+
+        arena &get() const noexcept { return _arena; }
+
+        arena_scope *previous() const noexcept { return _previous; }
+
+    private:
+        arena &_arena;
+        arena_scope *_previous;
+    };
+
+    /// Arena of the innermost scope on the calling thread, null outside any scope.
+    inline arena *current_arena() noexcept
+    {
+        arena_scope *scope = detail::current_arena_scope();
+        return scope ? &scope->get() : nullptr;
+    }
+
+    /**
+     * @brief Allocator that takes memory from current_arena().
+     *
+     * Keeps the static interface of mem_allocator, so any container of the library can be pointed at an
+     * arena through its Allocator parameter. Outside of an arena_scope allocation fails. deallocate() is
+     * free and only reclaims the latest allocation of the current arena. reallocate() copies from blocks of
+     * the arenas of enclosing scopes and fails for memory of arenas that are no longer in scope.
+     */
+    template <typename T>
+    class arena_allocator : public mem_allocator<T>
+    {
+        static constexpr size_t alignment =
+            alignof(T) > arena::default_alignment ? alignof(T) : arena::default_alignment;
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        static inline pointer allocate(size_type num, const void * = 0) noexcept
+        {
+            arena *a = current_arena();
+            if (!a || num > mem_allocator<T>::max_size()) return nullptr;
+            return static_cast<pointer>(a->allocate(num * sizeof(T), alignment));
+        }
+
+        static inline pointer allocate_aligned(size_type num, size_t align) noexcept
+        {
+            arena *a = current_arena();
+            if (!a || num > mem_allocator<T>::max_size()) return nullptr;
+            return static_cast<pointer>(a->allocate(num * sizeof(T), align > alignment ? align : alignment));
+        }
+
+        static inline pointer reallocate(pointer p, size_type new_size) noexcept
+        {
+            if (new_size > mem_allocator<T>::max_size()) return nullptr;
+            return static_cast<pointer>(detail::arena_reallocate(p, new_size * sizeof(T), alignment));
+        }
+
+        static inline void deallocate(pointer p, size_type = 0) noexcept
+        {
+            if (arena *a = current_arena()) a->deallocate(p);
+        }
+
+        static inline void deallocate_aligned(pointer p, size_type = 0) noexcept { deallocate(p); }
+
+        template <typename U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+    };
+} // namespace acul
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../api.hpp"
+#include "../fwd/sstream.hpp"
+#include "alloc.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Sampling profiler of the allocations made through mem_allocator.
+     *
+     * Allocations are sampled at Poisson-distributed byte intervals: each byte allocated has the same
+     * chance to be picked, so on average one sample is taken every `sample_interval` bytes and large
+     * allocations are seen more often than small ones. A sample records the stack of the allocation and
+     * stays in a side table until the block is freed. Between samples an allocation costs a thread-local
+     * subtraction and a free a look at a 128 KiB filter.
+     *
+     * Available when the library is built with ACUL_HEAP_PROFILER_ENABLE, otherwise start() does nothing
+     * and the profiles are empty.
+     */
+    namespace heap_profiler
+    {
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+        constexpr bool enabled = true;
+#else
+        constexpr bool enabled = false;
+#endif
+
+        constexpr size_t default_sample_interval = 512 << 10;
+
+        /// Starts sampling. Threads switch to a new interval after their pending sample.
+        APPLIB_API void start(size_t sample_interval = default_sample_interval) noexcept;
+
+        /// Stops taking new samples. Samples already taken are kept and still leave when their block is freed.
+        APPLIB_API void stop() noexcept;
+
+        APPLIB_API bool running() noexcept;
+
+        /// Drops all samples.
+        APPLIB_API void reset();
+
+        /**
+         * @brief Writes the samples in the legacy heap profile format of gperftools, read by pprof.
+         *
+         * Counts are written as sampled with the heap_v2 rate in the header, pprof scales them back up.
+         * On Linux the mappings of the process follow, so pprof can symbolize against the binaries.
+         */
+        APPLIB_API void write_pprof(stringstream &stream);
+
+        /**
+         * @brief Writes one line per stack, outermost frame first, in the folded format read by flame graph
+         * tools.
+         *
+         * Values are the estimated bytes: of the live allocations when `live` is set, otherwise of all
+         * allocations since the profiler was started.
+         */
+        APPLIB_API void write_folded(stringstream &stream, bool live = true);
+    } // namespace heap_profiler
+} // namespace acul
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "../api.hpp"
+#include "alloc.hpp"
+
+namespace acul
+{
+    namespace detail
+    {
+        /// Huge blocks start at a huge page boundary with this header, the memory handed out follows it.
+        struct huge_block
+        {
+            u64 magic;
+            size_t mapped;
+        };
+
+        constexpr size_t huge_page_size = 2 << 20;
+        constexpr size_t huge_block_offset = 64;
+        constexpr u64 huge_block_magic = 0x48554745424C4B31ULL;
+
+        /// Maps at least `bytes` at a huge page boundary and asks the kernel to back them with huge pages.
+        /// Null on failure.
+        APPLIB_API huge_block *map_huge_block(size_t bytes) noexcept;
+
+        APPLIB_API void unmap_huge_block(huge_block *block) noexcept;
+
+        /// Huge block `p` belongs to, null for heap memory. The header lies in the 4 KiB page of `p`, so the
+        /// check reads no memory outside the page of the block.
+        inline huge_block *huge_block_of(const void *p) noexcept
+        {
+            const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+            if ((address & (huge_page_size - 1)) != huge_block_offset) return nullptr;
+            auto *block = reinterpret_cast<huge_block *>(address - huge_block_offset);
+            return block->magic == huge_block_magic ? block : nullptr;
+        }
+    } // namespace detail
+
+    /// Default policy of huge_page_allocator: allocations from 4 MiB up get their own mapping.
+    struct huge_page_policy
+    {
+        static constexpr size_t threshold = 4 << 20;
+    };
+
+    /**
+     * @brief Allocator that places large allocations on huge pages.
+     *
+     * Allocations of at least `Policy::threshold` bytes are mapped on their own at a 2 MiB boundary and
+     * advised for transparent huge pages, smaller ones go to mem_allocator. Meant for multi-gigabyte tables
+     * and buffers that are accessed at random, where a 4 KiB page per TLB entry is the bottleneck. The
+     * mapped memory is 64-byte aligned and is given back to the system when released. A reallocation that
+     * fits the mapping stays in place.
+     */
+    template <typename T, typename Policy = huge_page_policy, typename Tag = void>
+    class huge_page_allocator : public mem_allocator<T, Tag>
+    {
+        using base = mem_allocator<T, Tag>;
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        static inline pointer allocate(size_type num, const void *hint = 0) noexcept
+        {
+            if (num > base::max_size()) return nullptr;
+            if (num * sizeof(T) < Policy::threshold) return base::allocate(num, hint);
+            return map(num * sizeof(T));
+        }
+
+        static inline pointer allocate_aligned(size_type num, size_t alignment) noexcept
+        {
+            if (num > base::max_size()) return nullptr;
+            if (num * sizeof(T) < Policy::threshold || alignment > detail::huge_block_offset)
+                return base::allocate_aligned(num, alignment);
+            return map(num * sizeof(T));
+        }
+
+        static inline pointer reallocate(pointer p, size_type new_size) noexcept
+        {
+            if (new_size > base::max_size()) return nullptr;
+            const size_t bytes = new_size * sizeof(T);
+            detail::huge_block *block = p ? detail::huge_block_of(p) : nullptr;
+            if (!block && bytes < Policy::threshold) return base::reallocate(p, new_size);
+            if (block && bytes <= block->mapped - detail::huge_block_offset) return p;
+
+            pointer moved = map(bytes);
+            if (!moved || !p) return moved;
+            const size_t old_bytes = block ? block->mapped - detail::huge_block_offset : scalable_msize(p);
+            memcpy(moved, p, old_bytes < bytes ? old_bytes : bytes);
+            deallocate(p);
+            return moved;
+        }
+
+        static inline void deallocate(pointer p, size_type num = 0) noexcept { release(p, num, false); }
+
+        static inline void deallocate_aligned(pointer p, size_type num = 0) noexcept { release(p, num, true); }
+
+        template <typename U>
+        struct rebind
+        {
+            using other = huge_page_allocator<U, Policy, Tag>;
+        };
+
+    private:
+        static void release(pointer p, size_type num, bool aligned) noexcept
+        {
+            if (!p) return;
+            detail::huge_block *block = detail::huge_block_of(p);
+            if (!block) return aligned ? base::deallocate_aligned(p, num) : base::deallocate(p, num);
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            detail::account_free(detail::mem_tag_index<Tag>(), block->mapped);
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            detail::heap_profiler_on_free(p);
+#endif
+            detail::unmap_huge_block(block);
+        }
+
+        static pointer map(size_t bytes) noexcept
+        {
+            detail::huge_block *block = detail::map_huge_block(detail::huge_block_offset + bytes);
+            if (!block) return nullptr;
+            auto *p = reinterpret_cast<pointer>(reinterpret_cast<char *>(block) + detail::huge_block_offset);
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+            detail::account_alloc(detail::mem_tag_index<Tag>(), block->mapped);
+#endif
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+            detail::heap_profiler_on_alloc(p, bytes);
+#endif
+            return p;
+        }
+    };
+} // namespace acul
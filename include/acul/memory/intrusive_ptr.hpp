@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cstddef>
+#include "smart_ptr.hpp"
+
+namespace acul
+{
+    template <typename T>
+    class intrusive_ptr;
+
+    template <typename T>
+    class intrusive_weak_ptr;
+
+    namespace detail
+    {
+        /// Space make_intrusive reserves in front of objects with weak support for their counts.
+        constexpr size_t intrusive_header_size = alignof(std::max_align_t);
+    } // namespace detail
+
+    /**
+     * @brief Base of objects that keep their own reference count, for intrusive_ptr.
+     *
+     * The count lives next to the data, so holding and releasing the object touches one cache line and
+     * adopting a raw pointer needs no control block. Objects are created with make_intrusive or acul::alloc
+     * and released through acul::release once the last intrusive_ptr is gone; a hierarchy deleted through
+     * `Derived` needs a virtual destructor there.
+     *
+     * With `WeakSupport` the counts are kept in front of the object instead, so intrusive_weak_ptr can
+     * outlive it: the object is destroyed with the last strong reference and its memory is freed with the
+     * last weak one. Such objects must be created with make_intrusive.
+     *
+     * @tparam Derived The class deriving from ref_counted.
+     * @tparam RefPolicy local_ref_policy for objects owned on a single thread, atomic_ref_policy otherwise.
+     * @tparam WeakSupport Whether intrusive_weak_ptr may refer to the object.
+     */
+    template <typename Derived, typename RefPolicy = local_ref_policy, bool WeakSupport = false>
+    class ref_counted
+    {
+    public:
+        using ref_policy = RefPolicy;
+        static constexpr bool weak_support = WeakSupport;
+
+        size_t use_count() const noexcept { return counts().strong_count(); }
+
+    protected:
+        ref_counted() noexcept = default;
+
+        // A copy is a new object with owners of its own
+        ref_counted(const ref_counted &) noexcept {}
+        ref_counted &operator=(const ref_counted &) noexcept { return *this; }
+
+        ~ref_counted() = default;
+
+    private:
+        using control_block = typename RefPolicy::control_block;
+        struct no_counts
+        {
+        };
+
+        [[no_unique_address]] mutable std::conditional_t<WeakSupport, no_counts, control_block> _counts{};
+
+        template <typename U>
+        friend class intrusive_ptr;
+
+        template <typename U>
+        friend class intrusive_weak_ptr;
+
+        std::byte *storage() const noexcept
+        {
+            return (std::byte *)static_cast<const Derived *>(this) - detail::intrusive_header_size;
+        }
+
+        control_block &counts() const noexcept
+        {
+            if constexpr (WeakSupport) return *reinterpret_cast<control_block *>(storage());
+            else return _counts;
+        }
+
+        void add_ref() const noexcept { counts().increment_strong(); }
+
+        bool try_add_ref() const noexcept { return counts().try_increment_strong(); }
+
+        void release_ref() const noexcept
+        {
+            if (counts().decrement_strong() != 0) return;
+            auto *self = const_cast<Derived *>(static_cast<const Derived *>(this));
+            if constexpr (WeakSupport)
+            {
+                // The strong references hold one weak reference together, it goes after the destructor
+                std::byte *memory = storage();
+                self->~Derived();
+                release_weak(memory);
+            }
+            else release(self);
+        }
+
+        void add_weak() const noexcept { counts().increment_weak(); }
+
+        static void release_weak(std::byte *memory) noexcept
+        {
+            if (reinterpret_cast<control_block *>(memory)->decrement_weak() == 0)
+                mem_allocator<std::byte>::deallocate(memory);
+        }
+    };
+
+    /**
+     * @brief Pointer to an object deriving from ref_counted.
+     *
+     * The size of a raw pointer; copies change the count inside the object, with the ordering of the
+     * policy the object was declared with.
+     */
+    template <typename T>
+    class intrusive_ptr
+    {
+    public:
+        using element_type = T;
+        using pointer = T *;
+        using reference = T &;
+        using size_type = size_t;
+        using trivially_relocatable = relocatable_tag<intrusive_ptr>;
+
+        intrusive_ptr() noexcept : _data(nullptr) {}
+
+        intrusive_ptr(std::nullptr_t) noexcept : _data(nullptr) {}
+
+        /// Adopts `p`. When `add_ref` is false the reference already counted in the object is taken over.
+        explicit intrusive_ptr(pointer p, bool add_ref = true) noexcept : _data(p)
+        {
+            if (_data && add_ref) _data->add_ref();
+        }
+
+        intrusive_ptr(const intrusive_ptr &other) noexcept : _data(other._data)
+        {
+            if (_data) _data->add_ref();
+        }
+
+        intrusive_ptr(intrusive_ptr &&other) noexcept : _data(other._data) { other._data = nullptr; }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+        intrusive_ptr(const intrusive_ptr<U> &other) noexcept : _data(other.get())
+        {
+            if (_data) _data->add_ref();
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+        intrusive_ptr(intrusive_ptr<U> &&other) noexcept : _data(other.detach())
+        {
+        }
+
+        ~intrusive_ptr()
+        {
+            if (_data) _data->release_ref();
+        }
+
+        intrusive_ptr &operator=(const intrusive_ptr &other) noexcept
+        {
+            intrusive_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr &operator=(intrusive_ptr &&other) noexcept
+        {
+            intrusive_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void reset() noexcept { intrusive_ptr().swap(*this); }
+
+        void reset(pointer p, bool add_ref = true) noexcept { intrusive_ptr(p, add_ref).swap(*this); }
+
+        /// Gives up ownership without releasing, the reference stays counted in the object.
+        pointer detach() noexcept
+        {
+            pointer p = _data;
+            _data = nullptr;
+            return p;
+        }
+
+        void swap(intrusive_ptr &other) noexcept { std::swap(_data, other._data); }
+
+        pointer get() const noexcept { return _data; }
+
+        reference operator*() const noexcept { return *_data; }
+
+        pointer operator->() const noexcept { return _data; }
+
+        explicit operator bool() const noexcept { return _data != nullptr; }
+
+        size_type use_count() const noexcept { return _data ? _data->use_count() : 0; }
+
+        template <typename U>
+        bool operator==(const intrusive_ptr<U> &other) const noexcept
+        {
+            return _data == other.get();
+        }
+
+        bool operator==(std::nullptr_t) const noexcept { return _data == nullptr; }
+
+    private:
+        pointer _data;
+    };
+
+    /// Pointer to an object created with weak support that does not keep it alive.
+    template <typename T>
+    class intrusive_weak_ptr
+    {
+        static_assert(T::weak_support, "T must derive from ref_counted with WeakSupport");
+
+    public:
+        using trivially_relocatable = relocatable_tag<intrusive_weak_ptr>;
+
+        intrusive_weak_ptr() noexcept : _data(nullptr) {}
+
+        intrusive_weak_ptr(const intrusive_ptr<T> &ptr) noexcept : _data(ptr.get())
+        {
+            if (_data) _data->add_weak();
+        }
+
+        intrusive_weak_ptr(const intrusive_weak_ptr &other) noexcept : _data(other._data)
+        {
+            if (_data) _data->add_weak();
+        }
+
+        intrusive_weak_ptr(intrusive_weak_ptr &&other) noexcept : _data(other._data) { other._data = nullptr; }
+
+        ~intrusive_weak_ptr() { reset(); }
+
+        intrusive_weak_ptr &operator=(intrusive_weak_ptr other) noexcept
+        {
+            std::swap(_data, other._data);
+            return *this;
+        }
+
+        /// The object is only read through its counts here, which outlive it.
+        void reset() noexcept
+        {
+            if (_data) T::release_weak(_data->storage());
+            _data = nullptr;
+        }
+
+        intrusive_ptr<T> lock() const noexcept
+        {
+            return _data && _data->try_add_ref() ? intrusive_ptr<T>(_data, false) : intrusive_ptr<T>();
+        }
+
+        bool expired() const noexcept { return !_data || _data->use_count() == 0; }
+
+    private:
+        T *_data;
+    };
+
+    template <typename T, typename... Args>
+    intrusive_ptr<T> make_intrusive(Args &&...args)
+    {
+        if constexpr (T::weak_support)
+        {
+            static_assert(alignof(T) <= detail::intrusive_header_size,
+                          "weak support is not available for over-aligned types");
+            using control_block = typename T::ref_policy::control_block;
+            std::byte *memory = mem_allocator<std::byte>::allocate(detail::intrusive_header_size + sizeof(T));
+            ::new (memory) control_block{1ULL};
+            T *p = reinterpret_cast<T *>(memory + detail::intrusive_header_size);
+            mem_allocator<T>::construct(p, std::forward<Args>(args)...);
+            return intrusive_ptr<T>(p);
+        }
+        else return intrusive_ptr<T>(alloc<T>(std::forward<Args>(args)...));
+    }
+
+    template <typename To, typename From>
+    inline intrusive_ptr<To> static_pointer_cast(const intrusive_ptr<From> &from) noexcept
+    {
+        return intrusive_ptr<To>(static_cast<To *>(from.get()));
+    }
+
+    template <typename To, typename From>
+    inline intrusive_ptr<To> dynamic_pointer_cast(const intrusive_ptr<From> &from) noexcept
+    {
+        return intrusive_ptr<To>(dynamic_cast<To *>(from.get()));
+    }
+} // namespace acul
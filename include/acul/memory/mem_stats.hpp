@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../api.hpp"
+#include "../vector.hpp"
+#include "alloc.hpp"
+
+namespace acul
+{
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+    constexpr bool mem_accounting_enabled = true;
+#else
+    constexpr bool mem_accounting_enabled = false;
+#endif
+
+    /// Buckets of the size histogram: bucket 0 counts blocks up to 16 bytes, bucket i up to 16 << i bytes,
+    /// the last one everything above 256 KiB.
+    constexpr size_t mem_histogram_buckets = 16;
+
+    /// Counters of one memory tag. Sizes are the usable sizes of the heap blocks, not the requested ones.
+    struct mem_tag_stats
+    {
+        const char *name;
+        size_t live_bytes;
+        /// Highest live size seen. Tracked at 64 KiB granularity per thread, so short spikes below that may
+        /// be missed.
+        size_t peak_bytes;
+        u64 allocations;
+        u64 frees;
+        u64 histogram[mem_histogram_buckets];
+    };
+
+    /**
+     * @brief Returns the counters of every tag that allocated so far, untagged memory first.
+     *
+     * Counters are summed over per-thread shards without stopping the allocating threads, so a snapshot
+     * taken under load is consistent per counter, not across them. Empty when the library is built without
+     * ACUL_MEM_ACCOUNTING_ENABLE.
+     */
+    APPLIB_API vector<mem_tag_stats> mem_stats_snapshot();
+} // namespace acul
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../api.hpp"
+#include "alloc.hpp"
+
+namespace acul
+{
+    namespace detail
+    {
+        /// Slabs are allocated at their own alignment, so the header of an object's slab is found by masking.
+        constexpr size_t pool_slab_size = 64 << 10;
+
+        struct pool_free_node
+        {
+            pool_free_node *next;
+        };
+
+        struct pool_cache;
+
+        /// Size class shared by all pools of one object size, alignment and release mode.
+        struct pool_class
+        {
+            size_t object_size;
+            size_t alignment;
+            /// Caches of exited threads, taken over by new threads.
+            pool_cache *idle = nullptr;
+            std::atomic<size_t> slabs{0};
+        };
+
+        struct pool_slab
+        {
+            pool_cache *owner;
+        };
+
+        /**
+         * @brief Free list and slab cursor of one thread for one size class.
+         *
+         * Caches are never destroyed: a thread leaving hands its cache over to the next thread that needs one
+         * of the class, so slab headers may point to their cache for good.
+         */
+        struct pool_cache
+        {
+            pool_free_node *free = nullptr;
+            char *cursor = nullptr;
+            char *end = nullptr;
+            /// Objects freed by other threads, taken over when the free list runs dry.
+            std::atomic<pool_free_node *> returned{nullptr};
+            pool_class *cls;
+            pool_cache *next_idle = nullptr;
+        };
+
+        APPLIB_API pool_cache *pool_attach(pool_class &cls) noexcept;
+
+        APPLIB_API void pool_detach(pool_cache *cache) noexcept;
+
+        /// Takes the returned objects or carves a new slab when the free list is empty. Null when the heap is
+        /// exhausted.
+        APPLIB_API void *pool_refill(pool_cache *cache) noexcept;
+
+        inline void pool_return(pool_cache *owner, void *p) noexcept
+        {
+            auto *node = static_cast<pool_free_node *>(p);
+            node->next = owner->returned.load(std::memory_order_relaxed);
+            while (!owner->returned.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                          std::memory_order_relaxed))
+                ;
+        }
+
+        inline pool_slab *pool_slab_of(void *p) noexcept
+        {
+            return reinterpret_cast<pool_slab *>(reinterpret_cast<uintptr_t>(p) & ~(pool_slab_size - 1));
+        }
+
+        /// Size class and per-thread caches of every pool that rounds to `ObjectSize` and `Alignment`.
+        template <size_t ObjectSize, size_t Alignment, bool Shared>
+        struct pool_size_class
+        {
+            struct thread_cache
+            {
+                pool_cache *cache;
+
+                thread_cache() noexcept : cache(pool_attach(get())) {}
+
+                ~thread_cache() { pool_detach(cache); }
+            };
+
+            static pool_class &get() noexcept
+            {
+                static pool_class cls{ObjectSize, Alignment};
+                return cls;
+            }
+
+            static pool_cache *local() noexcept
+            {
+                static thread_local thread_cache tc;
+                return tc.cache;
+            }
+        };
+    } // namespace detail
+
+    /**
+     * @brief Pool of fixed-size objects carved from 64 KiB slabs.
+     *
+     * Every thread has its own free list, so allocation and release take no lock and objects allocated
+     * together sit next to each other. `Size` is rounded up to a multiple of the alignment and at least a
+     * pointer, and pools that round to the same size, alignment and `Shared` share slabs. By default
+     * an object freed on another thread joins that thread's free list. With `Shared` it goes back to the
+     * thread that allocated it through a lock-free return queue, which keeps the slabs of a producer from
+     * drifting to its consumers at the cost of a look at the slab header on every release. Slab memory is
+     * kept for reuse and never returned to the heap.
+     */
+    template <size_t Size, size_t Align = alignof(std::max_align_t), bool Shared = false>
+    class pool
+    {
+        static constexpr size_t alignment = Align > alignof(void *) ? Align : alignof(void *);
+        static constexpr size_t object_size =
+            ((Size > sizeof(void *) ? Size : sizeof(void *)) + alignment - 1) & ~(alignment - 1);
+        static_assert((alignment & (alignment - 1)) == 0, "pool alignment must be a power of two");
+        static_assert(object_size <= detail::pool_slab_size / 8, "pool objects must be small next to the slab");
+
+        using class_type = detail::pool_size_class<object_size, alignment, Shared>;
+
+        static detail::pool_cache *local() noexcept { return class_type::local(); }
+
+    public:
+        static detail::pool_class &size_class() noexcept { return class_type::get(); }
+
+        static void *allocate() noexcept
+        {
+            detail::pool_cache *cache = local();
+            if (detail::pool_free_node *node = cache->free)
+            {
+                cache->free = node->next;
+                return node;
+            }
+            return detail::pool_refill(cache);
+        }
+
+        static void deallocate(void *p) noexcept
+        {
+            if (!p) return;
+            detail::pool_cache *cache = local();
+            if constexpr (Shared)
+            {
+                detail::pool_cache *owner = detail::pool_slab_of(p)->owner;
+                if (owner != cache) return detail::pool_return(owner, p);
+            }
+            auto *node = static_cast<detail::pool_free_node *>(p);
+            node->next = cache->free;
+            cache->free = node;
+        }
+    };
+
+    /**
+     * @brief Allocator giving single objects out of a pool, for node-based containers.
+     *
+     * Requests for one object go to pool<sizeof(T), alignof(T), Shared>, others to mem_allocator. Memory must
+     * be released with the count it was allocated with, so it suits containers that allocate their nodes one
+     * by one, such as list and forward_list, and not vector or string.
+     */
+    template <typename T, bool Shared = false>
+    class pool_allocator : public mem_allocator<T>
+    {
+        using object_pool = pool<sizeof(T), alignof(T), Shared>;
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        static inline pointer allocate(size_type num, const void *hint = 0) noexcept
+        {
+            if (num == 1) return static_cast<pointer>(object_pool::allocate());
+            return mem_allocator<T>::allocate(num, hint);
+        }
+
+        static inline void deallocate(pointer p, size_type num = 0) noexcept
+        {
+            if (num == 1) object_pool::deallocate(p);
+            else mem_allocator<T>::deallocate(p, num);
+        }
+
+        template <typename U>
+        struct rebind
+        {
+            using other = pool_allocator<U, Shared>;
+        };
+    };
+} // namespace acul
@@ -1,20 +1,21 @@
 #pragma once
 
+#include <atomic>
 #include "alloc.hpp"
 
 namespace acul
 {
     namespace detail
     {
-        template <class, class, class = void>
-        struct has_accept_owner : std::false_type
+        /// Whether T derives from enable_shared_from_this, found through its public policy alias: the hook
+        /// itself is private and cannot be probed from here.
+        template <class, class = void>
+        struct has_shared_from_this : std::false_type
         {
         };
 
-        template <class T, class SP>
-        struct has_accept_owner<
-            T, SP, decltype((void)std::declval<T *>()->_internal_accept_owner(std::declval<const SP &>()), void())>
-            : std::true_type
+        template <class T>
+        struct has_shared_from_this<T, std::void_t<typename T::shared_from_this_policy>> : std::true_type
         {
         };
 
@@ -49,19 +50,105 @@ namespace acul
             bool no_strong() const { return strong_count() == 0; }
 
             bool no_weak() const { return weak_count() == 0; }
+
+            bool try_increment_strong()
+            {
+                if (no_strong()) return false;
+                increment_strong();
+                return true;
+            }
+        };
+
+        /// Control block of the same packed layout with atomic updates.
+        struct atomic_mem_control_block
+        {
+            std::atomic<size_t> ref_counts;
+
+            static constexpr size_t strong_count_mask = mem_control_block::strong_count_mask;
+            static constexpr size_t weak_count_mask = mem_control_block::weak_count_mask;
+            static constexpr size_t external_flag_mask = mem_control_block::external_flag_mask;
+
+            bool is_external() const { return ref_counts.load(std::memory_order_relaxed) & external_flag_mask; }
+
+            void set_external() { ref_counts.fetch_or(external_flag_mask, std::memory_order_relaxed); }
+
+            size_t strong_count() const
+            {
+                return (ref_counts.load(std::memory_order_relaxed) & strong_count_mask) >> 32;
+            }
+
+            size_t weak_count() const { return ref_counts.load(std::memory_order_relaxed) & weak_count_mask; }
+
+            // New references come from existing ones, so taking one needs no ordering. Dropping one releases
+            // the writes made through it and the last one acquires all of them before destruction.
+            void increment_strong() { ref_counts.fetch_add(1ULL << 32, std::memory_order_relaxed); }
+
+            void increment_weak() { ref_counts.fetch_add(1, std::memory_order_relaxed); }
+
+            size_t decrement_strong()
+            {
+                const size_t prev = ref_counts.fetch_sub(1ULL << 32, std::memory_order_acq_rel);
+                return ((prev & strong_count_mask) >> 32) - 1;
+            }
+
+            size_t decrement_weak()
+            {
+                return (ref_counts.fetch_sub(1, std::memory_order_acq_rel) & weak_count_mask) - 1;
+            }
+
+            bool no_strong() const { return strong_count() == 0; }
+
+            bool no_weak() const { return weak_count() == 0; }
+
+            /// Takes a strong reference unless the object is already gone, for weak_ptr::lock.
+            bool try_increment_strong()
+            {
+                size_t counts = ref_counts.load(std::memory_order_relaxed);
+                do {
+                    if (!(counts & strong_count_mask)) return false;
+                } while (!ref_counts.compare_exchange_weak(counts, counts + (1ULL << 32), std::memory_order_relaxed));
+                return true;
+            }
         };
 
         template <class T, class SP>
         inline void accept_owner(T *p, const SP &sp)
         {
-            if constexpr (has_accept_owner<T, SP>::value) { p->_internal_accept_owner(sp); }
+            if constexpr (has_shared_from_this<T>::value)
+            {
+                static_assert(std::is_same_v<typename T::shared_from_this_policy, typename SP::ref_policy>,
+                              "enable_shared_from_this must use the reference policy of the owning shared_ptr");
+                p->_internal_accept_owner(sp);
+            }
         }
     } // namespace detail
 
-    template <typename T, typename Allocator>
+    /// Reference counting of shared_ptr for objects that do not cross threads, the default.
+    struct local_ref_policy
+    {
+        using control_block = detail::mem_control_block;
+    };
+
+    /// Reference counting of shared_ptr with atomic updates, for pointers copied and released on several
+    /// threads. The control block keeps the layout of the local policy.
+    struct atomic_ref_policy
+    {
+        using control_block = detail::atomic_mem_control_block;
+    };
+
+    template <typename T, typename Allocator, typename RefPolicy>
     class weak_ptr;
 
-    template <typename T, typename Allocator = mem_allocator<T>>
+    template <typename T, typename Allocator = mem_allocator<T>, typename RefPolicy = local_ref_policy>
+    class shared_ptr;
+
+    namespace detail
+    {
+        template <typename T, typename Allocator, typename RefPolicy, typename... Args>
+        shared_ptr<T, Allocator, RefPolicy> make_shared_impl(Args &&...args);
+    } // namespace detail
+
+    template <typename T, typename Allocator, typename RefPolicy>
     class shared_ptr
     {
     public:
@@ -70,9 +157,12 @@ namespace acul
         using size_type = size_t;
         using allocator = typename Allocator::template rebind<value_type>::other;
         using block_allocator = typename Allocator::template rebind<std::byte>::other;
+        using ref_policy = RefPolicy;
+        using control_block = typename RefPolicy::control_block;
+        using trivially_relocatable = relocatable_tag<shared_ptr>;
 
     private:
-        detail::mem_control_block *_ctrl;
+        control_block *_ctrl;
         value_type *_data;
 
         void release() noexcept
@@ -87,13 +177,13 @@ namespace acul
             }
         }
 
-        template <typename U, typename... Args>
-        friend shared_ptr<U> make_shared(Args &&...args);
+        template <typename U, typename Au, typename P, typename... Args>
+        friend shared_ptr<U, Au, P> detail::make_shared_impl(Args &&...args);
 
-        template <typename U, typename Au>
+        template <typename U, typename Au, typename P>
         friend class shared_ptr;
 
-        template <typename U, typename Au>
+        template <typename U, typename Au, typename P>
         friend class weak_ptr;
 
     public:
@@ -106,17 +196,15 @@ namespace acul
         {
             static_assert(std::is_trivially_constructible_v<value_type>,
                           "Only trivially constructible arrays supported");
-            const size_t blockSize = sizeof(detail::mem_control_block) + sizeof(value_type) * size;
-            _ctrl = (detail::mem_control_block *)block_allocator::allocate(blockSize);
-            _ctrl->ref_counts = (1ULL << 32) | 1ULL;
-            _data = reinterpret_cast<value_type *>((std::byte *)_ctrl + sizeof(detail::mem_control_block));
+            const size_t blockSize = sizeof(control_block) + sizeof(value_type) * size;
+            _ctrl = ::new (block_allocator::allocate(blockSize)) control_block{(1ULL << 32) | 1ULL};
+            _data = reinterpret_cast<value_type *>((std::byte *)_ctrl + sizeof(control_block));
         }
 
         explicit shared_ptr(pointer ptr) : _ctrl(nullptr), _data(ptr)
         {
             if (!ptr) return;
-            _ctrl = (detail::mem_control_block *)block_allocator::allocate(sizeof(detail::mem_control_block));
-            _ctrl->ref_counts = (1ULL << 32) | 1ULL;
+            _ctrl = ::new (block_allocator::allocate(sizeof(control_block))) control_block{(1ULL << 32) | 1ULL};
             _ctrl->set_external();
             detail::accept_owner(ptr, *this);
         }
@@ -127,7 +215,7 @@ namespace acul
         }
 
         template <typename U, typename Au>
-        shared_ptr(const shared_ptr<U, Au> &other) noexcept : _ctrl(other._ctrl), _data(other._data)
+        shared_ptr(const shared_ptr<U, Au, RefPolicy> &other) noexcept : _ctrl(other._ctrl), _data(other._data)
         {
             if (_ctrl) _ctrl->increment_strong();
         }
@@ -139,18 +227,17 @@ namespace acul
         }
 
         template <typename U, typename Au>
-        shared_ptr(const shared_ptr<U, Au> &other, pointer ptr) noexcept : _ctrl(other._ctrl), _data(ptr)
+        shared_ptr(const shared_ptr<U, Au, RefPolicy> &other, pointer ptr) noexcept : _ctrl(other._ctrl), _data(ptr)
         {
             if (_ctrl) _ctrl->increment_strong();
         }
 
         template <typename U, typename Au>
-        explicit shared_ptr(const weak_ptr<U, Au> &weak) noexcept : _ctrl(nullptr), _data(nullptr)
+        explicit shared_ptr(const weak_ptr<U, Au, RefPolicy> &weak) noexcept : _ctrl(nullptr), _data(nullptr)
         {
-            if (weak._ctrl && weak._ctrl->strong_count() > 0)
+            if (weak._ctrl && weak._ctrl->try_increment_strong())
             {
                 _ctrl = weak._ctrl;
-                if (_ctrl) _ctrl->increment_strong();
                 _data = weak._data;
             }
         }
@@ -220,58 +307,94 @@ namespace acul
         size_type use_count() const { return _ctrl ? _ctrl->strong_count() : 0; }
     };
 
+    namespace detail
+    {
+        template <typename T, typename Allocator, typename RefPolicy, typename... Args>
+        shared_ptr<T, Allocator, RefPolicy> make_shared_impl(Args &&...args)
+        {
+            using result_type = shared_ptr<T, Allocator, RefPolicy>;
+            using control_block = typename result_type::control_block;
+            result_type result;
+            const size_t blockSize = sizeof(control_block) + sizeof(T);
+            result._ctrl = ::new (result_type::block_allocator::allocate(blockSize)) control_block{(1ULL << 32) | 1ULL};
+            result._data = reinterpret_cast<T *>((std::byte *)result._ctrl + sizeof(control_block));
+            if constexpr (!std::is_trivially_constructible_v<T> || has_args<Args...>())
+                result_type::allocator::construct(result._data, std::forward<Args>(args)...);
+            detail::accept_owner(result._data, result);
+            return result;
+        }
+    } // namespace detail
+
     template <typename T, typename... Args>
     shared_ptr<T> make_shared(Args &&...args)
     {
-        shared_ptr<T> result;
-        const size_t blockSize = sizeof(detail::mem_control_block) + sizeof(T);
-        result._ctrl = (detail::mem_control_block *)mem_allocator<std::byte>::allocate(blockSize);
-        result._ctrl->ref_counts = (1ULL << 32) | 1ULL;
-        result._data = reinterpret_cast<T *>((std::byte *)result._ctrl + sizeof(detail::mem_control_block));
-        if constexpr (!std::is_trivially_constructible_v<T> || has_args<Args...>())
-            mem_allocator<T>::construct(result._data, std::forward<Args>(args)...);
-        detail::accept_owner(result._data, result);
-        return result;
+        return detail::make_shared_impl<T, mem_allocator<T>, local_ref_policy>(std::forward<Args>(args)...);
+    }
+
+    /// shared_ptr that may be copied and released on several threads at once.
+    template <typename T, typename Allocator = mem_allocator<T>>
+    using ts_shared_ptr = shared_ptr<T, Allocator, atomic_ref_policy>;
+
+    template <typename T, typename... Args>
+    ts_shared_ptr<T> make_ts_shared(Args &&...args)
+    {
+        return detail::make_shared_impl<T, mem_allocator<T>, atomic_ref_policy>(std::forward<Args>(args)...);
     }
 
-    template <class To, class From>
-    inline shared_ptr<To> dynamic_pointer_cast(const shared_ptr<From> &from) noexcept
+    template <class To, class From, class Au, class P>
+    inline shared_ptr<To, typename Au::template rebind<To>::other, P> dynamic_pointer_cast(
+        const shared_ptr<From, Au, P> &from) noexcept
     {
-        typedef typename shared_ptr<To>::pointer pointer;
-        typedef typename shared_ptr<To>::allocator allocator;
+        using result_type = shared_ptr<To, typename Au::template rebind<To>::other, P>;
+        typedef typename result_type::pointer pointer;
         pointer ptr = dynamic_cast<pointer>(from.get());
-        return ptr ? shared_ptr<To, allocator>(from, ptr) : shared_ptr<To, allocator>();
+        return ptr ? result_type(from, ptr) : result_type();
     }
 
-    template <typename To, typename From>
-    inline shared_ptr<To> static_pointer_cast(const shared_ptr<From> &from)
+    template <typename To, typename From, typename Au, typename P>
+    inline shared_ptr<To, typename Au::template rebind<To>::other, P> static_pointer_cast(
+        const shared_ptr<From, Au, P> &from)
     {
-        typedef typename shared_ptr<To>::pointer pointer;
-        typedef typename shared_ptr<To>::allocator allocator;
-        return shared_ptr<To, allocator>(from, static_cast<pointer>(from.get()));
+        using result_type = shared_ptr<To, typename Au::template rebind<To>::other, P>;
+        typedef typename result_type::pointer pointer;
+        return result_type(from, static_cast<pointer>(from.get()));
     }
 
-    template <typename To, typename From>
-    inline shared_ptr<To> reinterpret_pointer_cast(const shared_ptr<From> &from) noexcept
+    template <typename To, typename From, typename Au, typename P>
+    inline shared_ptr<To, typename Au::template rebind<To>::other, P> reinterpret_pointer_cast(
+        const shared_ptr<From, Au, P> &from) noexcept
     {
-        using pointer = typename shared_ptr<To>::pointer;
-        return shared_ptr<To>(from, reinterpret_cast<pointer>(from.get()));
+        using result_type = shared_ptr<To, typename Au::template rebind<To>::other, P>;
+        using pointer = typename result_type::pointer;
+        return result_type(from, reinterpret_cast<pointer>(from.get()));
     }
 
-    template <typename T, typename Allocator = mem_allocator<std::byte>>
+    template <typename T, typename Allocator = mem_allocator<std::byte>, typename RefPolicy = local_ref_policy>
     class weak_ptr
     {
-        detail::mem_control_block *_ctrl;
-        T *_data;
+        using control_block = typename RefPolicy::control_block;
+        using shared_type = shared_ptr<T, typename Allocator::template rebind<T>::other, RefPolicy>;
         using block_allocator = typename Allocator::template rebind<std::byte>::other;
 
-        template <typename U, typename Au>
+        control_block *_ctrl;
+        T *_data;
+
+        template <typename U, typename Au, typename P>
         friend class shared_ptr;
 
+        void release() noexcept
+        {
+            // The strong references hold one weak reference together, so the last weak one frees the block
+            if (_ctrl && _ctrl->decrement_weak() == 0) block_allocator::deallocate((std::byte *)_ctrl, 1);
+        }
+
     public:
+        using trivially_relocatable = relocatable_tag<weak_ptr>;
+
         weak_ptr() : _ctrl(nullptr), _data(nullptr) {}
 
-        weak_ptr(const shared_ptr<T> &ptr) : _ctrl(ptr._ctrl), _data(ptr._data)
+        template <typename Au>
+        weak_ptr(const shared_ptr<T, Au, RefPolicy> &ptr) : _ctrl(ptr._ctrl), _data(ptr._data)
         {
             if (_ctrl) _ctrl->increment_weak();
         }
@@ -285,7 +408,7 @@ namespace acul
         {
             if (this != &other)
             {
-                if (_ctrl) _ctrl->decrement_weak();
+                release();
                 _ctrl = other._ctrl;
                 _data = other._data;
                 if (_ctrl) _ctrl->increment_weak();
@@ -293,25 +416,17 @@ namespace acul
             return *this;
         }
 
-        ~weak_ptr()
-        {
-            if (_ctrl)
-            {
-                _ctrl->decrement_weak();
-                if (_ctrl->no_strong() && _ctrl->no_weak()) block_allocator::deallocate((std::byte *)_ctrl, 1);
-            }
-        }
+        ~weak_ptr() { release(); }
 
-        shared_ptr<T> lock() const
-        {
-            if (_ctrl && _ctrl->strong_count() > 0) return shared_ptr<T>(*this);
-            return nullptr;
-        }
+        shared_type lock() const { return _ctrl ? shared_type(*this) : shared_type(); }
 
         bool expired() const { return !_ctrl || _ctrl->no_strong(); }
     };
 
-    template <typename T, typename Allocator = mem_allocator<T>>
+    template <typename T, typename Allocator = mem_allocator<std::byte>>
+    using ts_weak_ptr = weak_ptr<T, Allocator, atomic_ref_policy>;
+
+    template <typename T, typename Allocator = mem_allocator<T>, typename RefPolicy = local_ref_policy>
     class enable_shared_from_this
     {
     protected:
@@ -321,24 +436,33 @@ namespace acul
         ~enable_shared_from_this() = default;
 
     public:
-        shared_ptr<T, Allocator> shared_from_this() { return shared_ptr<T>(_weak_this); }
+        /// Objects deriving from this are owned by shared_ptr with this policy, make_shared or make_ts_shared.
+        using shared_from_this_policy = RefPolicy;
+
+        shared_ptr<T, Allocator, RefPolicy> shared_from_this()
+        {
+            return shared_ptr<T, Allocator, RefPolicy>(_weak_this);
+        }
 
-        shared_ptr<T, Allocator> shared_from_this() const { return shared_ptr<const T>(_weak_this); }
+        shared_ptr<T, Allocator, RefPolicy> shared_from_this() const
+        {
+            return shared_ptr<T, Allocator, RefPolicy>(_weak_this);
+        }
 
-        weak_ptr<T, Allocator> weak_from_this() noexcept { return _weak_this; }
+        weak_ptr<T, Allocator, RefPolicy> weak_from_this() noexcept { return _weak_this; }
 
-        weak_ptr<T, Allocator> weak_from_this() const noexcept { return _weak_this; }
+        weak_ptr<T, Allocator, RefPolicy> weak_from_this() const noexcept { return _weak_this; }
 
     private:
-        mutable weak_ptr<T, Allocator> _weak_this;
+        mutable weak_ptr<T, Allocator, RefPolicy> _weak_this;
 
-        template <typename U>
-        void _internal_accept_owner(const shared_ptr<U> &shared_ptr) const noexcept
+        template <typename U, typename Au>
+        void _internal_accept_owner(const shared_ptr<U, Au, RefPolicy> &shared_ptr) const noexcept
         {
             if (_weak_this.expired()) _weak_this = static_pointer_cast<T>(shared_ptr);
         }
 
-        template <typename U, typename Au>
+        template <typename U, typename Au, typename P>
         friend class shared_ptr;
 
         template <class P, class Sp>
@@ -364,6 +488,7 @@ namespace acul
         using value_type = std::conditional_t<std::is_array_v<T>, std::remove_extent_t<T>, T>;
         using pointer = value_type *;
         using size_type = size_t;
+        using trivially_relocatable = relocatable_tag<unique_ptr, is_trivially_relocatable_v<D>>;
 
         unique_ptr(pointer ptr = nullptr) : _data(ptr) {}
 
@@ -3,6 +3,7 @@
 #include <limits>
 #include <type_traits>
 #include "scalars.hpp"
+#include "type_traits.hpp"
 
 namespace acul
 {
@@ -17,6 +18,12 @@ namespace acul
         bool operator!=(const pair<F, S> &other) const { return !(*this == other); }
     };
 
+    template <typename F, typename S>
+    struct is_trivially_relocatable<pair<F, S>>
+        : std::bool_constant<is_trivially_relocatable_v<F> && is_trivially_relocatable_v<S>>
+    {
+    };
+
     template <typename T = i32>
     struct point2D
     {
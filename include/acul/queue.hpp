@@ -1,10 +1,297 @@
 #pragma once
 
-#include <queue>
+#include <bit>
+#include <iterator>
 #include "deque.hpp"
 
 namespace acul
 {
+    /**
+     * @brief FIFO queue over a single growable circular buffer.
+     *
+     * The capacity is a power of two and positions wrap with a mask, so push and pop are a store and an
+     * increment with no per-segment bookkeeping. When full the buffer doubles: trivially relocatable
+     * elements are moved with a reallocation and one memcpy of the wrapped part, others are relocated one
+     * by one into the new buffer. Growth invalidates references; use acul::deque when they must stay valid.
+     *
+     * Offers the std::queue interface plus indexed access from the front and iteration in queue order.
+     *
+     * @tparam T The element type.
+     * @tparam Allocator The allocator for the buffer.
+     */
+    template <typename T, typename Allocator = mem_allocator<T>>
+    class ring_queue
+    {
+    public:
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = typename Allocator::pointer;
+        using const_pointer = typename Allocator::const_pointer;
+        using size_type = typename Allocator::size_type;
+        using trivially_relocatable = relocatable_tag<ring_queue>;
+
+        /// Iterates in queue order, from the front to the back.
+        template <typename Q, typename V>
+        class ring_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<V>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = V *;
+            using reference = V &;
+
+            ring_iterator() noexcept : _queue(nullptr), _index(0) {}
+
+            ring_iterator(Q *queue, size_type index) noexcept : _queue(queue), _index(index) {}
+
+            template <typename Q2, typename V2, std::enable_if_t<std::is_convertible_v<V2 *, V *>, int> = 0>
+            ring_iterator(const ring_iterator<Q2, V2> &other) noexcept : _queue(other._queue), _index(other._index)
+            {
+            }
+
+            reference operator*() const noexcept { return (*_queue)[_index]; }
+
+            pointer operator->() const noexcept { return &(*_queue)[_index]; }
+
+            reference operator[](difference_type n) const noexcept { return (*_queue)[_index + n]; }
+
+            ring_iterator &operator++() noexcept
+            {
+                ++_index;
+                return *this;
+            }
+
+            ring_iterator operator++(int) noexcept { return ring_iterator(_queue, _index++); }
+
+            ring_iterator &operator--() noexcept
+            {
+                --_index;
+                return *this;
+            }
+
+            ring_iterator operator--(int) noexcept { return ring_iterator(_queue, _index--); }
+
+            ring_iterator &operator+=(difference_type n) noexcept
+            {
+                _index += n;
+                return *this;
+            }
+
+            ring_iterator &operator-=(difference_type n) noexcept
+            {
+                _index -= n;
+                return *this;
+            }
+
+            ring_iterator operator+(difference_type n) const noexcept { return ring_iterator(_queue, _index + n); }
+
+            friend ring_iterator operator+(difference_type n, const ring_iterator &it) noexcept { return it + n; }
+
+            ring_iterator operator-(difference_type n) const noexcept { return ring_iterator(_queue, _index - n); }
+
+            template <typename Q2, typename V2>
+            difference_type operator-(const ring_iterator<Q2, V2> &other) const noexcept
+            {
+                return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+            }
+
+            template <typename Q2, typename V2>
+            bool operator==(const ring_iterator<Q2, V2> &other) const noexcept
+            {
+                return _index == other._index;
+            }
+
+            template <typename Q2, typename V2>
+            auto operator<=>(const ring_iterator<Q2, V2> &other) const noexcept
+            {
+                return _index <=> other._index;
+            }
+
+        private:
+            Q *_queue;
+            size_type _index;
+
+            template <typename, typename>
+            friend class ring_iterator;
+        };
+
+        using iterator = ring_iterator<ring_queue, T>;
+        using const_iterator = ring_iterator<const ring_queue, const T>;
+
+        ring_queue() noexcept : _data(nullptr), _head(0), _size(0), _capacity(0) {}
+
+        explicit ring_queue(size_type capacity) : ring_queue() { reserve(capacity); }
+
+        ring_queue(std::initializer_list<value_type> ilist) : ring_queue()
+        {
+            reserve(ilist.size());
+            for (const auto &value : ilist) emplace(value);
+        }
+
+        ring_queue(const ring_queue &other) : ring_queue()
+        {
+            reserve(other._size);
+            for (const auto &value : other) emplace(value);
+        }
+
+        ring_queue(ring_queue &&other) noexcept
+            : _data(other._data), _head(other._head), _size(other._size), _capacity(other._capacity)
+        {
+            other._data = nullptr;
+            other._head = other._size = other._capacity = 0;
+        }
+
+        ~ring_queue() noexcept
+        {
+            clear();
+            Allocator::deallocate(_data, _capacity);
+        }
+
+        ring_queue &operator=(const ring_queue &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other._size);
+                for (const auto &value : other) emplace(value);
+            }
+            return *this;
+        }
+
+        ring_queue &operator=(ring_queue &&other) noexcept
+        {
+            if (this != &other) ring_queue(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        /// Element `index` positions behind the front.
+        ACUL_FORCEINLINE reference operator[](size_type index) noexcept { return _data[wrap(_head + index)]; }
+
+        ACUL_FORCEINLINE const_reference operator[](size_type index) const noexcept
+        {
+            return _data[wrap(_head + index)];
+        }
+
+        ACUL_FORCEINLINE reference front() noexcept { return _data[_head]; }
+
+        ACUL_FORCEINLINE const_reference front() const noexcept { return _data[_head]; }
+
+        ACUL_FORCEINLINE reference back() noexcept { return (*this)[_size - 1]; }
+
+        ACUL_FORCEINLINE const_reference back() const noexcept { return (*this)[_size - 1]; }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+        iterator end() noexcept { return iterator(this, _size); }
+
+        const_iterator end() const noexcept { return const_iterator(this, _size); }
+
+        const_iterator cend() const noexcept { return const_iterator(this, _size); }
+
+        ACUL_FORCEINLINE bool empty() const noexcept { return _size == 0; }
+
+        ACUL_FORCEINLINE size_type size() const noexcept { return _size; }
+
+        ACUL_FORCEINLINE size_type capacity() const noexcept { return _capacity; }
+
+        ACUL_FORCEINLINE size_type max_size() const noexcept { return Allocator::max_size(); }
+
+        template <typename... Args>
+        reference emplace(Args &&...args)
+        {
+            if (_size == _capacity)
+            {
+                // The arguments may refer to an element, e.g. q.push(q.front()), which growing moves
+                T value(std::forward<Args>(args)...);
+                grow(_capacity ? _capacity * 2 : 16);
+                return construct_back(std::move(value));
+            }
+            return construct_back(std::forward<Args>(args)...);
+        }
+
+        void push(const_reference value) { emplace(value); }
+
+        void push(T &&value) { emplace(std::move(value)); }
+
+        void pop() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>) Allocator::destroy(_data + _head);
+            _head = wrap(_head + 1);
+            --_size;
+        }
+
+        void clear() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (size_type i = 0; i < _size; ++i) Allocator::destroy(&(*this)[i]);
+            _head = _size = 0;
+        }
+
+        /// Grows the buffer to hold at least `capacity` elements, rounded up to a power of two.
+        void reserve(size_type capacity)
+        {
+            if (capacity > _capacity) grow(std::bit_ceil(capacity));
+        }
+
+        void swap(ring_queue &other) noexcept
+        {
+            std::swap(_data, other._data);
+            std::swap(_head, other._head);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+        }
+
+    private:
+        pointer _data;
+        size_type _head;
+        size_type _size;
+        size_type _capacity;
+
+        ACUL_FORCEINLINE size_type wrap(size_type index) const noexcept { return index & (_capacity - 1); }
+
+        template <typename... Args>
+        ACUL_FORCEINLINE reference construct_back(Args &&...args)
+        {
+            pointer slot = _data + wrap(_head + _size);
+            Allocator::construct(slot, std::forward<Args>(args)...);
+            ++_size;
+            return *slot;
+        }
+
+        void grow(size_type new_capacity)
+        {
+            if (new_capacity > max_size()) throw bad_alloc(new_capacity);
+            const size_type head_part = _head + _size > _capacity ? _capacity - _head : _size;
+            const size_type wrapped = _size - head_part;
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                // The part in front of the head keeps its place, the wrapped part moves right after the old end
+                pointer new_data = Allocator::reallocate(_data, new_capacity);
+                if (!new_data) throw bad_alloc(new_capacity);
+                relocate(new_data, wrapped, new_data + _capacity);
+                _data = new_data;
+            }
+            else
+            {
+                pointer new_data = Allocator::allocate(new_capacity);
+                if (!new_data) throw bad_alloc(new_capacity);
+                relocate(_data + _head, head_part, new_data);
+                relocate(_data, wrapped, new_data + head_part);
+                Allocator::deallocate(_data, _capacity);
+                _data = new_data;
+                _head = 0;
+            }
+            _capacity = new_capacity;
+        }
+    };
+
+    /// FIFO queue, a ring_queue. Use std::queue over acul::deque when references must outlive pushes.
     template <typename T>
-    using queue = std::queue<T, deque<T>>;
-}
\ No newline at end of file
+    using queue = ring_queue<T>;
+} // namespace acul
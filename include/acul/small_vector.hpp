@@ -0,0 +1,414 @@
+#pragma once
+
+#include <cstring>
+#include "exception/exception.hpp"
+#include "iterator.hpp"
+#include "memory/alloc.hpp"
+#include "type_traits.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Vector that keeps up to N elements inside the object.
+     *
+     * Meant for short lists that are usually one to a few elements long: those never touch the allocator.
+     * Once the inline capacity is exceeded the elements move to the heap through `Allocator` and the
+     * container grows like acul::vector from there, relocating trivially relocatable elements with
+     * memcpy. Iterators and pointers are invalidated by any growth, and by moving the container while its
+     * elements are inline.
+     *
+     * Provides the acul::vector interface except release(), which would have nothing to hand out while
+     * the elements are inline.
+     *
+     * @tparam T The element type.
+     * @tparam N The number of elements kept inline.
+     * @tparam Allocator The allocator for spilled elements.
+     */
+    template <typename T, size_t N, typename Allocator = mem_allocator<T>>
+    class small_vector
+    {
+        static_assert(N > 0, "small_vector needs an inline capacity, use acul::vector otherwise");
+
+    public:
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = typename Allocator::pointer;
+        using const_pointer = typename Allocator::const_pointer;
+        using size_type = typename Allocator::size_type;
+
+        using iterator = pointer_iterator<pointer>;
+        using const_iterator = pointer_iterator<const_pointer>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_type inline_capacity = N;
+
+        small_vector() noexcept : _data(inline_data()), _size(0), _capacity(N) {}
+
+        explicit small_vector(size_type size) : small_vector() { resize(size); }
+
+        small_vector(size_type size, const_reference value) : small_vector() { assign(size, value); }
+
+        template <typename InputIt, std::enable_if_t<is_input_iterator_based<InputIt>::value, int> = 0>
+        small_vector(InputIt first, InputIt last) : small_vector()
+        {
+            assign(first, last);
+        }
+
+        small_vector(std::initializer_list<value_type> ilist) : small_vector() { assign(ilist.begin(), ilist.end()); }
+
+        small_vector(const small_vector &other) : small_vector()
+        {
+            reserve(other._size);
+            construct_copies(other._data, other._data + other._size, _data);
+            _size = other._size;
+        }
+
+        small_vector(small_vector &&other) noexcept : small_vector() { take(other); }
+
+        ~small_vector() noexcept
+        {
+            destroy_range(_data, _data + _size);
+            if (!is_inline()) Allocator::deallocate(_data, _capacity);
+        }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other) assign(other.begin(), other.end());
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                if (!is_inline()) Allocator::deallocate(_data, _capacity);
+                _data = inline_data();
+                _capacity = N;
+                take(other);
+            }
+            return *this;
+        }
+
+        small_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        ACUL_FORCEINLINE reference operator[](size_type index) noexcept { return _data[index]; }
+
+        ACUL_FORCEINLINE const_reference operator[](size_type index) const noexcept { return _data[index]; }
+
+        template <size_t M, typename A>
+        bool operator==(const small_vector<T, M, A> &other) const
+        {
+            if (_size != other.size()) return false;
+            for (size_type i = 0; i < _size; ++i)
+                if (_data[i] != other[i]) return false;
+            return true;
+        }
+
+        ACUL_FORCEINLINE reference at(size_type index)
+        {
+            if (index >= _size) throw out_of_range(_size, index);
+            return _data[index];
+        }
+
+        ACUL_FORCEINLINE const_reference at(size_type index) const
+        {
+            if (index >= _size) throw out_of_range(_size, index);
+            return _data[index];
+        }
+
+        ACUL_FORCEINLINE reference front() noexcept { return *_data; }
+
+        ACUL_FORCEINLINE const_reference front() const noexcept { return *_data; }
+
+        ACUL_FORCEINLINE reference back() noexcept { return _data[_size - 1]; }
+
+        ACUL_FORCEINLINE const_reference back() const noexcept { return _data[_size - 1]; }
+
+        ACUL_FORCEINLINE iterator begin() noexcept { return iterator(_data); }
+
+        ACUL_FORCEINLINE const_iterator begin() const noexcept { return const_iterator(_data); }
+
+        ACUL_FORCEINLINE const_iterator cbegin() const noexcept { return const_iterator(_data); }
+
+        ACUL_FORCEINLINE iterator end() noexcept { return iterator(_data + _size); }
+
+        ACUL_FORCEINLINE const_iterator end() const noexcept { return const_iterator(_data + _size); }
+
+        ACUL_FORCEINLINE const_iterator cend() const noexcept { return const_iterator(_data + _size); }
+
+        ACUL_FORCEINLINE reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        ACUL_FORCEINLINE const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        ACUL_FORCEINLINE const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        ACUL_FORCEINLINE reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        ACUL_FORCEINLINE const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        ACUL_FORCEINLINE const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        ACUL_FORCEINLINE bool empty() const noexcept { return _size == 0; }
+
+        ACUL_FORCEINLINE size_type size() const noexcept { return _size; }
+
+        ACUL_FORCEINLINE size_type max_size() const noexcept { return Allocator::max_size(); }
+
+        ACUL_FORCEINLINE size_type capacity() const noexcept { return _capacity; }
+
+        /// Whether the elements are kept inside the object.
+        ACUL_FORCEINLINE bool is_inline() const noexcept { return _data == inline_data(); }
+
+        ACUL_FORCEINLINE const_pointer data() const noexcept { return _data; }
+        ACUL_FORCEINLINE pointer data() noexcept { return _data; }
+
+        void reserve(size_type new_capacity)
+        {
+            if (new_capacity > _capacity) grow_to(new_capacity);
+        }
+
+        /// Moves the elements back inline when they fit, otherwise trims the heap block to the size.
+        void shrink_to_fit()
+        {
+            if (is_inline() || _size == _capacity) return;
+            if (_size > N) return grow_to(_size);
+            pointer heap = _data;
+            relocate(heap, _size, inline_data());
+            _data = inline_data();
+            Allocator::deallocate(heap, _capacity);
+            _capacity = N;
+        }
+
+        void resize(size_type new_size)
+        {
+            if (new_size > _capacity) grow_to(std::max(_capacity * 2, new_size));
+            if (new_size > _size)
+            {
+                if constexpr (!std::is_trivially_constructible_v<value_type>)
+                    for (size_type i = _size; i < new_size; ++i) Allocator::construct(_data + i);
+            }
+            else
+                destroy_range(_data + new_size, _data + _size);
+            _size = new_size;
+        }
+
+        void resize(size_type new_size, const_reference value)
+        {
+            if (new_size <= _size) return resize(new_size);
+            insert(end(), new_size - _size, value);
+        }
+
+        void clear() noexcept
+        {
+            destroy_range(_data, _data + _size);
+            _size = 0;
+        }
+
+        ACUL_FORCEINLINE void push_back(const_reference value) { emplace_back(value); }
+
+        ACUL_FORCEINLINE void push_back(T &&value) { emplace_back(std::move(value)); }
+
+        template <typename... Args>
+        ACUL_FORCEINLINE reference emplace_back(Args &&...args)
+        {
+            if (_size == _capacity) grow_to(get_growth_size(_capacity, _capacity + 1));
+            if constexpr (!std::is_trivially_constructible_v<value_type> || has_args<Args...>())
+                Allocator::construct(_data + _size, std::forward<Args>(args)...);
+            return _data[_size++];
+        }
+
+        ACUL_FORCEINLINE void pop_back() noexcept
+        {
+            if (_size == 0) return;
+            --_size;
+            if constexpr (!std::is_trivially_destructible_v<value_type>) Allocator::destroy(_data + _size);
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            const size_type index = first - cbegin();
+            const size_type count = last - first;
+            if (count == 0 || index + count > _size) return begin() + index;
+            if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                destroy_range(_data + index, _data + index + count);
+                memmove((void *)(_data + index), (const void *)(_data + index + count),
+                        (_size - index - count) * sizeof(value_type));
+            }
+            else
+            {
+                std::move(_data + index + count, _data + _size, _data + index);
+                destroy_range(_data + _size - count, _data + _size);
+            }
+            _size -= count;
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+
+        iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+        iterator insert(const_iterator pos, size_type count, const_reference value)
+        {
+            const size_type index = open_gap(pos, count);
+            for (size_type i = 0; i < count; ++i) Allocator::construct(_data + index + i, value);
+            _size += count;
+            return begin() + index;
+        }
+
+        template <typename InputIt, std::enable_if_t<is_input_iterator_based<InputIt>::value, int> = 0>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            const size_type count = std::distance(first, last);
+            const size_type index = open_gap(pos, count);
+            for (pointer dst = _data + index; first != last; ++first, ++dst) Allocator::construct(dst, *first);
+            _size += count;
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+        {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            const size_type index = open_gap(pos, 1);
+            Allocator::construct(_data + index, std::forward<Args>(args)...);
+            ++_size;
+            return begin() + index;
+        }
+
+        template <typename InputIt, std::enable_if_t<is_input_iterator_based<InputIt>::value, int> = 0>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            if constexpr (is_forward_iterator_based<InputIt>::value) reserve(std::distance(first, last));
+            for (; first != last; ++first) emplace_back(*first);
+        }
+
+        void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+        void assign(size_type count, const_reference value)
+        {
+            clear();
+            insert(end(), count, value);
+        }
+
+        void swap(small_vector &other) noexcept
+        {
+            if (!is_inline() && !other.is_inline())
+            {
+                std::swap(_data, other._data);
+                std::swap(_size, other._size);
+                std::swap(_capacity, other._capacity);
+                return;
+            }
+            small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        pointer _data;
+        size_type _size;
+        size_type _capacity;
+        alignas(T) std::byte _inline[N * sizeof(T)];
+
+        ACUL_FORCEINLINE pointer inline_data() noexcept { return reinterpret_cast<pointer>(_inline); }
+
+        ACUL_FORCEINLINE const_pointer inline_data() const noexcept
+        {
+            return reinterpret_cast<const_pointer>(_inline);
+        }
+
+        static void destroy_range(pointer first, pointer last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+                for (; first != last; ++first) Allocator::destroy(first);
+        }
+
+        static void construct_copies(const_pointer first, const_pointer last, pointer dst)
+        {
+            if constexpr (std::is_trivially_copyable_v<value_type>)
+            {
+                if (first != last) memcpy(dst, first, (last - first) * sizeof(value_type));
+            }
+            else
+                for (; first != last; ++first, ++dst) Allocator::construct(dst, *first);
+        }
+
+        void grow_to(size_type new_capacity)
+        {
+            pointer new_data;
+            if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                // A spilled block of relocatable elements can be resized in place by the allocator
+                if (!is_inline())
+                {
+                    new_data = Allocator::reallocate(_data, new_capacity);
+                    if (!new_data) throw bad_alloc(new_capacity);
+                    _data = new_data;
+                    _capacity = new_capacity;
+                    return;
+                }
+            }
+            new_data = Allocator::allocate(new_capacity);
+            if (!new_data) throw bad_alloc(new_capacity);
+            relocate(_data, _size, new_data);
+            if (!is_inline()) Allocator::deallocate(_data, _capacity);
+            _data = new_data;
+            _capacity = new_capacity;
+        }
+
+        /// Shifts the elements from `pos` by `count` slots and returns the index of the uninitialized gap.
+        /// The size is left for the caller to update once the gap is filled.
+        size_type open_gap(const_iterator pos, size_type count)
+        {
+            const size_type index = pos - cbegin();
+            if (_size + count > _capacity) grow_to(get_growth_size(_capacity, _size + count));
+            if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                if (_size > index)
+                    memmove((void *)(_data + index + count), (const void *)(_data + index),
+                            (_size - index) * sizeof(value_type));
+            }
+            else
+                for (size_type i = _size; i-- > index;)
+                {
+                    Allocator::construct(_data + i + count, std::move(_data[i]));
+                    Allocator::destroy(_data + i);
+                }
+            return index;
+        }
+
+        /// Takes the elements of `other`, which is left empty. This container must be empty and inline.
+        void take(small_vector &other) noexcept
+        {
+            if (other.is_inline())
+            {
+                relocate(other._data, other._size, _data);
+                _size = other._size;
+            }
+            else
+            {
+                _data = other._data;
+                _size = other._size;
+                _capacity = other._capacity;
+                other._data = other.inline_data();
+                other._capacity = N;
+            }
+            other._size = 0;
+        }
+    };
+} // namespace acul
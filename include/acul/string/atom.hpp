@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include "../api.hpp"
+#include "string_view.hpp"
+
+namespace acul
+{
+    class atom_table;
+
+    namespace detail
+    {
+        /// Value of atom_rep::count for entries that are never released.
+        constexpr size_t atom_permanent = SIZE_MAX;
+
+        /// Set in the ids of refcounted entries so handles can tell without touching the entry.
+        constexpr u32 atom_counted = 0x80000000u;
+
+        /**
+         * @brief Header in front of the characters of an interned string.
+         *
+         * Same leading fields as the Rep of refstring, with the precomputed hash and the id after the length.
+         * The characters are null-terminated.
+         */
+        struct atom_rep
+        {
+            std::atomic<size_t> count;
+            size_t len;
+            size_t hash;
+            u32 id;
+            atom_table *table;
+            char data[];
+        };
+
+        /// Drops a reference of a refcounted entry, removing it from its table with the last one.
+        APPLIB_API void release_atom(atom_rep *rep) noexcept;
+    } // namespace detail
+
+    /**
+     * @brief Handle of a string interned in an atom_table.
+     *
+     * Equal strings of one table share a single entry, so atoms compare by pointer and hash with the value
+     * computed at interning, the same as std::hash of the string. Atoms of different tables never compare
+     * equal. A default-constructed atom is null and views an empty string.
+     */
+    class atom
+    {
+    public:
+        atom() noexcept : _data(nullptr), _id(0) {}
+
+        atom(const atom &other) noexcept : _data(other._data), _id(other._id) { acquire(); }
+
+        atom(atom &&other) noexcept : _data(other._data), _id(other._id)
+        {
+            other._data = nullptr;
+            other._id = 0;
+        }
+
+        atom &operator=(const atom &other) noexcept
+        {
+            if (this != &other)
+            {
+                other.acquire();
+                release();
+                _data = other._data;
+                _id = other._id;
+            }
+            return *this;
+        }
+
+        atom &operator=(atom &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                _data = other._data;
+                _id = other._id;
+                other._data = nullptr;
+                other._id = 0;
+            }
+            return *this;
+        }
+
+        ~atom() noexcept { release(); }
+
+        /// Id unique within the table, 0 for the null atom.
+        u32 id() const noexcept { return _id & ~detail::atom_counted; }
+
+        const char *c_str() const noexcept { return _data ? _data : ""; }
+
+        const char *data() const noexcept { return c_str(); }
+
+        size_t size() const noexcept { return _data ? rep()->len : 0; }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        size_t hash() const noexcept { return _data ? rep()->hash : std::hash<string_view>()(string_view()); }
+
+        string_view view() const noexcept { return {c_str(), size()}; }
+
+        operator string_view() const noexcept { return view(); }
+
+        explicit operator bool() const noexcept { return _data != nullptr; }
+
+        bool operator==(const atom &other) const noexcept { return _data == other._data; }
+        bool operator!=(const atom &other) const noexcept { return _data != other._data; }
+
+        /// Orders by id, not by the characters.
+        bool operator<(const atom &other) const noexcept { return _id < other._id; }
+
+    private:
+        const char *_data;
+        u32 _id;
+
+        friend class atom_table;
+
+        explicit atom(detail::atom_rep *rep) noexcept : _data(rep->data), _id(rep->id) {}
+
+        detail::atom_rep *rep() const noexcept
+        {
+            return reinterpret_cast<detail::atom_rep *>(const_cast<char *>(_data) - offsetof(detail::atom_rep, data));
+        }
+
+        bool counted() const noexcept { return _id & detail::atom_counted; }
+
+        void acquire() const noexcept
+        {
+            if (counted()) rep()->count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept
+        {
+            if (counted()) detail::release_atom(rep());
+        }
+    };
+
+    /**
+     * @brief Thread-safe string interner.
+     *
+     * Entries are spread over shards by hash. Each shard has an open-addressing table of entry pointers
+     * and a mutex taken only to insert, so find() and the lookup in intern() do not lock for strings that
+     * are already interned.
+     *
+     * By default entries live in append-only per-shard arenas until the table is destroyed. A refcounted
+     * table allocates every entry separately and removes it when its last atom is released; lookups then
+     * run under the shard mutex, since an entry may be freed concurrently. Atoms must not outlive their
+     * table.
+     */
+    class APPLIB_API atom_table
+    {
+    public:
+        explicit atom_table(bool refcounted = false);
+
+        atom_table(const atom_table &) = delete;
+        atom_table &operator=(const atom_table &) = delete;
+
+        ~atom_table();
+
+        /// Returns the atom of the string, adding it first if needed.
+        atom intern(string_view str);
+
+        /// Atom of an interned string, or a null atom.
+        atom find(string_view str) const;
+
+        /// Number of interned strings.
+        size_t size() const noexcept;
+
+        bool refcounted() const noexcept { return _refcounted; }
+
+        /// Process-wide table without release. Never destroyed, so its atoms stay valid at exit.
+        static atom_table &global();
+
+    private:
+        struct shard;
+
+        shard *_shards;
+        bool _refcounted;
+
+        friend void detail::release_atom(detail::atom_rep *rep) noexcept;
+
+        void erase(detail::atom_rep *rep) noexcept;
+    };
+
+    /// Interns the string in atom_table::global().
+    inline atom intern(string_view str) { return atom_table::global().intern(str); }
+} // namespace acul
+
+namespace std
+{
+    template <>
+    struct hash<acul::atom>
+    {
+        size_t operator()(const acul::atom &a) const noexcept { return a.hash(); }
+    };
+} // namespace std
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
 #include "../../bit.hpp"
 
 #define ACUL_CITYHASH_K0 0xc3a5c85c97cb3127ULL
@@ -8,7 +10,37 @@
 
 namespace acul::detail
 {
-    inline u64 cityhash128_64(const u128 &x)
+    // Loads and byte swap of the hash. Constant evaluation assembles the words byte by byte, which gives the
+    // same little-endian values as the unaligned loads used at run time.
+    ACUL_FORCEINLINE constexpr u64 cityhash_fetch64(const char *s) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            u64 v = 0;
+            for (int i = 7; i >= 0; --i) v = (v << 8) | static_cast<u8>(s[i]);
+            return v;
+        }
+        return load_u64u_le(s);
+    }
+
+    ACUL_FORCEINLINE constexpr u32 cityhash_fetch32(const char *s) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            u32 v = 0;
+            for (int i = 3; i >= 0; --i) v = (v << 8) | static_cast<u8>(s[i]);
+            return v;
+        }
+        return load_u32u_le(s);
+    }
+
+    ACUL_FORCEINLINE constexpr u64 cityhash_bswap64(u64 v) noexcept
+    {
+        if (std::is_constant_evaluated()) return __builtin_bswap64(v);
+        return ACUL_BSWAP_64(v);
+    }
+
+    constexpr u64 cityhash128_64(const u128 &x)
     {
         // Murmur-inspired hashing.
         const u64 kMul = 0x9ddfea08eb382d69ULL;
@@ -20,9 +52,9 @@ namespace acul::detail
         return b;
     }
 
-    ACUL_FORCEINLINE u64 cityhash16(u64 u, u64 v) { return cityhash128_64(u128{u, v}); }
+    ACUL_FORCEINLINE constexpr u64 cityhash16(u64 u, u64 v) { return cityhash128_64(u128{u, v}); }
 
-    inline u64 cityhash16_mul(u64 u, u64 v, u64 mul)
+    constexpr u64 cityhash16_mul(u64 u, u64 v, u64 mul)
     {
         // Murmur-inspired hashing.
         u64 a = (u ^ v) * mul;
@@ -36,13 +68,13 @@ namespace acul::detail
     // Based by Google CityHash
     // @ref https://github.com/google/cityhash
     // Processed 0 .. 16 bytes. For other cases we use cityhash64_long
-    inline u64 cityhash64_short(const char *s, size_t len)
+    constexpr u64 cityhash64_short(const char *s, size_t len)
     {
         if (len >= 8)
         {
             u64 mul = ACUL_CITYHASH_K2 + len * 2;
-            u64 a = load_u64u_le(s) + ACUL_CITYHASH_K2;
-            u64 b = load_u64u_le(s + len - 8);
+            u64 a = cityhash_fetch64(s) + ACUL_CITYHASH_K2;
+            u64 b = cityhash_fetch64(s + len - 8);
             u64 c = ror64(b, 37) * mul + a;
             u64 d = (ror64(a, 25) + b) * mul;
             return cityhash16_mul(c, d, mul);
@@ -50,8 +82,8 @@ namespace acul::detail
         if (len >= 4)
         {
             u64 mul = ACUL_CITYHASH_K2 + len * 2;
-            u64 a = load_u32u_le(s);
-            return cityhash16_mul(len + (a << 3), load_u32u_le(s + len - 4), mul);
+            u64 a = cityhash_fetch32(s);
+            return cityhash16_mul(len + (a << 3), cityhash_fetch32(s + len - 4), mul);
         }
         if (len > 0)
         {
@@ -65,5 +97,103 @@ namespace acul::detail
         return ACUL_CITYHASH_K2;
     }
 
+    // This probably works well for 16-byte strings as well, but it may be overkill
+    // in that case.
+    constexpr u64 cityhash17_32(const char *s, size_t len)
+    {
+        u64 mul = ACUL_CITYHASH_K2 + len * 2;
+        u64 a = cityhash_fetch64(s) * ACUL_CITYHASH_K1;
+        u64 b = cityhash_fetch64(s + 8);
+        u64 c = cityhash_fetch64(s + len - 8) * mul;
+        u64 d = cityhash_fetch64(s + len - 16) * ACUL_CITYHASH_K2;
+        return cityhash16_mul(ror64(a + b, 43) + ror64(c, 30) + d, a + ror64(b + ACUL_CITYHASH_K2, 18) + c, mul);
+    }
+
+    // Return a 16-byte hash for 48 bytes.  Quick and dirty.
+    // Callers do best to use "random-looking" values for a and b.
+    constexpr u128 cityhash_weak32_with_seeds(u64 w, u64 x, u64 y, u64 z, u64 a, u64 b)
+    {
+        a += w;
+        b = ror64(b + a + z, 21);
+        u64 c = a;
+        a += x;
+        a += y;
+        b += ror64(a, 44);
+        return {a + z, b + c};
+    }
+
+    // Return a 16-byte hash for s[0] ... s[31], a, and b.  Quick and dirty.
+    constexpr u128 cityhash_weak32_with_seeds(const char *s, u64 a, u64 b)
+    {
+        return cityhash_weak32_with_seeds(cityhash_fetch64(s), cityhash_fetch64(s + 8), cityhash_fetch64(s + 16),
+                                          cityhash_fetch64(s + 24), a, b);
+    }
+
+    // Return an 8-byte hash for 33 to 64 bytes.
+    constexpr u64 cityhash33_64(const char *s, size_t len)
+    {
+        u64 mul = ACUL_CITYHASH_K2 + len * 2;
+        u64 a = cityhash_fetch64(s) * ACUL_CITYHASH_K2;
+        u64 b = cityhash_fetch64(s + 8);
+        u64 c = cityhash_fetch64(s + len - 24);
+        u64 d = cityhash_fetch64(s + len - 32);
+        u64 e = cityhash_fetch64(s + 16) * ACUL_CITYHASH_K2;
+        u64 f = cityhash_fetch64(s + 24) * 9;
+        u64 g = cityhash_fetch64(s + len - 8);
+        u64 h = cityhash_fetch64(s + len - 16) * mul;
+        u64 u = ror64(a + g, 43) + (ror64(b, 30) + c) * 9;
+        u64 v = ((a + g) ^ d) + f + 1;
+        u64 w = cityhash_bswap64((u + v) * mul) + h;
+        u64 x = ror64(e + f, 42) + c;
+        u64 y = (cityhash_bswap64((v + w) * mul) + g) * mul;
+        u64 z = e + f + c;
+        a = cityhash_bswap64((x + z) * mul + y) + b;
+        b = shift_mix((z + a) * mul + d + h) * mul;
+        return b + x;
+    }
+
+    // Processed 17+ bytes. Inline so constant evaluation can reach it, run-time callers go through the
+    // exported cityhash64_long instead.
+    constexpr u64 cityhash64_over16(const char *s, size_t len)
+    {
+        if (len <= 32) return cityhash17_32(s, len);
+        else if (len <= 64) return cityhash33_64(s, len);
+
+        // For strings over 64 bytes we hash the end first, and then as we
+        // loop we keep 56 bytes of state: v, w, x, y, and z.
+        u64 x = cityhash_fetch64(s + len - 40);
+        u64 y = cityhash_fetch64(s + len - 16) + cityhash_fetch64(s + len - 56);
+        u64 z = cityhash16(cityhash_fetch64(s + len - 48) + len, cityhash_fetch64(s + len - 24));
+        u128 v = cityhash_weak32_with_seeds(s + len - 64, len, z);
+        u128 w = cityhash_weak32_with_seeds(s + len - 32, y + ACUL_CITYHASH_K1, x);
+        x = x * ACUL_CITYHASH_K1 + cityhash_fetch64(s);
+
+        // Decrease len to the nearest multiple of 64, and operate on 64-byte chunks.
+        len = (len - 1) & ~static_cast<size_t>(63);
+        do
+        {
+            x = ror64(x + y + v.first + cityhash_fetch64(s + 8), 37) * ACUL_CITYHASH_K1;
+            y = ror64(y + v.second + cityhash_fetch64(s + 48), 42) * ACUL_CITYHASH_K1;
+            x ^= w.second;
+            y += v.first + cityhash_fetch64(s + 40);
+            z = ror64(z + w.first, 33) * ACUL_CITYHASH_K1;
+            v = cityhash_weak32_with_seeds(s, v.second * ACUL_CITYHASH_K1, x + w.first);
+            w = cityhash_weak32_with_seeds(s + 32, z + w.second, y + cityhash_fetch64(s + 16));
+            std::swap(z, x);
+            s += 64;
+            len -= 64;
+        } while (len != 0);
+        return cityhash16(cityhash16(v.first, w.first) + shift_mix(y) * ACUL_CITYHASH_K1 + z,
+                          cityhash16(v.second, w.second) + x);
+    }
+
     APPLIB_API u64 cityhash64_long(const char *s, size_t len);
-} // namespace acul::detail
\ No newline at end of file
+
+    /// Hash of `len` bytes as used by std::hash of the library strings, also in constant expressions.
+    constexpr u64 cityhash64(const char *s, size_t len)
+    {
+        if (len <= 16) return cityhash64_short(s, len);
+        if (std::is_constant_evaluated()) return cityhash64_over16(s, len);
+        return cityhash64_long(s, len);
+    }
+} // namespace acul::detail
@@ -1,24 +1,96 @@
 #pragma once
 
 #include "../../detail/isa/flags.hpp"
+#include "../../fwd/line_index.hpp"
 #include "../../fwd/string_view_pool.hpp"
 
+namespace acul
+{
+    class token_table;
+    struct multi_match;
+
+    template <typename T, typename Allocator>
+    class vector;
+} // namespace acul
+
 namespace acul::detail
 {
+    struct teddy_program;
+
+    namespace avx512
+    {
+        size_t find(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size);
+        size_t count(const char *data, size_t size, char ch);
+        size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size);
+        void to_lower(const char *src, size_t size, char *dst);
+        void to_upper(const char *src, size_t size, char *dst);
+    } // namespace avx512
+
     namespace avx2
     {
         void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst);
-    }
+        void tokenize(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                      token_table &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u32> &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u64> &dst);
+        size_t utf8_to_utf16_length(const char *data, size_t size);
+        size_t utf8_to_utf16(const char *data, size_t size, c16 *dst);
+        size_t utf16_to_utf8_length(const c16 *data, size_t size);
+        size_t utf16_to_utf8(const c16 *data, size_t size, char *dst);
+        size_t find(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size);
+        size_t count(const char *data, size_t size, char ch);
+        size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size);
+        void to_lower(const char *src, size_t size, char *dst);
+        void to_upper(const char *src, size_t size, char *dst);
+        void teddy_find(const teddy_program &program, const char *data, size_t size,
+                        vector<multi_match, mem_allocator<multi_match>> &dst);
+    } // namespace avx2
 
     namespace sse42
     {
         void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst);
-    }
+        void tokenize(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                      token_table &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u32> &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u64> &dst);
+        size_t utf8_to_utf16_length(const char *data, size_t size);
+        size_t utf8_to_utf16(const char *data, size_t size, c16 *dst);
+        size_t utf16_to_utf8_length(const c16 *data, size_t size);
+        size_t utf16_to_utf8(const c16 *data, size_t size, char *dst);
+        size_t find(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size);
+        size_t count(const char *data, size_t size, char ch);
+        size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size);
+        void to_lower(const char *src, size_t size, char *dst);
+        void to_upper(const char *src, size_t size, char *dst);
+        void teddy_find(const teddy_program &program, const char *data, size_t size,
+                        vector<multi_match, mem_allocator<multi_match>> &dst);
+    } // namespace sse42
 
     namespace scalar
     {
         void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst);
-    }
+        void tokenize(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                      token_table &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u32> &dst);
+        void fill_line_index(const char *data, size_t size, line_index<u64> &dst);
+        size_t utf8_to_utf16_length(const char *data, size_t size);
+        size_t utf8_to_utf16(const char *data, size_t size, c16 *dst);
+        size_t utf16_to_utf8_length(const c16 *data, size_t size);
+        size_t utf16_to_utf8(const c16 *data, size_t size, char *dst);
+        size_t find(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size);
+        size_t count(const char *data, size_t size, char ch);
+        size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size);
+        void to_lower(const char *src, size_t size, char *dst);
+        void to_upper(const char *src, size_t size, char *dst);
+    } // namespace scalar
 
     using PFN_fill_line_buffer = void (*)(const char *data, size_t size, string_view_pool<char> &dst);
 
@@ -28,4 +100,95 @@ namespace acul::detail
         else if (flags & isa_flag_bits::sse42) return &sse42::fill_line_buffer;
         return &scalar::fill_line_buffer;
     }
+
+    using PFN_tokenize = void (*)(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                                  token_table &dst);
+
+    inline PFN_tokenize load_tokenize_fn(isa_flags flags)
+    {
+        if (flags & isa_flag_bits::avx2) return &avx2::tokenize;
+        else if (flags & isa_flag_bits::sse42) return &sse42::tokenize;
+        return &scalar::tokenize;
+    }
+
+    /// Line splitting into offset indexes, one kernel per offset width.
+    struct line_index_kernels
+    {
+        void (*fill32)(const char *data, size_t size, line_index<u32> &dst);
+        void (*fill64)(const char *data, size_t size, line_index<u64> &dst);
+    };
+
+    inline line_index_kernels load_line_index_kernels(isa_flags flags)
+    {
+        if (flags & isa_flag_bits::avx2) return {&avx2::fill_line_index, &avx2::fill_line_index};
+        else if (flags & isa_flag_bits::sse42) return {&sse42::fill_line_index, &sse42::fill_line_index};
+        return {&scalar::fill_line_index, &scalar::fill_line_index};
+    }
+
+    /**
+     * @brief UTF transcoding kernels.
+     *
+     * The length functions validate and return the output size in code units, or SIZE_MAX for ill-formed
+     * input. The converters expect input that passed validation and return the number of units written.
+     */
+    struct utf_kernels
+    {
+        size_t (*utf8_to_utf16_length)(const char *data, size_t size);
+        size_t (*utf8_to_utf16)(const char *data, size_t size, c16 *dst);
+        size_t (*utf16_to_utf8_length)(const c16 *data, size_t size);
+        size_t (*utf16_to_utf8)(const c16 *data, size_t size, char *dst);
+    };
+
+    inline utf_kernels load_utf_kernels(isa_flags flags)
+    {
+        if (flags & isa_flag_bits::avx2)
+            return {&avx2::utf8_to_utf16_length, &avx2::utf8_to_utf16, &avx2::utf16_to_utf8_length,
+                    &avx2::utf16_to_utf8};
+        else if (flags & isa_flag_bits::sse42)
+            return {&sse42::utf8_to_utf16_length, &sse42::utf8_to_utf16, &sse42::utf16_to_utf8_length,
+                    &sse42::utf16_to_utf8};
+        return {&scalar::utf8_to_utf16_length, &scalar::utf8_to_utf16, &scalar::utf16_to_utf8_length,
+                &scalar::utf16_to_utf8};
+    }
+
+    /**
+     * @brief Byte search kernels.
+     *
+     * Positions are relative to `data`, SIZE_MAX when nothing matches. An empty needle matches at 0 for
+     * find and at `size` for rfind. Case folding covers ASCII letters only.
+     */
+    struct search_kernels
+    {
+        size_t (*find)(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t (*rfind)(const char *data, size_t size, const char *needle, size_t needle_size);
+        size_t (*find_first_of)(const char *data, size_t size, const char *set, size_t set_size);
+        size_t (*count)(const char *data, size_t size, char ch);
+        size_t (*find_icase)(const char *data, size_t size, const char *needle, size_t needle_size);
+        void (*to_lower)(const char *src, size_t size, char *dst);
+        void (*to_upper)(const char *src, size_t size, char *dst);
+    };
+
+#define ACUL_SEARCH_KERNELS(ns) \
+    {&ns::find, &ns::rfind, &ns::find_first_of, &ns::count, &ns::find_icase, &ns::to_lower, &ns::to_upper}
+
+    inline search_kernels load_search_kernels(isa_flags flags)
+    {
+        if (flags & isa_flag_bits::avx512bw) return ACUL_SEARCH_KERNELS(avx512);
+        else if (flags & isa_flag_bits::avx2) return ACUL_SEARCH_KERNELS(avx2);
+        else if (flags & isa_flag_bits::sse42) return ACUL_SEARCH_KERNELS(sse42);
+        return ACUL_SEARCH_KERNELS(scalar);
+    }
+
+#undef ACUL_SEARCH_KERNELS
+
+    /// Teddy prefilter of multi_matcher, appends verified matches. Null when the CPU has no SSE4.2.
+    using PFN_teddy_find = void (*)(const teddy_program &program, const char *data, size_t size,
+                                    vector<multi_match, mem_allocator<multi_match>> &dst);
+
+    inline PFN_teddy_find load_teddy_find_fn(isa_flags flags)
+    {
+        if (flags & isa_flag_bits::avx2) return &avx2::teddy_find;
+        else if (flags & isa_flag_bits::sse42) return &sse42::teddy_find;
+        return nullptr;
+    }
 } // namespace acul::detail
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "../exception/exception.hpp"
+#include "sstream.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+
+/**
+ * @brief Type-safe `{}` formatting.
+ *
+ * Format strings are parsed when the call is compiled: a placeholder without a matching argument,
+ * an unused argument or a specifier that does not apply to the argument type is a compile error.
+ * Output is appended straight into the destination string after a single reserve.
+ *
+ * Replacement field: `{[:[[fill]align][#][0][width][.precision][type]]}`, `{{` and `}}` for braces.
+ * - align: `<` left, `>` right, `^` center
+ * - integers: `d` decimal (default), `x`/`X` hex, `o` octal, `b` binary, `c` character
+ * - floats: `f` fixed and `e` scientific with the given precision (default 6), `g` general;
+ *   no type gives the shortest form that reads back as the same value, or general with a precision
+ * - strings and booleans: `s`, pointers: `p`
+ */
+namespace acul::fmt
+{
+    namespace detail
+    {
+        enum class arg_type : u8
+        {
+            none,
+            signed_int,
+            unsigned_int,
+            boolean,
+            character,
+            f32,
+            f64,
+            string,
+            pointer
+        };
+
+        struct spec
+        {
+            char fill = ' ';
+            char align = 0;
+            bool alt = false;
+            bool zero = false;
+            u16 width = 0;
+            i16 precision = -1;
+            char type = 0;
+        };
+
+        struct arg
+        {
+            arg_type type;
+            union
+            {
+                i64 i;
+                u64 u;
+                f32 f;
+                f64 d;
+                bool b;
+                char c;
+                const void *p;
+                struct
+                {
+                    const char *data;
+                    size_t size;
+                } s;
+            };
+        };
+
+        template <typename T>
+        constexpr arg_type type_of()
+        {
+            using U = std::remove_cv_t<std::remove_reference_t<T>>;
+            if constexpr (std::is_same_v<U, bool>) return arg_type::boolean;
+            else if constexpr (std::is_same_v<U, char>) return arg_type::character;
+            else if constexpr (std::is_integral_v<U>)
+                return std::is_signed_v<U> ? arg_type::signed_int : arg_type::unsigned_int;
+            else if constexpr (std::is_same_v<U, f32>) return arg_type::f32;
+            else if constexpr (std::is_floating_point_v<U>) return arg_type::f64;
+            else if constexpr (std::is_enum_v<U>) return type_of<std::underlying_type_t<U>>();
+            else if constexpr (std::is_convertible_v<const U &, const char *> || is_string_like_v<char, U>)
+                return arg_type::string;
+            else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) return arg_type::pointer;
+            else return arg_type::none;
+        }
+
+        template <typename T>
+        inline arg make_arg(const T &value)
+        {
+            constexpr arg_type type = type_of<T>();
+            static_assert(type != arg_type::none, "Type is not formattable");
+            arg a;
+            a.type = type;
+            if constexpr (type == arg_type::boolean) a.b = value;
+            else if constexpr (type == arg_type::character) a.c = value;
+            else if constexpr (type == arg_type::signed_int) a.i = static_cast<i64>(value);
+            else if constexpr (type == arg_type::unsigned_int) a.u = static_cast<u64>(value);
+            else if constexpr (type == arg_type::f32) a.f = value;
+            else if constexpr (type == arg_type::f64) a.d = static_cast<f64>(value);
+            else if constexpr (type == arg_type::string)
+            {
+                if constexpr (std::is_convertible_v<const T &, const char *>)
+                {
+                    const char *str = value;
+                    a.s = {str, str ? null_terminated_length(str) : 0};
+                }
+                else a.s = {value.data(), static_cast<size_t>(value.size())};
+            }
+            else a.p = static_cast<const void *>(value);
+            return a;
+        }
+
+        /// Not constexpr on purpose: reaching it during constant evaluation turns the message into a compile error.
+        inline void format_error(const char *message) { throw runtime_error(message); }
+
+        /**
+         * @brief Parses a replacement field starting right after `{`.
+         * @return Pointer past the closing `}`, or nullptr with the error message set.
+         */
+        constexpr const char *parse_spec(const char *p, const char *end, spec &spec, const char *&error)
+        {
+            if (p == end) return error = "Unterminated replacement field", nullptr;
+            if (*p == '}') return p + 1;
+            if (*p != ':') return error = "Positional and named arguments are not supported", nullptr;
+            ++p;
+
+            auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+            if (p + 1 < end && *p != '}' && is_align(p[1]))
+            {
+                spec.fill = p[0];
+                spec.align = p[1];
+                p += 2;
+            }
+            else if (p < end && is_align(*p)) spec.align = *p++;
+
+            if (p < end && *p == '#')
+            {
+                spec.alt = true;
+                ++p;
+            }
+            if (p < end && *p == '0')
+            {
+                spec.zero = true;
+                ++p;
+            }
+            u32 width = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+                if ((width = width * 10 + (*p - '0')) > UINT16_MAX) return error = "Width is too large", nullptr;
+            spec.width = static_cast<u16>(width);
+
+            if (p < end && *p == '.')
+            {
+                ++p;
+                if (p == end || *p < '0' || *p > '9') return error = "Missing precision", nullptr;
+                u32 precision = 0;
+                for (; p < end && *p >= '0' && *p <= '9'; ++p)
+                    if ((precision = precision * 10 + (*p - '0')) > 767) return error = "Precision is too large", nullptr;
+                spec.precision = static_cast<i16>(precision);
+            }
+
+            if (p < end && *p != '}') spec.type = *p++;
+            if (p == end || *p != '}') return error = "Invalid format specifier", nullptr;
+            return p + 1;
+        }
+
+        constexpr const char *check_spec(const spec &spec, arg_type type)
+        {
+            const char t = spec.type;
+            switch (type)
+            {
+                case arg_type::signed_int:
+                case arg_type::unsigned_int:
+                    if (t && t != 'd' && t != 'x' && t != 'X' && t != 'o' && t != 'b' && t != 'c')
+                        return "Invalid type for an integer argument";
+                    if (spec.precision >= 0) return "Precision is not allowed for integers";
+                    return nullptr;
+                case arg_type::f32:
+                case arg_type::f64:
+                    if (t && t != 'f' && t != 'e' && t != 'g') return "Invalid type for a floating-point argument";
+                    if (spec.alt) return "Alternate form is not allowed for floating-point arguments";
+                    return nullptr;
+                case arg_type::character:
+                    if (t && t != 'c' && t != 'd' && t != 'x' && t != 'X') return "Invalid type for a character argument";
+                    break;
+                case arg_type::boolean:
+                    if (t && t != 's') return "Invalid type for a boolean argument";
+                    break;
+                case arg_type::string:
+                    if (t && t != 's') return "Invalid type for a string argument";
+                    if (spec.zero) return "Zero padding is not allowed for strings";
+                    return nullptr;
+                case arg_type::pointer:
+                    if (t && t != 'p') return "Invalid type for a pointer argument";
+                    break;
+                default:
+                    return "Type is not formattable";
+            }
+            if (spec.precision >= 0) return "Precision is not allowed for this argument";
+            return nullptr;
+        }
+
+        template <typename... Args>
+        constexpr void check_format(const char *p, const char *end)
+        {
+            constexpr arg_type types[sizeof...(Args) + 1] = {type_of<Args>()..., arg_type::none};
+            constexpr size_t count = sizeof...(Args);
+            size_t index = 0;
+            const char *error = nullptr;
+            while (p < end)
+            {
+                if (*p == '{')
+                {
+                    if (p + 1 < end && p[1] == '{')
+                    {
+                        p += 2;
+                        continue;
+                    }
+                    spec spec;
+                    p = parse_spec(p + 1, end, spec, error);
+                    if (!p) return format_error(error);
+                    if (index >= count) return format_error("Not enough arguments for the format string");
+                    if ((error = check_spec(spec, types[index]))) return format_error(error);
+                    ++index;
+                }
+                else if (*p == '}')
+                {
+                    if (p + 1 == end || p[1] != '}') return format_error("Unmatched '}' in the format string");
+                    p += 2;
+                }
+                else ++p;
+            }
+            if (index != count) format_error("Too many arguments for the format string");
+        }
+
+        template <typename T>
+        struct type_identity
+        {
+            using type = T;
+        };
+
+        APPLIB_API void vformat_to(string &dst, string_view format, const arg *args);
+    } // namespace detail
+
+    /// Format string validated against the argument types at compile time.
+    template <typename... Args>
+    class basic_format_string
+    {
+    public:
+        template <typename S, std::enable_if_t<std::is_convertible_v<const S &, string_view>, int> = 0>
+        ACUL_CONSTEVAL basic_format_string(const S &format) : _str(format)
+        {
+            detail::check_format<Args...>(_str.data(), _str.data() + _str.size());
+        }
+
+        constexpr string_view get() const noexcept { return _str; }
+
+    private:
+        string_view _str;
+    };
+
+    template <typename... Args>
+    using format_string = basic_format_string<typename detail::type_identity<Args>::type...>;
+
+    /// Appends the formatted output to the string.
+    template <typename... Args>
+    inline string &format_to(string &dst, format_string<Args...> format, const Args &...args)
+    {
+        const detail::arg list[sizeof...(Args) + 1] = {detail::make_arg(args)..., {}};
+        detail::vformat_to(dst, format.get(), list);
+        return dst;
+    }
+
+    /// Appends the formatted output to the stream buffer.
+    template <typename... Args>
+    inline stringstream &format_to(stringstream &dst, format_string<Args...> format, const Args &...args)
+    {
+        const detail::arg list[sizeof...(Args) + 1] = {detail::make_arg(args)..., {}};
+        detail::vformat_to(dst.buffer(), format.get(), list);
+        return dst;
+    }
+
+    template <typename... Args>
+    inline string format(format_string<Args...> format, const Args &...args)
+    {
+        string result;
+        const detail::arg list[sizeof...(Args) + 1] = {detail::make_arg(args)..., {}};
+        detail::vformat_to(result, format.get(), list);
+        return result;
+    }
+} // namespace acul::fmt
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../api.hpp"
+#include "detail/string_hash.hpp"
+#include "string_view.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Hash of the characters, equal to std::hash of a string or string_view holding them.
+     *
+     * Usable in constant expressions, so keys of hash maps and tables indexed by hash can be computed at
+     * compile time. The run-time path is the one std::hash takes.
+     */
+    constexpr u64 hash_string(const char *str, size_t len) noexcept { return detail::cityhash64(str, len); }
+
+    constexpr u64 hash_string(string_view str) noexcept { return detail::cityhash64(str.data(), str.size()); }
+
+    namespace literals
+    {
+        /**
+         * @brief Compile-time hash of a string literal, see hash_string().
+         *
+         * Allows a switch over strings with hashes as case labels:
+         * @code
+         * switch (hash_string(name))
+         * {
+         *     case "info"_hash: ...
+         *     case "warn"_hash: ...
+         * }
+         * @endcode
+         * Distinct strings may share a hash, so a case that must reject unknown input still compares the string.
+         */
+        ACUL_CONSTEVAL u64 operator""_hash(const char *str, size_t len) noexcept { return hash_string(str, len); }
+    } // namespace literals
+} // namespace acul
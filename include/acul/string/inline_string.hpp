@@ -0,0 +1,234 @@
+#pragma once
+
+#include "../exception/exception.hpp"
+#include "../fwd/sstream.hpp"
+#include "../type_traits.hpp"
+#include "detail/string_hash.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+
+namespace acul
+{
+    /**
+     * @brief String stored in place with a fixed capacity of `N` characters.
+     *
+     * Holds the characters, a null terminator and the length in one trivially copyable object, so
+     * containers can move it with memcpy and a hash table keeps it inside its slots. Meant for bounded
+     * keys and identifiers that do not fit the small-string buffer of basic_string. Operations that would
+     * exceed the capacity throw out_of_range.
+     */
+    template <typename T, size_t N>
+    class basic_inline_string
+    {
+        static_assert(is_char_v<T>, "basic_inline_string requires a string character type");
+        static_assert(N > 0 && N <= UINT32_MAX, "basic_inline_string capacity is out of range");
+
+        using length_type =
+            std::conditional_t<(N <= UINT8_MAX), u8, std::conditional_t<(N <= UINT16_MAX), u16, u32>>;
+
+    public:
+        using size_type = size_t;
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using self_view = basic_string_view<T>;
+
+        static constexpr size_type npos = SIZE_MAX;
+
+        constexpr basic_inline_string() noexcept = default;
+
+        basic_inline_string(const_pointer str) { assign(str, null_terminated_length(str)); }
+
+        basic_inline_string(const_pointer str, size_type len) { assign(str, len); }
+
+        basic_inline_string(self_view str) { assign(str.data(), str.size()); }
+
+        template <typename Allocator>
+        basic_inline_string(const basic_string<T, Allocator> &str)
+        {
+            assign(str.data(), str.size());
+        }
+
+        basic_inline_string &operator=(self_view str)
+        {
+            assign(str.data(), str.size());
+            return *this;
+        }
+
+        basic_inline_string &operator=(const_pointer str)
+        {
+            assign(str, null_terminated_length(str));
+            return *this;
+        }
+
+        static constexpr size_type capacity() noexcept { return N; }
+        static constexpr size_type max_size() noexcept { return N; }
+
+        constexpr size_type size() const noexcept { return _size; }
+        constexpr size_type length() const noexcept { return _size; }
+        constexpr bool empty() const noexcept { return _size == 0; }
+
+        constexpr const_pointer c_str() const noexcept { return _data; }
+        constexpr const_pointer data() const noexcept { return _data; }
+        constexpr pointer data() noexcept { return _data; }
+
+        constexpr iterator begin() noexcept { return _data; }
+        constexpr const_iterator begin() const noexcept { return _data; }
+        constexpr const_iterator cbegin() const noexcept { return _data; }
+        constexpr iterator end() noexcept { return _data + _size; }
+        constexpr const_iterator end() const noexcept { return _data + _size; }
+        constexpr const_iterator cend() const noexcept { return _data + _size; }
+
+        constexpr reference operator[](size_type index) noexcept { return _data[index]; }
+        constexpr const_reference operator[](size_type index) const noexcept { return _data[index]; }
+
+        reference at(size_type index)
+        {
+            if (index >= _size) throw out_of_range(_size, index);
+            return _data[index];
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index >= _size) throw out_of_range(_size, index);
+            return _data[index];
+        }
+
+        constexpr reference front() noexcept { return _data[0]; }
+        constexpr const_reference front() const noexcept { return _data[0]; }
+        constexpr reference back() noexcept { return _data[_size - 1]; }
+        constexpr const_reference back() const noexcept { return _data[_size - 1]; }
+
+        operator self_view() const noexcept { return self_view(_data, _size); }
+
+        self_view view() const noexcept { return self_view(_data, _size); }
+
+        /// Copy as a heap-capable basic_string.
+        basic_string<T> str() const { return basic_string<T>(_data, _size); }
+
+        void clear() noexcept
+        {
+            _size = 0;
+            _data[0] = T();
+        }
+
+        void assign(const_pointer str, size_type len)
+        {
+            if (len > N) throw out_of_range(N, len);
+            memmove(_data, str, len * sizeof(T));
+            set_size(len);
+        }
+
+        basic_inline_string &append(const_pointer str, size_type len)
+        {
+            if (len > N - _size) throw out_of_range(N, _size + len);
+            memcpy(_data + _size, str, len * sizeof(T));
+            set_size(_size + len);
+            return *this;
+        }
+
+        basic_inline_string &append(self_view str) { return append(str.data(), str.size()); }
+
+        basic_inline_string &operator+=(self_view str) { return append(str.data(), str.size()); }
+
+        basic_inline_string &operator+=(const_pointer str) { return append(str, null_terminated_length(str)); }
+
+        basic_inline_string &operator+=(value_type ch) { return append(&ch, 1); }
+
+        void push_back(value_type ch) { append(&ch, 1); }
+
+        void pop_back() noexcept { set_size(_size - 1); }
+
+        void resize(size_type new_size, value_type fill = value_type())
+        {
+            if (new_size > N) throw out_of_range(N, new_size);
+            for (size_type i = _size; i < new_size; ++i) _data[i] = fill;
+            set_size(new_size);
+        }
+
+        self_view substr(size_type pos, size_type len = npos) const noexcept { return view().substr(pos, len); }
+
+        size_type find(value_type ch, size_type pos = 0) const noexcept { return view().find(ch, pos); }
+
+        size_type find(self_view str, size_type pos = 0) const noexcept { return view().find(str, pos); }
+
+        size_type rfind(value_type ch, size_type pos = npos) const noexcept { return view().rfind(ch, pos); }
+
+        size_type rfind(self_view str, size_type pos = npos) const noexcept { return view().rfind(str, pos); }
+
+        int compare(self_view str) const noexcept
+        {
+            const size_type n = _size < str.size() ? _size : str.size();
+            if constexpr (sizeof(T) == 1)
+            {
+                if (const int r = memcmp(_data, str.data(), n)) return r;
+            }
+            else
+                // Wider code units are ordered by value, bytes would be compared in memory order
+                for (size_type i = 0; i < n; ++i)
+                    if (_data[i] != str.data()[i]) return _data[i] < str.data()[i] ? -1 : 1;
+            return _size < str.size() ? -1 : _size > str.size() ? 1 : 0;
+        }
+
+        bool operator==(const basic_inline_string &other) const noexcept
+        {
+            return _size == other._size && memcmp(_data, other._data, _size * sizeof(T)) == 0;
+        }
+
+        bool operator!=(const basic_inline_string &other) const noexcept { return !(*this == other); }
+
+        bool operator<(const basic_inline_string &other) const noexcept { return compare(other) < 0; }
+
+        bool operator==(self_view other) const noexcept
+        {
+            return _size == other.size() && memcmp(_data, other.data(), _size * sizeof(T)) == 0;
+        }
+
+        bool operator!=(self_view other) const noexcept { return !(*this == other); }
+
+        bool operator==(const_pointer other) const noexcept { return *this == self_view(other); }
+
+        bool operator!=(const_pointer other) const noexcept { return !(*this == self_view(other)); }
+
+    private:
+        T _data[N + 1] = {};
+        length_type _size = 0;
+
+        void set_size(size_type size) noexcept
+        {
+            _size = static_cast<length_type>(size);
+            _data[size] = T();
+        }
+    };
+
+    template <size_t N>
+    using inline_string = basic_inline_string<char, N>;
+
+    template <size_t N>
+    using inline_u16string = basic_inline_string<char16_t, N>;
+
+    template <typename T, typename Allocator, size_t N>
+    basic_stringstream<T, Allocator> &operator<<(basic_stringstream<T, Allocator> &ss,
+                                                 const basic_inline_string<T, N> &str)
+    {
+        return ss << str.view();
+    }
+} // namespace acul
+
+namespace std
+{
+    template <typename T, size_t N>
+    struct hash<acul::basic_inline_string<T, N>>
+    {
+        size_t operator()(const acul::basic_inline_string<T, N> &s) const noexcept
+        {
+            const char *bytes = reinterpret_cast<const char *>(s.data());
+            size_t len = s.size() * sizeof(T);
+            return acul::detail::cityhash64(bytes, len);
+        }
+    };
+} // namespace std
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <iterator>
+#include <limits>
+#include "../detail/isa/dispatch.hpp"
+#include "../exception/exception.hpp"
+#include "../fwd/line_index.hpp"
+#include "../vector.hpp"
+#include "string_view.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Compact line index over a text buffer.
+     *
+     * Stores one start offset per line instead of a full string_view, 4 or 8 bytes depending on `Offset`.
+     * Every line is followed by a one-byte terminator, or by two when a '\r' was stripped before it, which
+     * is kept in a side bitmap. The length of a line is therefore derived from the next offset, and lines
+     * come back as string_view on demand.
+     *
+     * Filled by fill_line_buffer with the same kernels and line rules as string_view_pool. The indexed
+     * buffer must outlive the index.
+     */
+    template <typename Offset>
+    class line_index
+    {
+        static_assert(std::is_same_v<Offset, u32> || std::is_same_v<Offset, u64>, "Offset must be u32 or u64");
+
+    public:
+        using value_type = string_view;
+        using size_type = size_t;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = string_view;
+            using difference_type = ptrdiff_t;
+            using pointer = void;
+            using reference = string_view;
+
+            const_iterator() = default;
+            const_iterator(const line_index *index, size_type pos) : _index(index), _pos(pos) {}
+
+            string_view operator*() const noexcept { return (*_index)[_pos]; }
+            string_view operator[](difference_type n) const noexcept { return (*_index)[_pos + n]; }
+
+            const_iterator &operator++() noexcept
+            {
+                ++_pos;
+                return *this;
+            }
+            const_iterator operator++(int) noexcept { return {_index, _pos++}; }
+            const_iterator &operator--() noexcept
+            {
+                --_pos;
+                return *this;
+            }
+            const_iterator operator--(int) noexcept { return {_index, _pos--}; }
+            const_iterator &operator+=(difference_type n) noexcept
+            {
+                _pos += n;
+                return *this;
+            }
+            const_iterator &operator-=(difference_type n) noexcept
+            {
+                _pos -= n;
+                return *this;
+            }
+            const_iterator operator+(difference_type n) const noexcept { return {_index, _pos + n}; }
+            const_iterator operator-(difference_type n) const noexcept { return {_index, _pos - n}; }
+            difference_type operator-(const const_iterator &other) const noexcept
+            {
+                return static_cast<difference_type>(_pos) - static_cast<difference_type>(other._pos);
+            }
+
+            bool operator==(const const_iterator &other) const noexcept { return _pos == other._pos; }
+            bool operator!=(const const_iterator &other) const noexcept { return _pos != other._pos; }
+            bool operator<(const const_iterator &other) const noexcept { return _pos < other._pos; }
+            bool operator>(const const_iterator &other) const noexcept { return _pos > other._pos; }
+            bool operator<=(const const_iterator &other) const noexcept { return _pos <= other._pos; }
+            bool operator>=(const const_iterator &other) const noexcept { return _pos >= other._pos; }
+
+            friend const_iterator operator+(difference_type n, const const_iterator &it) noexcept { return it + n; }
+
+        private:
+            const line_index *_index = nullptr;
+            size_type _pos = 0;
+        };
+
+        using iterator = const_iterator;
+
+        line_index() = default;
+
+        /// Number of lines.
+        size_type size() const noexcept { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+
+        bool empty() const noexcept { return _offsets.size() < 2; }
+
+        string_view operator[](size_type index) const noexcept
+        {
+            const size_t start = _offsets[index];
+            const size_t end = _offsets[index + 1] - 1 - has_cr(index);
+            return {_data + start, end - start};
+        }
+
+        string_view at(size_type index) const
+        {
+            if (index >= size()) throw out_of_range(size(), index);
+            return (*this)[index];
+        }
+
+        /// Start of the line relative to the indexed buffer.
+        Offset offset(size_type index) const noexcept { return _offsets[index]; }
+
+        /// True when the line ended with CRLF and the '\r' was stripped.
+        bool has_cr(size_type index) const noexcept { return (_cr[index >> 6] >> (index & 63)) & 1; }
+
+        const char *data() const noexcept { return _data; }
+
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, size()}; }
+
+        void reserve(size_type lines)
+        {
+            _offsets.reserve(lines + 1);
+            _cr.reserve((lines + 63) / 64);
+        }
+
+        void clear() noexcept
+        {
+            _offsets.clear();
+            _cr.clear();
+            _data = nullptr;
+            _tail = 0;
+        }
+
+        /// Bytes held by the index itself.
+        size_t memory_size() const noexcept
+        {
+            return _offsets.capacity() * sizeof(Offset) + _cr.capacity() * sizeof(u64);
+        }
+
+        /**
+         * @brief Indexes the lines of the buffer, replacing the previous contents.
+         * @throws out_of_range when the buffer is too large for the offset type.
+         */
+        void assign(const char *data, size_t size)
+        {
+            constexpr size_t max_size = std::numeric_limits<Offset>::max() - 1;
+            if (size > max_size) throw out_of_range(max_size, size);
+            clear();
+            _data = data;
+            if constexpr (sizeof(Offset) == sizeof(u32))
+                detail::g_isa_dispatcher.line_index.fill32(data, size, *this);
+            else detail::g_isa_dispatcher.line_index.fill64(data, size, *this);
+            // Sentinel that gives the last line an implicit one-byte terminator
+            if (!_offsets.empty()) _offsets.push_back(static_cast<Offset>(_tail + 1));
+        }
+
+        /// Sink for the split kernels: records a line of the buffer passed to assign().
+        void push(const char *str, size_t length)
+        {
+            const size_t start = static_cast<size_t>(str - _data);
+            const size_t count = _offsets.size();
+            if (count > 0 && start - _tail == 2) _cr[(count - 1) >> 6] |= u64(1) << ((count - 1) & 63);
+            if ((count & 63) == 0) _cr.push_back(0);
+            _offsets.push_back(static_cast<Offset>(start));
+            _tail = start + length;
+        }
+
+    private:
+        vector<Offset> _offsets;
+        vector<u64> _cr;
+        const char *_data = nullptr;
+        size_t _tail = 0;
+    };
+
+    /// Indexes the lines of the buffer, replacing the previous contents of `dst`.
+    template <typename Offset>
+    inline void fill_line_buffer(const char *data, size_t size, line_index<Offset> &dst)
+    {
+        dst.assign(data, size);
+    }
+} // namespace acul
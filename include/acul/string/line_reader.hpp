@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../vector.hpp"
+#include "string_view_pool.hpp"
+#include "utils.hpp"
+
+namespace acul
+{
+    /**
+     * @brief Splits a byte stream into lines chunk by chunk.
+     *
+     * Data is written into the buffer returned by prepare() and handed over with commit(). Every commit
+     * passes the lines completed so far to the callback as one batch, split by the same kernels as
+     * fill_line_buffer. Bytes after the last '\n' stay in the buffer until the next chunk completes them,
+     * so lines and CRLF pairs split across chunk boundaries come out whole and memory stays at about one
+     * chunk plus the longest line. finish() flushes the last line when it has no terminator.
+     *
+     * The views in a batch point into the internal buffer and are only valid during the callback.
+     */
+    class line_reader
+    {
+    public:
+        explicit line_reader(size_t chunk_size = 1 << 20) : _chunk_size(chunk_size ? chunk_size : 1) {}
+
+        /// Space for the next chunk: at least `chunk_size` writable bytes.
+        char *prepare()
+        {
+            if (_begin > 0)
+            {
+                // Move the partial line to the front so the buffer does not grow with the stream
+                const size_t tail = _end - _begin;
+                if (tail) memmove(_buffer.data(), _buffer.data() + _begin, tail);
+                _begin = 0;
+                _end = tail;
+            }
+            if (_buffer.size() < _end + _chunk_size) _buffer.resize(_end + _chunk_size);
+            return _buffer.data() + _end;
+        }
+
+        size_t chunk_size() const noexcept { return _chunk_size; }
+
+        /// Takes `size` bytes written after prepare() and reports the lines they complete.
+        template <typename F>
+        void commit(size_t size, F &&callback)
+        {
+            const size_t scanned = _end;
+            _end += size;
+            // Only the new bytes can hold the last terminator, the carried ones had none
+            const size_t nl = find_last_of(_buffer.data() + scanned, size, '\n');
+            if (nl == SIZE_MAX) return;
+            const size_t cut = scanned + nl + 1;
+            emit(cut, callback);
+            _begin = cut;
+        }
+
+        /// Reports the unterminated last line, if any.
+        template <typename F>
+        void finish(F &&callback)
+        {
+            if (_end > _begin) emit(_end, callback);
+            _begin = _end = 0;
+        }
+
+    private:
+        vector<char> _buffer;
+        string_view_pool<char> _lines;
+        size_t _chunk_size;
+        size_t _begin = 0;
+        size_t _end = 0;
+
+        template <typename F>
+        void emit(size_t end, F &callback)
+        {
+            _lines.clear();
+            fill_line_buffer(_buffer.data() + _begin, end - _begin, _lines);
+            if (!_lines.empty()) callback(static_cast<const string_view_pool<char> &>(_lines));
+        }
+    };
+} // namespace acul
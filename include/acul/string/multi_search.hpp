@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../api.hpp"
+#include "../vector.hpp"
+#include "string.hpp"
+#include "string_view_pool.hpp"
+
+namespace acul
+{
+    struct multi_match
+    {
+        /// Start of the match relative to the searched buffer.
+        size_t offset;
+        /// Index of the pattern in the order it was given to the matcher.
+        u32 pattern;
+    };
+
+    struct line_match
+    {
+        size_t line;
+        /// Start of the match relative to the line.
+        size_t offset;
+        u32 pattern;
+    };
+
+    namespace detail
+    {
+        struct multi_search_program;
+    }
+
+    /**
+     * @brief Searches a buffer for many patterns in one pass.
+     *
+     * Compiled once from the pattern set. Up to 64 patterns are located with a SIMD prefilter that tests
+     * the first bytes of every position against nibble masks of the patterns and only compares the
+     * candidates it finds (Teddy). Larger sets, and CPUs without SSE4.2, use an Aho–Corasick automaton over
+     * the bytes that occur in the patterns.
+     *
+     * Every occurrence of every pattern is reported, overlapping ones included, ordered by offset and then
+     * by pattern index. Case-insensitive matching folds ASCII letters only. Empty patterns never match.
+     */
+    class APPLIB_API multi_matcher
+    {
+    public:
+        multi_matcher(const string_view *patterns, size_t count, bool ignore_case = false);
+
+        explicit multi_matcher(const vector<string> &patterns, bool ignore_case = false);
+
+        multi_matcher(const multi_matcher &) = delete;
+        multi_matcher &operator=(const multi_matcher &) = delete;
+
+        multi_matcher(multi_matcher &&other) noexcept : _program(other._program) { other._program = nullptr; }
+
+        multi_matcher &operator=(multi_matcher &&other) noexcept;
+
+        ~multi_matcher();
+
+        /// Number of patterns, empty ones included.
+        size_t size() const noexcept;
+
+        bool ignore_case() const noexcept;
+
+        /// True when the SIMD prefilter is used for this pattern set on the current CPU.
+        bool vectorized() const noexcept;
+
+        /// Appends the matches found in the buffer to `dst` and returns how many were added.
+        size_t find_all(const char *data, size_t size, vector<multi_match> &dst) const;
+
+        size_t find_all(string_view text, vector<multi_match> &dst) const
+        {
+            return find_all(text.data(), text.size(), dst);
+        }
+
+        /// Searches every line of the pool separately; matches never span lines.
+        size_t find_all(const string_view_pool<char> &lines, vector<line_match> &dst) const;
+
+    private:
+        detail::multi_search_program *_program;
+
+        void compile(const string_view *patterns, size_t count, bool ignore_case);
+    };
+} // namespace acul
@@ -57,8 +57,9 @@ namespace acul
         template <typename Float, std::enable_if_t<std::is_floating_point_v<Float>, int> = 0>
         basic_stringstream &operator<<(Float num)
         {
-            char buf[num_to_strbuf_size<Float>()];
-            int len = to_string(num, buf, sizeof(buf), 0);
+            using F = std::conditional_t<std::is_same_v<Float, f32>, f32, f64>;
+            char buf[num_to_strbuf_size<F>()];
+            int len = to_string(static_cast<F>(num), buf, sizeof(buf));
             if (len != 0) _data.append(buf, len);
             return *this;
         }
@@ -87,6 +88,9 @@ namespace acul
 
         basic_string<T, Allocator> str() const noexcept { return _data; }
 
+        /// Underlying buffer, for writers that append in place.
+        stringtype &buffer() noexcept { return _data; }
+
         void clear() noexcept { _data.clear(); }
 
         void reserve(size_type n) { _data.reserve(n); }
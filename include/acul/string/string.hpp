@@ -1,6 +1,7 @@
 #ifndef APP_ACUL_STD_STRING_H
 #define APP_ACUL_STD_STRING_H
 
+#include "../detail/isa/dispatch.hpp"
 #include "../exception/exception.hpp"
 #include "../fwd/string.hpp"
 #include "base.hpp"
@@ -30,6 +31,8 @@ namespace acul
         using const_iterator = const_pointer;
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        /// Short strings are kept by value with no pointer to themselves.
+        using trivially_relocatable = relocatable_tag<basic_string>;
 
         enum : size_type
         {
@@ -511,17 +514,25 @@ namespace acul
         inline size_type find(value_type ch, size_type pos = 0) const noexcept
         {
             if (pos >= size()) return npos;
-            const_pointer start = c_str() + pos;
-            const_pointer p = strchr(start, ch);
-            return p ? static_cast<size_type>(p - start) + pos : npos;
+            const_pointer start = c_str();
+            const_pointer p = static_cast<const_pointer>(memchr(start + pos, ch, size() - pos));
+            return p ? static_cast<size_type>(p - start) : npos;
         }
 
         inline size_type find(const basic_string &str, size_type pos = 0) const noexcept
         {
             if (pos >= size() || str.size() > size() - pos) return npos;
-            const_pointer start = c_str() + pos;
-            const_pointer p = strstr(start, str.c_str());
-            return p ? static_cast<size_type>(p - c_str()) : npos;
+            const size_t r = detail::g_isa_dispatcher.search.find(c_str() + pos, size() - pos, str.c_str(), str.size());
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r + pos);
+        }
+
+        /// Position of the first character that occurs in `set`.
+        inline size_type find_first_of(basic_string_view<T> set, size_type pos = 0) const noexcept
+        {
+            if (pos >= size()) return npos;
+            const size_t r =
+                detail::g_isa_dispatcher.search.find_first_of(c_str() + pos, size() - pos, set.data(), set.size());
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r + pos);
         }
 
         inline size_type rfind(value_type ch, size_type pos = npos) const noexcept
@@ -540,18 +551,10 @@ namespace acul
             }
             if (count > size()) return npos;
 
-            size_type start;
-            if (pos == npos || pos + 1 < count) start = size() - count;
-            else start = (pos >= size() ? size() - count : pos - count + 1);
-
-            const_pointer base = c_str();
-            for (;;)
-            {
-                if (memcmp(base + start, s, count) == 0) return start;
-                if (start == 0) break;
-                --start;
-            }
-            return npos;
+            // The match has to end at or before pos
+            const size_type end = (pos == npos || pos + 1 < count || pos >= size()) ? size() : pos + 1;
+            const size_t r = detail::g_isa_dispatcher.search.rfind(c_str(), end, s, count);
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r);
         }
 
         inline size_type rfind(const_pointer s, size_type pos = npos) const noexcept
@@ -1027,7 +1030,7 @@ namespace std
         {
             const char *bytes = reinterpret_cast<const char *>(s.data());
             size_t len = s.size() * sizeof(T);
-            return len <= 16 ? acul::detail::cityhash64_short(bytes, len) : acul::detail::cityhash64_long(bytes, len);
+            return acul::detail::cityhash64(bytes, len);
         }
     };
 } // namespace std
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../detail/isa/dispatch.hpp"
 #include "../exception/exception.hpp"
 #include "../fwd/string_view.hpp"
 #include "base.hpp"
@@ -73,8 +74,17 @@ namespace acul
         constexpr size_type find(basic_string_view str, size_type pos = 0) const noexcept
         {
             if (pos >= _size || str.size() > _size - pos) return npos;
-            const_pointer p = strstr(_data + pos, str.data());
-            return p ? static_cast<size_type>(p - _data) : npos;
+            const size_t r = detail::g_isa_dispatcher.search.find(_data + pos, _size - pos, str.data(), str.size());
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r + pos);
+        }
+
+        /// Position of the first character that occurs in `set`.
+        constexpr size_type find_first_of(basic_string_view set, size_type pos = 0) const noexcept
+        {
+            if (pos >= _size) return npos;
+            const size_t r =
+                detail::g_isa_dispatcher.search.find_first_of(_data + pos, _size - pos, set.data(), set.size());
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r + pos);
         }
 
         constexpr size_type rfind(value_type ch, size_type pos = npos) const noexcept
@@ -95,15 +105,10 @@ namespace acul
             }
 
             if (n > _size) return npos;
-            size_type start = (pos == npos || pos + 1 < n) ? _size - n : (pos >= _size) ? _size - n : pos - n + 1;
-            for (;;)
-            {
-                if (memcmp(_data + start, str.data(), n) == 0) return start;
-
-                if (start == 0) break;
-                --start;
-            }
-            return npos;
+            // The match has to end at or before pos
+            const size_type end = (pos == npos || pos + 1 < n || pos >= _size) ? _size : pos + 1;
+            const size_t r = detail::g_isa_dispatcher.search.rfind(_data, end, str.data(), n);
+            return r == SIZE_MAX ? npos : static_cast<size_type>(r);
         }
 
         constexpr size_type rfind(const_pointer s, size_type pos = npos) const noexcept
@@ -135,7 +140,7 @@ namespace std
         {
             const char *bytes = reinterpret_cast<const char *>(s.data());
             size_t len = s.size() * sizeof(T);
-            return len <= 16 ? acul::detail::cityhash64_short(bytes, len) : acul::detail::cityhash64_long(bytes, len);
+            return acul::detail::cityhash64(bytes, len);
         }
     };
 } // namespace std
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../fwd/string_view_pool.hpp"
+#include "../small_vector.hpp"
 #include "../type_traits.hpp"
 #include "../vector.hpp"
 #include "string_view.hpp"
@@ -8,13 +9,20 @@
 
 namespace acul
 {
-    template <typename T, typename Allocator>
+    /**
+     * @brief List of views into a shared buffer, such as the lines or fields of a text.
+     *
+     * With an `InlineCapacity` the first views are kept inside the pool, which suits short splits like the
+     * fields of a record; by default every view lives on the heap.
+     */
+    template <typename T, typename Allocator, size_t InlineCapacity>
     class string_view_pool
     {
         static_assert(is_char_v<T>, "string_view_pool requires a string character type");
         using view_type = basic_string_view<T>;
         using alloc_view_type = typename Allocator::template rebind<view_type>::other;
-        using vector_type = vector<view_type, alloc_view_type>;
+        using vector_type = std::conditional_t<InlineCapacity == 0, vector<view_type, alloc_view_type>,
+                                               small_vector<view_type, InlineCapacity, alloc_view_type>>;
 
     public:
         using value_type = T *;
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../detail/isa/dispatch.hpp"
+#include "../vector.hpp"
+#include "string.hpp"
+#include "string_view_pool.hpp"
+#include "utils.hpp"
+
+namespace acul
+{
+    struct tokenize_options
+    {
+        /// Field separators, any one of them ends a field. Up to 16 use the vector kernels.
+        string_view delimiters = ",";
+        /// Quote character, '\0' disables quoting.
+        char quote = '"';
+    };
+
+    /**
+     * @brief Fields of delimited text grouped into records.
+     *
+     * Fields are views into the tokenized buffer, kept in one reusable pool, and records are ranges of
+     * that pool. Filled by tokenize().
+     */
+    class token_table
+    {
+    public:
+        /// Number of records.
+        size_t size() const noexcept { return _record_ends.size(); }
+
+        bool empty() const noexcept { return _record_ends.empty(); }
+
+        /// Number of fields in the record.
+        size_t record_size(size_t record) const noexcept
+        {
+            return _record_ends[record] - (record ? _record_ends[record - 1] : 0);
+        }
+
+        string_view field(size_t record, size_t index) const noexcept
+        {
+            return _fields[(record ? _record_ends[record - 1] : 0) + index];
+        }
+
+        /// All fields of all records in order.
+        const string_view_pool<char> &fields() const noexcept { return _fields; }
+
+        void clear() noexcept
+        {
+            _fields.clear();
+            _record_ends.clear();
+        }
+
+        /// Sink for the tokenizer kernels: appends a field to the current record.
+        void push(const char *str, size_t length) noexcept { _fields.push(str, length); }
+
+        /// Sink for the tokenizer kernels: closes the current record.
+        void end_record() { _record_ends.push_back(_fields.size()); }
+
+        /// True when fields were pushed since the last closed record.
+        bool record_open() const noexcept
+        {
+            return _fields.size() > (_record_ends.empty() ? 0 : _record_ends.back());
+        }
+
+    private:
+        string_view_pool<char> _fields;
+        vector<size_t> _record_ends;
+    };
+
+    /**
+     * @brief Splits delimited text such as CSV or TSV into fields without copying them.
+     *
+     * '\n' ends a record and a '\r' before it is dropped. Delimiters and newlines between quote characters
+     * belong to the field. A field that starts and ends with a quote is returned without them, doubled
+     * quotes inside are left as they are (see unescape_field()). Results are appended to `dst`.
+     */
+    inline void tokenize(const char *data, size_t size, const tokenize_options &options, token_table &dst)
+    {
+        detail::g_isa_dispatcher.tokenize(data, size, options.delimiters.data(), options.delimiters.size(),
+                                          options.quote, dst);
+    }
+
+    /**
+     * @brief Appends the substrings between occurrences of `delim` to `dst` as views.
+     *
+     * Same rules as split(const string &, char) without allocating a string per token: delimiters are
+     * not included and a trailing empty token is dropped.
+     */
+    inline void split(const char *str, size_t len, char delim, string_view_pool<char> &dst)
+    {
+        const char *p = str;
+        const char *const end = str + len;
+        while (p < end)
+        {
+            const char *found = static_cast<const char *>(memchr(p, delim, end - p));
+            if (!found)
+            {
+                dst.push(p, end - p);
+                break;
+            }
+            dst.push(p, found - p);
+            p = found + 1;
+        }
+    }
+
+    /// Collapses doubled quote characters of a field returned by tokenize().
+    inline string unescape_field(string_view field, char quote = '"')
+    {
+        string result;
+        result.reserve(field.size());
+        for (size_t i = 0; i < field.size(); ++i)
+        {
+            result.push_back(field[i]);
+            if (field[i] == quote && i + 1 < field.size() && field[i + 1] == quote) ++i;
+        }
+        return result;
+    }
+} // namespace acul
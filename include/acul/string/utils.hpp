@@ -17,13 +17,37 @@
 namespace acul
 {
 
+    /// @brief Checks that the bytes are well-formed UTF-8: no overlong forms, surrogates or truncated sequences
+    inline bool validate_utf8(const char *data, size_t size)
+    {
+        return detail::g_isa_dispatcher.utf.utf8_to_utf16_length(data, size) != SIZE_MAX;
+    }
+
+    /// @brief Checks that every surrogate in the UTF-16 text is part of a pair
+    inline bool validate_utf16(const c16 *data, size_t size)
+    {
+        return detail::g_isa_dispatcher.utf.utf16_to_utf8_length(data, size) != SIZE_MAX;
+    }
+
+    /// @brief Convert text in UTF-8 encoding to UTF-16 encoding
+    /// @details Each ill-formed sequence is replaced with U+FFFD. The result is allocated once.
+    /// @param data Text in UTF-8 encoding
+    /// @param size Size in bytes
+    APPLIB_API u16string utf8_to_utf16(const char *data, size_t size);
+
     /// @brief Convert string in UTF-8 encoding to string in UTF-16 encoding
     /// @param src String in UTF-8 encoding
-    APPLIB_API u16string utf8_to_utf16(const string &src);
+    inline u16string utf8_to_utf16(const string &src) { return utf8_to_utf16(src.data(), src.size()); }
+
+    /// @brief Convert text in UTF-16 encoding to UTF-8 encoding
+    /// @details Each unpaired surrogate is replaced with U+FFFD. The result is allocated once.
+    /// @param data Text in UTF-16 encoding
+    /// @param size Size in code units
+    APPLIB_API string utf16_to_utf8(const c16 *data, size_t size);
 
     /// @brief Convert string in UTF-16 encoding to string in UTF-8 encoding
     /// @param src String in UTF-16 encoding
-    APPLIB_API string utf16_to_utf8(const u16string &src);
+    inline string utf16_to_utf8(const u16string &src) { return utf16_to_utf8(src.data(), src.size()); }
 
     /**
      * @brief Formats a string using a format string and arguments.
@@ -38,7 +62,9 @@ namespace acul
     template <typename T>
     constexpr size_t num_to_strbuf_size()
     {
-        return std::numeric_limits<T>::digits10 + 2; // Numbers + -/+ + \0
+        // Shortest float form: sign, max_digits10 digits, point and an exponent like e-308
+        if constexpr (std::is_floating_point_v<T>) return std::numeric_limits<T>::max_digits10 + 8;
+        else return std::numeric_limits<T>::digits10 + 2; // Numbers + -/+ + \0
     }
 
     /**
@@ -47,76 +73,68 @@ namespace acul
      * @param buffer Destination buffer
      * @return The number of characters written
      */
-    template <typename T>
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
     int to_string(T value, char *buffer)
     {
-        size_t buffer_size = num_to_strbuf_size<T>();
+        using U = std::make_unsigned_t<std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>>;
         char *ptr = buffer;
+        U magnitude = static_cast<U>(value);
 
-        // Sign
-        if (value < 0)
-        {
-            *ptr = '-';
-            value = -value;
-            ptr++;
-            buffer_size--;
-        }
-
-        // If zero
-        if (value == 0)
-        {
-            if (buffer_size >= 2)
+        // Sign. Negating in the unsigned domain keeps the minimum value representable
+        if constexpr (std::is_signed_v<T>)
+            if (value < 0)
             {
-                *ptr = '0';
-                ++ptr;
-                return 1;
+                *ptr++ = '-';
+                magnitude = U(0) - magnitude;
             }
-            else return 0;
-        }
 
-        size_t num_digits = 0;
-        int tmp = value;
-        while (tmp > 0)
-        {
-            num_digits++;
-            tmp /= 10;
-        }
-        if (num_digits > buffer_size - 1) return 0;
-
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wvla-cxx-extension"
-#endif
         // Reverse order array for storing digits
-        char reverse_order[num_digits];
-#ifdef __clang__
-    #pragma clang diagnostic pop
-#endif
+        char reverse_order[std::numeric_limits<U>::digits10 + 1];
         int i = 0;
-        do
-        {
-            reverse_order[i++] = value % 10;
-            value /= 10;
-        } while (value);
+        do {
+            reverse_order[i++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
 
         // Writing digits to the buffer in the correct order
-        while (i--)
-        {
-            *ptr = '0' + reverse_order[i];
-            ptr++;
-        }
+        while (i--) *ptr++ = reverse_order[i];
         return ptr - buffer;
     }
 
+    enum class float_format : u8
+    {
+        shortest,   ///< Shortest of fixed and scientific, fixed on a tie
+        fixed,      ///< [-]ddd.ddd
+        scientific, ///< [-]d.ddde±dd
+        general     ///< printf %g: scientific for large or small exponents, trailing zeros removed
+    };
+
     /**
      * @brief Converts the float to the C-style string
+     *
+     * Without a precision the output holds the fewest significant digits that read back as the same
+     * value. With a precision the exact binary value is rounded half to even, matching printf.
+     * General uses 6 significant digits by default.
+     *
      * @param value Source value
-     * @param buffer Destination buffer
+     * @param buffer Destination buffer. No terminating null is written
      * @param buffer_size Buffer size
-     * @param precision Precision
-     * @return The number of characters written
+     * @param format Notation
+     * @param precision Digits after the decimal point, or significant digits for general. -1 for none
+     * @return The number of characters written, or 0 if the buffer is too small
      **/
-    APPLIB_API int to_string(f32 value, char *buffer, size_t buffer_size, int precision);
+    APPLIB_API int to_string(f32 value, char *buffer, size_t buffer_size, float_format format = float_format::shortest,
+                             int precision = -1);
+
+    /// @copydoc to_string(f32, char *, size_t, float_format, int)
+    APPLIB_API int to_string(f64 value, char *buffer, size_t buffer_size, float_format format = float_format::shortest,
+                             int precision = -1);
+
+    /// Fixed notation with the given number of digits after the decimal point.
+    inline int to_string(f32 value, char *buffer, size_t buffer_size, int precision)
+    {
+        return to_string(value, buffer, buffer_size, float_format::fixed, precision);
+    }
 
     template <typename T>
     inline auto to_string(T value) -> std::enable_if_t<std::is_integral_v<T>, acul::string>
@@ -126,6 +144,15 @@ namespace acul
         return string(buffer, len);
     }
 
+    template <typename T>
+    inline auto to_string(T value) -> std::enable_if_t<std::is_floating_point_v<T>, acul::string>
+    {
+        using F = std::conditional_t<std::is_same_v<T, f32>, f32, f64>;
+        char buffer[num_to_strbuf_size<F>()];
+        int len = to_string(static_cast<F>(value), buffer, sizeof(buffer));
+        return string(buffer, len);
+    }
+
     template <typename T>
     inline auto to_u16string(T value) -> std::enable_if_t<std::is_integral_v<T>, acul::u16string>
     {
@@ -173,12 +200,22 @@ namespace acul
 
     /**
      * @brief Deserialize the C-style string to the float32
-     * @param str Source string
+     *
+     * Accepts `[+-]digits[.digits][(e|E)[+-]digits]`, `inf`, `infinity` and `nan` regardless of the locale.
+     * The result is the correctly rounded nearest value; out-of-range input gives infinity or zero.
+     *
+     * @param str Source string. Advanced past the parsed number on success
      * @param value Destination value
      * @return True if successful. Otherwise false
      **/
     APPLIB_API bool stof(const char *&str, f32 &value);
 
+    /**
+     * @brief Deserialize the C-style string to the float64
+     * @copydetails stof(const char *&, f32 &)
+     **/
+    APPLIB_API bool stod(const char *&str, f64 &value);
+
     /// Removes control whitespace characters (\f, \n, \r, \t, \v) from the input string,
     /// trims leading and trailing spaces, and optionally truncates the result to `max` length.
     /// Internal spaces (' ') are preserved.
@@ -220,32 +257,11 @@ namespace acul
         return string(begin, end - begin);
     }
 
+    /// Position of `find` in the first `len` bytes of `str` ignoring ASCII case, or SIZE_MAX.
     inline size_t find_insensitive_case(const char *str, size_t len, const char *find)
     {
         if (!str || !find) return (size_t)-1;
-
-#ifdef _WIN32
-        size_t n = len;
-        size_t m = null_terminated_length(find);
-        if (m == 0 || m > n) return (size_t)-1;
-
-        auto lower = [](unsigned char c) -> unsigned char { return (c >= 'A' && c <= 'Z') ? c + 32 : c; };
-
-        for (size_t i = 0; i + m <= n; ++i)
-        {
-            size_t j = 0;
-            for (; j < m; ++j)
-            {
-                if (lower((unsigned char)str[i + j]) != lower((unsigned char)find[j])) { break; }
-            }
-            if (j == m) return i;
-        }
-        return (size_t)-1;
-
-#else
-        const char *p = strcasestr(str, find);
-        return p ? static_cast<size_t>(p - str) : (size_t)-1;
-#endif
+        return detail::g_isa_dispatcher.search.find_icase(str, len, find, null_terminated_length(find));
     }
 
     inline size_t find_insensitive_case(const string &str, const char *find)
@@ -375,19 +391,29 @@ namespace acul
         return result;
     }
 
+    /// Number of occurrences of `ch` in the first `len` bytes of `str`.
+    inline size_t count(const char *str, size_t len, char ch)
+    {
+        return detail::g_isa_dispatcher.search.count(str, len, ch);
+    }
+
+    inline size_t count(const string &str, char ch) { return count(str.c_str(), str.size(), ch); }
+
+    /// Lower-cases ASCII letters, other bytes are copied unchanged.
     inline string to_lower(const string &s)
     {
         string out;
         out.resize(s.size());
-        for (size_t i = 0; i < s.size(); ++i) { out[i] = tolower(s[i]); }
+        detail::g_isa_dispatcher.search.to_lower(s.c_str(), s.size(), out.data());
         return out;
     }
 
+    /// Upper-cases ASCII letters, other bytes are copied unchanged.
     inline string to_upper(const string &s)
     {
         string out;
         out.resize(s.size());
-        for (size_t i = 0; i < s.size(); ++i) { out[i] = toupper(s[i]); }
+        detail::g_isa_dispatcher.search.to_upper(s.c_str(), s.size(), out.data());
         return out;
     }
 
@@ -395,4 +421,15 @@ namespace acul
     {
         return detail::g_isa_dispatcher.fill_line_buffer(data, size, dst);
     }
+
+    /**
+     * @brief Multi-threaded fill_line_buffer for large buffers such as mapped files.
+     *
+     * The buffer is cut into ranges that each start right after a '\n', so no line or CRLF pair spans two
+     * ranges. The ranges are split in parallel into their own pools, which are then appended to `dst` in
+     * order. The result is identical to fill_line_buffer.
+     * @param min_range Smallest range handed to a worker; smaller buffers are split on the calling thread.
+     */
+    APPLIB_API void fill_line_buffer_parallel(const char *data, size_t size, string_view_pool<char> &dst,
+                                              size_t min_range = 4 << 20);
 } // namespace acul
@@ -6,7 +6,7 @@
 #include <oneapi/tbb/task_arena.h>
 #include <oneapi/tbb/task_group.h>
 #include "functional/unique_function.hpp"
-#include "memory/smart_ptr.hpp"
+#include "memory/intrusive_ptr.hpp"
 #include "vector.hpp"
 
 #ifdef _WIN32
@@ -16,7 +16,8 @@
 
 namespace acul::task
 {
-    class task_base
+    /// Tasks keep their count inline: they are created for every dispatch and released on the worker.
+    class task_base : public ref_counted<task_base, atomic_ref_policy>
     {
     public:
         virtual ~task_base() = default;
@@ -100,7 +101,7 @@ namespace acul::task
         if constexpr (std::is_invocable<F>::value)
         {
             using R = std::invoke_result_t<F>;
-            auto ptr = make_shared<acul::task::task<R>>(std::forward<F>(task));
+            auto ptr = make_intrusive<acul::task::task<R>>(std::forward<F>(task));
             return ptr;
         }
         else
@@ -228,7 +229,7 @@ namespace acul::task
     private:
         struct timed_task
         {
-            shared_ptr<task_base> task;
+            intrusive_ptr<task_base> task;
             std::chrono::steady_clock::time_point time;
 
             bool operator<(const timed_task &other) const { return time > other.time; }
@@ -16,13 +16,13 @@ namespace acul
     };
 
     // function
-    template <typename R, typename Arg, size_t S, template <class> class Alloc>
+    template <typename R, typename Arg, size_t S, template <class...> class Alloc>
     struct lambda_arg_traits<unique_function<R(Arg), S, Alloc>>
     {
         using argument_type = Arg;
     };
 
-    template <typename R, typename Arg, size_t S, template <class> class Alloc>
+    template <typename R, typename Arg, size_t S, template <class...> class Alloc>
     struct lambda_arg_traits<function<R(Arg), S, Alloc>>
     {
         using argument_type = Arg;
@@ -84,4 +84,37 @@ namespace acul
 
     template <typename T>
     using is_nonchar_integer = std::integral_constant<bool, std::is_integral_v<T> && !is_char<T>::value>;
+
+    /**
+     * @brief Whether an object of T may be moved to other memory by copying its bytes, the source being
+     * dropped without running its destructor.
+     *
+     * Holds for trivially copyable types and for the library types that only own their data through
+     * pointers. Other types opt in by specializing the trait or by declaring
+     * `using trivially_relocatable = acul::relocatable_tag<Self>;`. The tag names its owner so that a
+     * derived class, which inherits the alias but may add members of its own, is not opted in with it.
+     * Containers use the trait to grow with memcpy and realloc, so a type that keeps pointers into itself
+     * or registers its own address must not opt in.
+     */
+    template <typename T, typename = void>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {
+    };
+
+    /// Opt-in marker for is_trivially_relocatable, declared by `Owner` as its `trivially_relocatable` alias.
+    template <typename Owner, bool Relocatable = true>
+    struct relocatable_tag : std::bool_constant<Relocatable>
+    {
+        using owner = Owner;
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<
+        T, std::enable_if_t<std::is_same_v<typename T::trivially_relocatable::owner, std::remove_cv_t<T>>>>
+        : T::trivially_relocatable
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
 } // namespace acul
@@ -23,6 +23,7 @@ namespace acul
         using const_iterator = pointer_iterator<const_pointer>;
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = const std::reverse_iterator<iterator>;
+        using trivially_relocatable = relocatable_tag<vector>;
 
         vector() noexcept : _size(0), _capacity(0), _data(nullptr) {}
 
@@ -217,16 +218,7 @@ namespace acul
                 _capacity = std::max(_capacity * 2, new_size);
                 pointer new_data = Allocator::allocate(_capacity);
                 if (!new_data) throw bad_alloc(_capacity);
-                if constexpr (std::is_trivially_copyable_v<value_type>)
-                    memcpy(new_data, _data, _size * sizeof(value_type));
-                else
-                {
-                    for (size_type i = 0; i < _size; ++i)
-                    {
-                        Allocator::construct(new_data + i, std::move(_data[i]));
-                        Allocator::destroy(_data + i);
-                    }
-                }
+                relocate(_data, _size, new_data);
                 Allocator::deallocate(_data, _capacity);
                 _data = new_data;
             }
@@ -368,7 +360,8 @@ namespace acul
         {
             if (adjust_capacity) _capacity = get_growth_size(_capacity, _capacity + 1);
             pointer new_data;
-            if constexpr (std::is_trivially_copyable_v<T>)
+            // Relocatable elements survive a byte copy, so the allocator may move the block as it likes
+            if constexpr (is_trivially_relocatable_v<T>)
             {
                 new_data = Allocator::reallocate(_data, _capacity);
                 if (!new_data) throw bad_alloc(_capacity);
@@ -377,11 +370,7 @@ namespace acul
             {
                 new_data = Allocator::allocate(_capacity);
                 if (!new_data) throw bad_alloc(_capacity);
-                for (size_type i = 0; i < _size; ++i)
-                {
-                    Allocator::construct(new_data + i, std::move(_data[i]));
-                    Allocator::destroy(_data + i);
-                }
+                relocate(_data, _size, new_data);
                 Allocator::deallocate(_data, _capacity);
             }
             _data = new_data;
@@ -410,22 +399,51 @@ namespace acul
                 for (size_type i = 0; i < count; ++i) Allocator::construct(dest + i, value);
         }
 
+        /// Relocates [start, end) to the uninitialized memory at `dest`, the ranges may overlap.
         template <typename Iter, typename Dest>
         void move_construct(Iter start, Iter end, Dest dest)
         {
-            if constexpr (std::is_trivially_move_constructible_v<value_type>)
-                memmove(dest, &(*start), (end - start) * sizeof(value_type));
+            if constexpr (is_trivially_relocatable_v<value_type>)
+                memmove((void *)dest, (const void *)&(*start), (end - start) * sizeof(value_type));
             else
-                for (; start != end; ++start, ++dest) Allocator::construct(dest, std::move(*start));
+                for (; start != end; ++start, ++dest)
+                {
+                    Allocator::construct(dest, std::move(*start));
+                    Allocator::destroy(&(*start));
+                }
         }
 
+        /// Relocates [start, end) to end at `destEnd`, for shifts towards the back of the same buffer.
         template <typename Iter>
         void move_elements_backward(Iter start, Iter end, Iter destEnd)
         {
-            if constexpr (std::is_trivially_move_constructible_v<value_type>)
-                memmove(destEnd - (end - start), &(*start), (end - start) * sizeof(value_type));
+            if constexpr (is_trivially_relocatable_v<value_type>)
+                memmove((void *)(destEnd - (end - start)), (const void *)&(*start), (end - start) * sizeof(value_type));
             else
-                while (end != start) Allocator::construct(--destEnd, std::move(*--end));
+                while (end != start)
+                {
+                    Allocator::construct(--destEnd, std::move(*--end));
+                    Allocator::destroy(&(*end));
+                }
+        }
+
+        /// Drops `count` elements at `index` and closes the gap.
+        void erase_n(size_type index, size_type count)
+        {
+            if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                if constexpr (!std::is_trivially_destructible_v<value_type>)
+                    for (size_type i = 0; i < count; ++i) Allocator::destroy(_data + index + i);
+                memmove((void *)(_data + index), (const void *)(_data + index + count),
+                        (_size - index - count) * sizeof(value_type));
+            }
+            else
+            {
+                std::move(_data + index + count, _data + _size, _data + index);
+                if constexpr (!std::is_trivially_destructible_v<value_type>)
+                    for (size_type i = _size - count; i < _size; ++i) Allocator::destroy(_data + i);
+            }
+            _size -= count;
         }
     };
 
@@ -435,9 +453,7 @@ namespace acul
         if (pos >= begin() && pos < end())
         {
             std::ptrdiff_t index = pos - begin();
-            std::move(_data + index + 1, _data + _size, _data + index);
-            --_size;
-            Allocator::destroy(_data + _size);
+            erase_n(index, 1);
             return iterator(_data + index);
         }
         return end();
@@ -449,11 +465,7 @@ namespace acul
         if (first >= begin() && last <= end() && first < last)
         {
             std::ptrdiff_t index = first - begin();
-            std::ptrdiff_t count = last - first;
-            std::move(_data + index + count, _data + _size, _data + index);
-            _size -= count;
-            if constexpr (!std::is_trivially_destructible_v<value_type>)
-                for (std::ptrdiff_t i = 0; i < count; ++i) Allocator::destroy(_data + _size + i);
+            erase_n(index, last - first);
             return iterator(_data + index);
         }
         return end();
@@ -466,16 +478,7 @@ namespace acul
         std::ptrdiff_t index = pos - begin();
 
         if (_size == _capacity) reserve(_capacity == 0 ? 1 : _capacity * 2);
-        if constexpr (std::is_trivially_move_constructible_v<value_type>)
-            std::move_backward(_data + index, _data + _size, _data + _size + 1);
-        else
-        {
-            for (size_type i = _size; i > static_cast<size_type>(index); --i)
-            {
-                Allocator::construct(_data + i, std::move(_data[i - 1]));
-                Allocator::destroy(_data + i - 1);
-            }
-        }
+        move_elements_backward(_data + index, _data + _size, _data + _size + 1);
 
         if constexpr (std::is_trivially_copyable_v<T>)
             _data[index] = value;
@@ -492,17 +495,7 @@ namespace acul
         const std::ptrdiff_t index = pos - begin();
 
         if (_size == _capacity) reserve(_capacity == 0 ? 1 : _capacity * 2);
-
-        if constexpr (std::is_trivially_move_constructible_v<value_type>)
-            std::move_backward(_data + index, _data + _size, _data + _size + 1);
-        else
-        {
-            for (size_t i = _size; i > static_cast<size_t>(index); --i)
-            {
-                Allocator::construct(_data + i, std::move(_data[i - 1]));
-                Allocator::destroy(_data + i - 1);
-            }
-        }
+        move_elements_backward(_data + index, _data + _size, _data + _size + 1);
 
         if constexpr (std::is_trivially_move_constructible_v<value_type>)
             _data[index] = std::move(value);
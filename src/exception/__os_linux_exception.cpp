@@ -3,6 +3,7 @@
 #include <acul/hash/hashmap.hpp>
 #include <acul/io/fs/path.hpp>
 #include <acul/io/path.hpp>
+#include <acul/string/format.hpp>
 #include <acul/string/sstream.hpp>
 #include "elf_read.hpp"
 
@@ -29,12 +30,12 @@ namespace acul
     void write_exception_info(siginfo_t *info, stringstream &stream)
     {
         int sig = info->si_signo;
-        stream << format("Signal: %d (%s)\n", sig, strsignal(sig));
+        fmt::format_to(stream, "Signal: {} ({})\n", sig, strsignal(sig));
 
         if (info)
         {
-            stream << format("Signal code: %d\n", info->si_code);
-            stream << format("Fault address: %p\n", info->si_addr);
+            fmt::format_to(stream, "Signal code: {}\n", info->si_code);
+            fmt::format_to(stream, "Fault address: {}\n", info->si_addr);
 
             if (sig == SIGSEGV || sig == SIGBUS || sig == SIGFPE || sig == SIGILL)
             {
@@ -60,15 +61,15 @@ namespace acul
         const auto &regs = context.uc_mcontext.gregs;
 
         stream << "Frame registers:\n";
-        stream << format("\tRAX: 0x%llx\n", regs[REG_RAX]);
-        stream << format("\tRBX: 0x%llx\n", regs[REG_RBX]);
-        stream << format("\tRCX: 0x%llx\n", regs[REG_RCX]);
-        stream << format("\tRDX: 0x%llx\n", regs[REG_RDX]);
-        stream << format("\tRSI: 0x%llx\n", regs[REG_RSI]);
-        stream << format("\tRDI: 0x%llx\n", regs[REG_RDI]);
-        stream << format("\tRBP: 0x%llx\n", regs[REG_RBP]);
-        stream << format("\tRSP: 0x%llx\n", regs[REG_RSP]);
-        stream << format("\tRIP: 0x%llx\n", regs[REG_RIP]);
+        fmt::format_to(stream, "\tRAX: 0x{:x}\n", static_cast<u64>(regs[REG_RAX]));
+        fmt::format_to(stream, "\tRBX: 0x{:x}\n", static_cast<u64>(regs[REG_RBX]));
+        fmt::format_to(stream, "\tRCX: 0x{:x}\n", static_cast<u64>(regs[REG_RCX]));
+        fmt::format_to(stream, "\tRDX: 0x{:x}\n", static_cast<u64>(regs[REG_RDX]));
+        fmt::format_to(stream, "\tRSI: 0x{:x}\n", static_cast<u64>(regs[REG_RSI]));
+        fmt::format_to(stream, "\tRDI: 0x{:x}\n", static_cast<u64>(regs[REG_RDI]));
+        fmt::format_to(stream, "\tRBP: 0x{:x}\n", static_cast<u64>(regs[REG_RBP]));
+        fmt::format_to(stream, "\tRSP: 0x{:x}\n", static_cast<u64>(regs[REG_RSP]));
+        fmt::format_to(stream, "\tRIP: 0x{:x}\n", static_cast<u64>(regs[REG_RIP]));
     }
 
     string get_symbol_name_from_elf(const elf_module &elf, uintptr_t ip)
@@ -99,8 +100,7 @@ namespace acul
         for (size_t i = 0; i < info.addresses_count; ++i)
         {
             auto ip = reinterpret_cast<uintptr_t>(info.addresses[i]);
-            string msg = format("\t#%d 0x%llx", i, ip);
-            out << msg;
+            fmt::format_to(out, "\t#{} 0x{:x}", i, ip);
             auto module_it = get_module_by_table(ip, module_table);
             bool is_error = false;
             if (module_it != module_table.cend())
@@ -1,5 +1,6 @@
 #include <acul/exception/exception.hpp>
 #include <acul/hash/utils.hpp>
+#include <acul/string/format.hpp>
 #include <acul/string/utils.hpp>
 #ifndef _MSC_VER
     #include <cxxabi.h>
@@ -12,13 +13,13 @@ namespace acul
 
     bad_alloc::bad_alloc(size_t size) noexcept
     {
-        string temp = format("bad alloc: failed to allocate %zu bytes", size);
+        string temp = fmt::format("bad alloc: failed to allocate {} bytes", size);
         _message = temp.c_str();
     }
 
     out_of_range::out_of_range(size_t max_range, size_t attempt) noexcept : exception()
     {
-        string temp = format("out of range: %zu >= %zu", attempt, max_range);
+        string temp = fmt::format("out of range: {} >= {}", attempt, max_range);
         _message = temp.c_str();
     }
 
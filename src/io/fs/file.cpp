@@ -1,5 +1,7 @@
 #include <acul/io/fs/file.hpp>
 #include <acul/log.hpp>
+#include <acul/string/line_reader.hpp>
+#include <cerrno>
 #include <zstd.h>
 
 #define FILE_READ_STREAM_CHUNK_SIZE 4096
@@ -49,6 +51,52 @@ namespace acul::fs
         return true;
     }
 
+    op_result read_lines(const string &filename, unique_function<void(const string_view_pool<char> &)> callback,
+                         size_t chunk_size)
+    {
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (!file) return make_op_error(ACUL_OP_READ_ERROR, errno);
+        // Chunks are read straight into the line buffer
+        setvbuf(file, nullptr, _IONBF, 0);
+
+        u16 state = ACUL_OP_SUCCESS;
+        line_reader reader(chunk_size);
+        // Failures of the reader become an error, exceptions from the callback belong to the caller
+        bool in_callback = false;
+        auto deliver = [&](const string_view_pool<char> &lines) {
+            in_callback = true;
+            callback(lines);
+            in_callback = false;
+        };
+        try
+        {
+            while (true)
+            {
+                char *dst = reader.prepare();
+                size_t n = fread(dst, 1, reader.chunk_size(), file);
+                if (n > 0) reader.commit(n, deliver);
+                if (n < reader.chunk_size())
+                {
+                    if (ferror(file)) state = ACUL_OP_READ_ERROR;
+                    break;
+                }
+            }
+            if (state == ACUL_OP_SUCCESS) reader.finish(deliver);
+        }
+        catch (...)
+        {
+            if (in_callback)
+            {
+                fclose(file);
+                throw;
+            }
+            state = ACUL_OP_ERROR_GENERIC;
+        }
+
+        fclose(file);
+        return {state, ACUL_OP_DOMAIN};
+    }
+
     bool write_binary(const string &filename, const char *buffer, size_t size)
     {
         std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
@@ -14,6 +14,9 @@ namespace acul::fs::jatc
 {
     op_result inline make_op_error(u16 state, u32 code = 0) { return {state, JATC_OP_DOMAIN, code}; }
 
+    /// Entry payload held while a cache file is rewritten, counted under the jatc memory tag.
+    using entry_buffer = vector<char, mem_allocator<char, mem_tags::jatc>>;
+
     bool write_header(entrypoint *entrypoint)
     {
         header header{JATC_MAGIC_NUMBER, JATC_VERSION};
@@ -29,7 +32,7 @@ namespace acul::fs::jatc
     }
 
     op_result rewrite_file(entrypoint *entrypoint, vector<index_entry *> &index_entries,
-                           vector<vector<char>> &data_buffers, const string &path)
+                           vector<entry_buffer> &data_buffers, const string &path)
     {
         auto open_flags = std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc;
         entrypoint->fd.open(path.c_str(), open_flags);
@@ -136,12 +139,12 @@ namespace acul::fs::jatc
         }
         auto fd = get_file_stream(entrypoint, group);
         if (!fd) return make_op_error(ACUL_OP_READ_ERROR, JATC_CODE_ENTRYPOINT);
-        vector<vector<char>> data_buffers;
+        vector<entry_buffer> data_buffers;
         data_buffers.reserve(index_entries.size());
         for (index_entry *entry : index_entries)
         {
             fd->seekg(entry->offset, std::ios::beg);
-            vector<char> buffer(entry->size);
+            entry_buffer buffer(entry->size);
             fd->read(buffer.data(), entry->size);
             if (!fd->good())
             {
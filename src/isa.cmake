@@ -21,6 +21,42 @@ set_source_files_properties(
     "${ACUL_SRC_DIR}/string/string_avx2.cpp"
     PROPERTIES COMPILE_OPTIONS "-mavx2"
 )
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/utf_sse42.cpp"
+    PROPERTIES COMPILE_OPTIONS "-msse4.2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/utf_avx2.cpp"
+    PROPERTIES COMPILE_OPTIONS "-mavx2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/search_sse42.cpp"
+    PROPERTIES COMPILE_OPTIONS "-msse4.2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/search_avx2.cpp"
+    PROPERTIES COMPILE_OPTIONS "-mavx2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/search_avx512.cpp"
+    PROPERTIES COMPILE_OPTIONS "-mavx512f;-mavx512bw"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/tokenize_sse42.cpp"
+    PROPERTIES COMPILE_OPTIONS "-msse4.2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/tokenize_avx2.cpp"
+    PROPERTIES COMPILE_OPTIONS "-mavx2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/teddy_sse42.cpp"
+    PROPERTIES COMPILE_OPTIONS "-msse4.2"
+)
+set_source_files_properties(
+    "${ACUL_SRC_DIR}/string/teddy_avx2.cpp"
+    PROPERTIES COMPILE_OPTIONS "-mavx2"
+)
 
 # Disable LTO for isa specific sources
 set(ISA_SOURCES
@@ -29,5 +65,14 @@ set(ISA_SOURCES
     "${ACUL_SRC_DIR}/hash/crc32_avx2.cpp"
     "${ACUL_SRC_DIR}/string/string_sse42.cpp"
     "${ACUL_SRC_DIR}/string/string_avx2.cpp"
+    "${ACUL_SRC_DIR}/string/utf_sse42.cpp"
+    "${ACUL_SRC_DIR}/string/utf_avx2.cpp"
+    "${ACUL_SRC_DIR}/string/search_sse42.cpp"
+    "${ACUL_SRC_DIR}/string/search_avx2.cpp"
+    "${ACUL_SRC_DIR}/string/search_avx512.cpp"
+    "${ACUL_SRC_DIR}/string/tokenize_sse42.cpp"
+    "${ACUL_SRC_DIR}/string/tokenize_avx2.cpp"
+    "${ACUL_SRC_DIR}/string/teddy_sse42.cpp"
+    "${ACUL_SRC_DIR}/string/teddy_avx2.cpp"
 )
 set_source_files_properties(${ISA_SOURCES} PROPERTIES INTERPROCEDURAL_OPTIMIZATION FALSE)
\ No newline at end of file
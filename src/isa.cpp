@@ -67,7 +67,11 @@ namespace acul
                 if (!get_leaf7(info[0], info[1], info[2], info[3])) return flags;
 
                 if (info[1] & (1 << 5)) flags |= isa_flag_bits::avx2;
-                if (is_avx512_ready && (info[1] & (1 << 16))) flags |= isa_flag_bits::avx512;
+                if (is_avx512_ready && (info[1] & (1 << 16)))
+                {
+                    flags |= isa_flag_bits::avx512;
+                    if (info[1] & (1 << 30)) flags |= isa_flag_bits::avx512bw;
+                }
             }
 
             return flags;
@@ -78,6 +82,11 @@ namespace acul
             flags = init_flags();
             crc32 = load_crc32_fn(flags);
             fill_line_buffer = load_fill_line_buffer_fn(flags);
+            line_index = load_line_index_kernels(flags);
+            tokenize = load_tokenize_fn(flags);
+            utf = load_utf_kernels(flags);
+            search = load_search_kernels(flags);
+            teddy_find = load_teddy_find_fn(flags);
         }
     } // namespace detail
 
@@ -1,5 +1,7 @@
 #include <acul/log.hpp>
+#include <acul/string/format.hpp>
 #include <acul/string/utils.hpp>
+#include <cmath>
 #include <cstdarg>
 #include <ctime>
 
@@ -10,14 +12,12 @@ namespace acul::log
         struct log_ctx g_log_ctx{nullptr, nullptr};
     }
 
-    void time_handler::handle(level level, const char *message, stringstream &ss) const
+    static void write_ascii_time(std::chrono::system_clock::time_point time, stringstream &ss)
     {
         using namespace std::chrono;
-        auto now = system_clock::now();
-        auto now_ns = now.time_since_epoch();
-        long long ns = duration_cast<nanoseconds>(now_ns).count() % 1000000000;
+        long long ns = duration_cast<nanoseconds>(time.time_since_epoch()).count() % 1000000000;
 
-        time_t time_t_now = system_clock::to_time_t(now);
+        time_t time_t_now = system_clock::to_time_t(time);
         std::tm tm_now;
 
 #ifdef _WIN32
@@ -26,39 +26,52 @@ namespace acul::log
         localtime_r(&time_t_now, &tm_now);
 #endif
 
-        string time = acul::format("%04d-%02d-%02d %02d:%02d:%02d.%09lld", tm_now.tm_year + 1900, tm_now.tm_mon + 1,
-                                   tm_now.tm_mday, tm_now.tm_hour, tm_now.tm_min, tm_now.tm_sec, ns);
-        ss << time.c_str();
+        fmt::format_to(ss, "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:09}", tm_now.tm_year + 1900, tm_now.tm_mon + 1,
+                       tm_now.tm_mday, tm_now.tm_hour, tm_now.tm_min, tm_now.tm_sec, ns);
     }
 
-    void level_name_handler::handle(level level, const char *message, stringstream &ss) const
+    static std::chrono::system_clock::time_point to_time_point(u64 timestamp)
+    {
+        using namespace std::chrono;
+        return system_clock::time_point(duration_cast<system_clock::duration>(nanoseconds(timestamp)));
+    }
+
+    void time_handler::handle(level level, const char *message, stringstream &ss) const
+    {
+        write_ascii_time(std::chrono::system_clock::now(), ss);
+    }
+
+    void time_handler::handle_record(const record &record, const char *, stringstream &ss) const
+    {
+        write_ascii_time(to_time_point(record.timestamp), ss);
+    }
+
+    static const char *level_to_string(level level)
     {
         switch (level)
         {
             case level::info:
-                ss << "INFO";
-                break;
+                return "INFO";
             case level::debug:
-                ss << "DEBUG";
-                break;
+                return "DEBUG";
             case level::trace:
-                ss << "TRACE";
-                break;
+                return "TRACE";
             case level::warn:
-                ss << "WARN";
-                break;
+                return "WARN";
             case level::error:
-                ss << "ERROR";
-                break;
+                return "ERROR";
             case level::fatal:
-                ss << "FATAL";
-                break;
+                return "FATAL";
             default:
-                ss << "UNKNOWN";
-                break;
+                return "UNKNOWN";
         }
     }
 
+    void level_name_handler::handle(level level, const char *message, stringstream &ss) const
+    {
+        ss << level_to_string(level);
+    }
+
     void color_handler::handle(level level, const char *message, stringstream &ss) const
     {
         switch (level)
@@ -89,10 +102,10 @@ namespace acul::log
 
     void logger_base::set_pattern(const string &pattern)
     {
-        static acul::hashmap<string, shared_ptr<token_handler_base>> token_handlers = {
-            {"ascii_time", make_shared<time_handler>()},  {"level_name", make_shared<level_name_handler>()},
-            {"thread", make_shared<thread_id_handler>()}, {"message", make_shared<message_handler>()},
-            {"color_auto", make_shared<color_handler>()}, {"color_off", make_shared<decolor_handler>()}};
+        static acul::hashmap<string, ts_shared_ptr<token_handler_base>> token_handlers = {
+            {"ascii_time", make_ts_shared<time_handler>()},  {"level_name", make_ts_shared<level_name_handler>()},
+            {"thread", make_ts_shared<thread_id_handler>()}, {"message", make_ts_shared<message_handler>()},
+            {"color_auto", make_ts_shared<color_handler>()}, {"color_off", make_ts_shared<decolor_handler>()}};
 
         _tokens->clear();
 
@@ -103,7 +116,7 @@ namespace acul::log
         {
             if (p + 1 < end && p[0] == '%' && p[1] == '(')
             {
-                if (p > begin) _tokens->push_back(make_shared<text_handler>(string(begin, size_t(p - begin))));
+                if (p > begin) _tokens->push_back(make_ts_shared<text_handler>(string(begin, size_t(p - begin))));
                 const char *tok_begin = p + 2;
                 const void *close_v = memchr(tok_begin, ')', size_t(end - tok_begin));
                 if (!close_v)
@@ -124,17 +137,292 @@ namespace acul::log
             ++p;
         }
 
-        if (begin < end) _tokens->push_back(make_shared<text_handler>(string(begin, size_t(end - begin))));
+        if (begin < end) _tokens->push_back(make_ts_shared<text_handler>(string(begin, size_t(end - begin))));
+    }
+
+    // Shortest decimal form that reads back as the same value
+    static void write_float(f64 value, stringstream &ss)
+    {
+        char buf[num_to_strbuf_size<f64>()];
+        int len = to_string(value, buf, sizeof(buf));
+        ss.write(buf, len);
+    }
+
+    static void write_value(const field &field, stringstream &ss)
+    {
+        switch (field.type)
+        {
+            case field_type::signed_int:
+                ss << field.i;
+                break;
+            case field_type::unsigned_int:
+                ss << field.u;
+                break;
+            case field_type::floating:
+                write_float(field.f, ss);
+                break;
+            case field_type::boolean:
+                ss << (field.b ? "true" : "false");
+                break;
+            default:
+                ss << field.str;
+                break;
+        }
+    }
+
+    void text_encoder::encode(logger_base &logger, const record &record, stringstream &ss) const
+    {
+        if (record.fields.empty())
+        {
+            logger.parse_tokens(record, record.message.c_str(), ss);
+            return;
+        }
+        stringstream message;
+        message << record.message;
+        for (auto &field : record.fields)
+        {
+            message << ' ' << field.key << '=';
+            write_value(field, message);
+        }
+        logger.parse_tokens(record, message.str().c_str(), ss);
+    }
+
+    static void write_json_string(const string &str, stringstream &ss)
+    {
+        static const char hex[] = "0123456789abcdef";
+        ss << '"';
+        for (char c : str)
+        {
+            switch (c)
+            {
+                case '"':
+                    ss << "\\\"";
+                    break;
+                case '\\':
+                    ss << "\\\\";
+                    break;
+                case '\n':
+                    ss << "\\n";
+                    break;
+                case '\r':
+                    ss << "\\r";
+                    break;
+                case '\t':
+                    ss << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        ss << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                    else ss << c;
+                    break;
+            }
+        }
+        ss << '"';
+    }
+
+    void json_encoder::encode(logger_base &logger, const record &record, stringstream &ss) const
+    {
+        ss << "{\"time\":\"";
+        write_ascii_time(to_time_point(record.timestamp), ss);
+        ss << "\",\"level\":\"" << level_to_string(record.level) << "\",\"thread\":" << record.thread_id
+           << ",\"logger\":";
+        write_json_string(logger.name(), ss);
+        ss << ",\"msg\":";
+        write_json_string(record.message, ss);
+        for (auto &field : record.fields)
+        {
+            ss << ',';
+            write_json_string(field.key, ss);
+            ss << ':';
+            if (field.type == field_type::string) write_json_string(field.str, ss);
+            else if (field.type == field_type::floating && !std::isfinite(field.f)) ss << "null";
+            else write_value(field, ss);
+        }
+        ss << "}\n";
+    }
+
+    static void write_logfmt_string(const string &str, stringstream &ss)
+    {
+        bool quote = str.empty();
+        for (char c : str)
+            if (static_cast<unsigned char>(c) <= ' ' || c == '=' || c == '"' || c == '\\')
+            {
+                quote = true;
+                break;
+            }
+        if (!quote)
+        {
+            ss << str;
+            return;
+        }
+        ss << '"';
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\') ss << '\\' << c;
+            else if (c == '\n') ss << "\\n";
+            else if (c == '\r') ss << "\\r";
+            else ss << c;
+        }
+        ss << '"';
+    }
+
+    void logfmt_encoder::encode(logger_base &logger, const record &record, stringstream &ss) const
+    {
+        ss << "time=\"";
+        write_ascii_time(to_time_point(record.timestamp), ss);
+        ss << "\" level=" << level_to_string(record.level) << " thread=" << record.thread_id << " logger=";
+        write_logfmt_string(logger.name(), ss);
+        ss << " msg=";
+        write_logfmt_string(record.message, ss);
+        for (auto &field : record.fields)
+        {
+            ss << ' ';
+            write_logfmt_string(field.key, ss);
+            ss << '=';
+            if (field.type == field_type::string) write_logfmt_string(field.str, ss);
+            else write_value(field, ss);
+        }
+        ss << '\n';
+    }
+
+    static void write_binary_string(const string &str, bin_stream &stream)
+    {
+        stream.write(static_cast<u32>(str.size()));
+        if (!str.empty()) stream.write(str.data(), str.size());
+    }
+
+    /// Whether `size` more bytes are left before `end`, the end of the record being decoded.
+    static bool fits(const bin_stream &stream, size_t end, size_t size) { return stream.pos() + size <= end; }
+
+    template <typename T>
+    static bool read_checked(bin_stream &stream, size_t end, T &value)
+    {
+        if (!fits(stream, end, sizeof(T))) return false;
+        stream.read(value);
+        return true;
+    }
+
+    static bool read_binary_string(bin_stream &stream, size_t end, string &str)
+    {
+        u32 size;
+        if (!read_checked(stream, end, size) || !fits(stream, end, size)) return false;
+        str = string(stream.data() + stream.pos(), size);
+        stream.shift(size);
+        return true;
+    }
+
+    void binary_encoder::encode(logger_base &, const record &record, stringstream &ss) const
+    {
+        bin_stream stream;
+        stream.write(static_cast<u32>(0))
+            .write(static_cast<u8>(record.level))
+            .write(record.timestamp)
+            .write(static_cast<i32>(record.thread_id));
+        write_binary_string(record.message, stream);
+        stream.write(static_cast<u16>(record.fields.size()));
+        for (auto &field : record.fields)
+        {
+            write_binary_string(field.key, stream);
+            stream.write(static_cast<u8>(field.type));
+            switch (field.type)
+            {
+                case field_type::signed_int:
+                    stream.write(field.i);
+                    break;
+                case field_type::unsigned_int:
+                    stream.write(field.u);
+                    break;
+                case field_type::floating:
+                    stream.write(field.f);
+                    break;
+                case field_type::boolean:
+                    stream.write(static_cast<u8>(field.b));
+                    break;
+                default:
+                    write_binary_string(field.str, stream);
+                    break;
+            }
+        }
+
+        u32 payload = acul::detail::swap_endian_scalar(static_cast<u32>(stream.size() - sizeof(u32)));
+        memcpy(stream.data(), &payload, sizeof(u32));
+        ss.write(stream.data(), stream.size());
+    }
+
+    bool binary_encoder::decode(bin_stream &stream, record &record)
+    {
+        u32 payload;
+        if (!read_checked(stream, stream.size(), payload) || !fits(stream, stream.size(), payload)) return false;
+        const size_t end = stream.pos() + payload;
+
+        // Every read is checked against the record, a truncated one fails instead of reading past it
+        u8 level;
+        i32 thread_id;
+        u16 count;
+        if (!read_checked(stream, end, level) || !read_checked(stream, end, record.timestamp) ||
+            !read_checked(stream, end, thread_id))
+            return false;
+        record.level = static_cast<enum level>(level);
+        record.thread_id = thread_id;
+        if (!read_binary_string(stream, end, record.message) || !read_checked(stream, end, count)) return false;
+        record.fields.clear();
+        record.fields.reserve(count);
+        for (u16 i = 0; i < count; ++i)
+        {
+            field field;
+            u8 type;
+            if (!read_binary_string(stream, end, field.key) || !read_checked(stream, end, type)) return false;
+            field.type = static_cast<field_type>(type);
+            bool ok;
+            switch (field.type)
+            {
+                case field_type::signed_int:
+                    ok = read_checked(stream, end, field.i);
+                    break;
+                case field_type::unsigned_int:
+                    ok = read_checked(stream, end, field.u);
+                    break;
+                case field_type::floating:
+                    ok = read_checked(stream, end, field.f);
+                    break;
+                case field_type::boolean:
+                {
+                    u8 b = 0;
+                    ok = read_checked(stream, end, b);
+                    field.b = b != 0;
+                    break;
+                }
+                default:
+                    ok = read_binary_string(stream, end, field.str);
+                    break;
+            }
+            if (!ok) return false;
+            record.fields.push_back(std::move(field));
+        }
+        return true;
+    }
+
+    const encoder_base &logger_base::encoder() const
+    {
+        static const text_encoder default_encoder;
+        if (_encoder) return *_encoder;
+        return default_encoder;
     }
 
     std::chrono::steady_clock::time_point log_service::dispatch()
     {
         while (true)
         {
-            pair<logger_base *, string> pair;
-            if (_queue.try_pop(pair))
+            entry entry;
+            if (_queue.try_pop(entry))
             {
-                pair.first->write(pair.second);
+                if (entry.structured)
+                {
+                    stringstream ss;
+                    entry.logger->encoder().encode(*entry.logger, entry.data, ss);
+                    entry.logger->write(ss.str());
+                }
+                else entry.logger->write(entry.data.message);
                 _count.fetch_sub(1, std::memory_order_relaxed);
             }
             else return std::chrono::steady_clock::time_point::max();
@@ -143,7 +431,7 @@ namespace acul::log
 
     void log_service::log(logger_base *logger, enum level level, const char *message, ...)
     {
-        if (level > this->level) return;
+        if (level > this->level || !logger->is_enabled(level)) return;
         va_list args;
         va_start(args, message);
         vlog(logger, level, message, args);
@@ -152,18 +440,39 @@ namespace acul::log
 
     void log_service::vlog(logger_base *logger, enum level level, const char *message, va_list args)
     {
-        if (level > this->level) return;
+        if (level > this->level || !logger->is_enabled(level)) return;
         stringstream ss;
         va_list copy;
         va_copy(copy, args);
         logger->parse_tokens(level, message, ss);
         _count.fetch_add(1, std::memory_order_relaxed);
         string parsed = ss.str();
-        _queue.emplace(logger, acul::format_va_list(parsed.c_str(), copy));
+        entry entry;
+        entry.logger = logger;
+        entry.data.level = level;
+        entry.data.message = acul::format_va_list(parsed.c_str(), copy);
+        _queue.push(std::move(entry));
         va_end(copy);
         notify();
     }
 
+    void log_service::submit(logger_base *logger, enum level level, const string &message, vector<field> &&fields)
+    {
+        using namespace std::chrono;
+        if (level > this->level || !logger->is_enabled(level)) return;
+        entry entry;
+        entry.logger = logger;
+        entry.structured = true;
+        entry.data.level = level;
+        entry.data.timestamp = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+        entry.data.thread_id = task::get_thread_id();
+        entry.data.message = message;
+        entry.data.fields = std::move(fields);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _queue.push(std::move(entry));
+        notify();
+    }
+
     void write(log_service *log_service, logger_base *logger, enum level level, const char *message, ...)
     {
         if (!log_service || !logger) return;
@@ -0,0 +1,105 @@
+#include <acul/memory/arena.hpp>
+#include <cstring>
+
+namespace acul
+{
+    arena::arena(size_t block_size) noexcept : _block_size(block_size > sizeof(block) ? block_size : sizeof(block) * 2)
+    {
+    }
+
+    arena::~arena() { release(); }
+
+    void *arena::allocate_slow(size_t size, size_t alignment) noexcept
+    {
+        // Blocks left over from before a reset come first, one that is too small stays where it is and a new
+        // block goes in front of it
+        block *next = _current ? _current->next : _head;
+        const size_t needed = size + alignment - 1;
+        if (!next || next->size < needed)
+        {
+            const size_t data_size = needed > _block_size - sizeof(block) ? needed : _block_size - sizeof(block);
+            auto *fresh = reinterpret_cast<block *>(mem_allocator<char>::allocate(sizeof(block) + data_size));
+            if (!fresh) return nullptr;
+            fresh->size = data_size;
+            fresh->next = next;
+            if (_current) _current->next = fresh;
+            else _head = fresh;
+            _reserved += sizeof(block) + data_size;
+            next = fresh;
+        }
+        _current = next;
+        _cursor = next->data();
+        _end = _cursor + next->size;
+        return allocate(size, alignment);
+    }
+
+    size_t arena::extent(const void *p) const noexcept
+    {
+        const char *c = static_cast<const char *>(p);
+        if (!c) return 0;
+        for (block *b = _head; b; b = b->next)
+        {
+            // Blocks after the current one are not in use
+            const char *end = b == _current ? _cursor : b->data() + b->size;
+            if (c >= b->data() && c < end) return end - c;
+            if (b == _current) break;
+        }
+        return 0;
+    }
+
+    void arena::reset() noexcept
+    {
+        _current = _head;
+        _cursor = _head ? _head->data() : nullptr;
+        _end = _head ? _cursor + _head->size : nullptr;
+        _last = nullptr;
+    }
+
+    void arena::release() noexcept
+    {
+        for (block *b = _head; b;)
+        {
+            block *next = b->next;
+            mem_allocator<char>::deallocate(reinterpret_cast<char *>(b));
+            b = next;
+        }
+        _head = _current = nullptr;
+        _cursor = _end = _last = nullptr;
+        _reserved = 0;
+    }
+
+    size_t arena::used() const noexcept
+    {
+        if (!_current) return 0;
+        size_t total = 0;
+        for (block *b = _head; b != _current; b = b->next) total += b->size;
+        return total + static_cast<size_t>(_cursor - _current->data());
+    }
+
+    namespace detail
+    {
+        arena_scope *&current_arena_scope() noexcept
+        {
+            static thread_local arena_scope *scope = nullptr;
+            return scope;
+        }
+
+        void *arena_reallocate(void *p, size_t size, size_t alignment) noexcept
+        {
+            arena_scope *scope = current_arena_scope();
+            if (!scope) return nullptr;
+            arena &current = scope->get();
+            if (!p) return current.allocate(size, alignment);
+            if (current.resize(p, size)) return p;
+
+            // The old size is not known, what lies between p and the end of the allocated part of its block
+            // is copied instead
+            size_t old_size = 0;
+            for (arena_scope *s = scope; s && !old_size; s = s->previous()) old_size = s->get().extent(p);
+            if (!old_size) return nullptr;
+            void *moved = current.allocate(size, alignment);
+            if (moved) memcpy(moved, p, old_size < size ? old_size : size);
+            return moved;
+        }
+    } // namespace detail
+} // namespace acul
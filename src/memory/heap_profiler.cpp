@@ -0,0 +1,345 @@
+#include <acul/memory/heap_profiler.hpp>
+#include <acul/string/sstream.hpp>
+
+#ifdef ACUL_HEAP_PROFILER_ENABLE
+    #include <acul/hash/hashmap.hpp>
+    #include <acul/hash/hl_hashmap.hpp>
+    #include <acul/string/detail/string_hash.hpp>
+    #include <acul/string/format.hpp>
+    #include <chrono>
+    #include <cmath>
+    #include <mutex>
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <acul/io/fs/file.hpp>
+        #include <cstring>
+        #include <execinfo.h>
+        #include <unistd.h>
+        #include "../exception/elf_read.hpp"
+    #endif
+
+namespace acul
+{
+    #ifndef _WIN32
+    string get_symbol_name_from_elf(const elf_module &elf, uintptr_t ip);
+    #endif
+
+    namespace detail
+    {
+        constinit thread_local i64 heap_sample_countdown = 0;
+        std::atomic<u16> heap_sample_filter[heap_sample_filter_size];
+    } // namespace detail
+
+    namespace heap_profiler
+    {
+        namespace
+        {
+            constexpr int max_depth = 48;
+
+            struct stack_record
+            {
+                void *frames[max_depth];
+                u32 depth;
+                u64 allocations = 0;
+                u64 bytes = 0;
+                u64 live_allocations = 0;
+                u64 live_bytes = 0;
+            };
+
+            struct live_sample
+            {
+                u64 stack;
+                size_t size;
+            };
+
+            struct profiler_state
+            {
+                std::mutex lock;
+                hl_hashmap<u64, stack_record> stacks;
+                hl_hashmap<void *, live_sample> live;
+            };
+
+            std::atomic<bool> g_running{false};
+            std::atomic<size_t> g_interval{default_sample_interval};
+
+            /// Never destroyed: blocks sampled before exit may be freed by static destructors running after ours.
+            profiler_state &state()
+            {
+                static profiler_state *s = new profiler_state();
+                return *s;
+            }
+
+            /// Set while the profiler works on the calling thread, its own allocations are neither sampled nor
+            /// looked up.
+            thread_local bool t_busy = false;
+
+            struct busy_scope
+            {
+                busy_scope() noexcept { t_busy = true; }
+                ~busy_scope() noexcept { t_busy = false; }
+            };
+
+            u64 next_random() noexcept
+            {
+                static thread_local u64 x =
+                    (reinterpret_cast<uintptr_t>(&x) ^ std::chrono::steady_clock::now().time_since_epoch().count()) |
+                    1;
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                return x;
+            }
+
+            /// Exponentially distributed distance to the next sample, which makes the sampled bytes a Poisson
+            /// process.
+            i64 next_interval() noexcept
+            {
+                const double u = static_cast<double>((next_random() >> 11) + 1) * 0x1.0p-53;
+                const double distance = -std::log(u) * static_cast<double>(g_interval.load(std::memory_order_relaxed));
+                return distance < 1.0 ? 1 : static_cast<i64>(distance);
+            }
+
+            ACUL_FORCEINLINE u32 capture_frames(void **frames) noexcept
+            {
+                // The frame of the sampling function is left out
+    #ifdef _WIN32
+                return RtlCaptureStackBackTrace(1, max_depth, frames, nullptr);
+    #else
+                void *buffer[max_depth + 1];
+                const int depth = backtrace(buffer, max_depth + 1);
+                if (depth <= 1) return 0;
+                memcpy(frames, buffer + 1, (depth - 1) * sizeof(void *));
+                return depth - 1;
+    #endif
+            }
+
+            /// Bytes the sampled `bytes` of `count` allocations stand for. An allocation of size s is sampled
+            /// with probability 1 - exp(-s / interval).
+            u64 unsample(u64 count, u64 bytes) noexcept
+            {
+                if (count == 0) return 0;
+                const double mean = static_cast<double>(bytes) / static_cast<double>(count);
+                const double interval = static_cast<double>(g_interval.load(std::memory_order_relaxed));
+                return static_cast<u64>(static_cast<double>(bytes) / (1.0 - std::exp(-mean / interval)));
+            }
+
+            void drop_live(profiler_state &s, const live_sample &sample) noexcept
+            {
+                auto stack = s.stacks.find(sample.stack);
+                if (stack == s.stacks.end()) return;
+                --stack->second.live_allocations;
+                stack->second.live_bytes -= sample.size;
+            }
+
+            vector<stack_record> copy_stacks()
+            {
+                auto &s = state();
+                std::lock_guard<std::mutex> guard(s.lock);
+                vector<stack_record> records;
+                records.reserve(s.stacks.size());
+                for (auto &entry : s.stacks) records.push_back(entry.second);
+                return records;
+            }
+
+            class frame_symbolizer
+            {
+            public:
+                frame_symbolizer()
+                {
+    #ifndef _WIN32
+                    build_exec_table(getpid(), _modules);
+    #endif
+                }
+
+                const string &name(void *frame)
+                {
+                    auto it = _names.find(frame);
+                    if (it != _names.end()) return it->second;
+                    return _names.emplace(frame, resolve(reinterpret_cast<uintptr_t>(frame))).first->second;
+                }
+
+            private:
+                hashmap<void *, string> _names;
+    #ifndef _WIN32
+                exec_table _modules;
+                hashmap<const exec_module *, elf_module> _elf_cache;
+    #endif
+
+                string resolve(uintptr_t ip)
+                {
+    #ifndef _WIN32
+                    // Return addresses point past the call, which may be the first byte of the next function
+                    auto module_it = get_module_by_table(ip - 1, _modules);
+                    if (module_it != _modules.cend() && module_it->is_exec)
+                    {
+                        auto load_it = _elf_cache.find(&(*module_it));
+                        if (load_it == _elf_cache.end())
+                        {
+                            elf_module elf;
+                            if (load_module(module_it->path, elf))
+                                load_it = _elf_cache.emplace(&(*module_it), std::move(elf)).first;
+                        }
+                        if (load_it != _elf_cache.end())
+                        {
+                            auto &elf = load_it->second;
+                            const uintptr_t local = elf.e_type == ET_EXEC ? ip - 1 : ip - 1 - module_it->load_bias;
+                            string name = get_symbol_name_from_elf(elf, local);
+                            if (name != "<unknown>") return name;
+                        }
+                    }
+    #endif
+                    string hex;
+                    fmt::format_to(hex, "0x{:x}", static_cast<u64>(ip));
+                    return hex;
+                }
+            };
+        } // namespace
+
+        void start(size_t sample_interval) noexcept
+        {
+            g_interval.store(sample_interval ? sample_interval : 1, std::memory_order_relaxed);
+            g_running.store(true, std::memory_order_relaxed);
+        }
+
+        void stop() noexcept { g_running.store(false, std::memory_order_relaxed); }
+
+        bool running() noexcept { return g_running.load(std::memory_order_relaxed); }
+
+        void reset()
+        {
+            busy_scope busy;
+            auto &s = state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            for (auto &entry : s.live)
+                detail::heap_sample_filter[detail::heap_sample_slot(entry.first)].fetch_sub(1,
+                                                                                           std::memory_order_relaxed);
+            s.live.clear();
+            s.stacks.clear();
+        }
+
+        void write_pprof(stringstream &stream)
+        {
+            busy_scope busy;
+            vector<stack_record> records = copy_stacks();
+            u64 live_allocations = 0, live_bytes = 0, allocations = 0, bytes = 0;
+            for (auto &r : records)
+            {
+                live_allocations += r.live_allocations;
+                live_bytes += r.live_bytes;
+                allocations += r.allocations;
+                bytes += r.bytes;
+            }
+            fmt::format_to(stream, "heap profile: {}: {} [{}: {}] @ heap_v2/{}\n", live_allocations, live_bytes,
+                           allocations, bytes, g_interval.load(std::memory_order_relaxed));
+            for (auto &r : records)
+            {
+                fmt::format_to(stream, "{}: {} [{}: {}] @", r.live_allocations, r.live_bytes, r.allocations, r.bytes);
+                for (u32 i = 0; i < r.depth; ++i)
+                    fmt::format_to(stream, " 0x{:x}", static_cast<u64>(reinterpret_cast<uintptr_t>(r.frames[i])));
+                stream << '\n';
+            }
+    #ifndef _WIN32
+            vector<char> maps;
+            if (fs::read_virtual("/proc/self/maps", maps))
+            {
+                stream << "\nMAPPED_LIBRARIES:\n";
+                stream << string(maps.data(), maps.size());
+            }
+    #endif
+        }
+
+        void write_folded(stringstream &stream, bool live)
+        {
+            busy_scope busy;
+            vector<stack_record> records = copy_stacks();
+            frame_symbolizer symbolizer;
+            for (auto &r : records)
+            {
+                const u64 value = live ? unsample(r.live_allocations, r.live_bytes) : unsample(r.allocations, r.bytes);
+                if (value == 0 || r.depth == 0) continue;
+                for (u32 i = r.depth; i-- > 0;)
+                {
+                    stream << symbolizer.name(r.frames[i]).c_str();
+                    if (i) stream << ';';
+                }
+                fmt::format_to(stream, " {}\n", value);
+            }
+        }
+    } // namespace heap_profiler
+
+    namespace detail
+    {
+        void heap_profiler_sample(void *p, size_t bytes) noexcept
+        {
+            using namespace heap_profiler;
+            static thread_local bool t_started = false;
+            if (!t_started)
+            {
+                // The countdown of a new thread was never drawn: the block is sampled only when the first
+                // distance falls inside it, as it would have with a countdown running since the thread began
+                t_started = true;
+                const i64 distance = next_interval();
+                if (distance > static_cast<i64>(bytes))
+                {
+                    heap_sample_countdown = distance - static_cast<i64>(bytes);
+                    return;
+                }
+            }
+            heap_sample_countdown = next_interval();
+            if (t_busy || !g_running.load(std::memory_order_relaxed)) return;
+            busy_scope busy;
+
+            stack_record record;
+            record.depth = capture_frames(record.frames);
+            const u64 key = cityhash64(reinterpret_cast<const char *>(record.frames), record.depth * sizeof(void *));
+
+            auto &s = state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            stack_record &stack = s.stacks.emplace(key, record).first->second;
+            ++stack.allocations;
+            stack.bytes += bytes;
+            ++stack.live_allocations;
+            stack.live_bytes += bytes;
+            auto [it, inserted] = s.live.emplace(p, live_sample{key, bytes});
+            if (inserted) heap_sample_filter[heap_sample_slot(p)].fetch_add(1, std::memory_order_relaxed);
+            else
+            {
+                // The block was freed past the allocator, e.g. by a reallocation that failed over
+                drop_live(s, it->second);
+                it->second = live_sample{key, bytes};
+            }
+        }
+
+        void heap_profiler_free(void *p) noexcept
+        {
+            using namespace heap_profiler;
+            if (t_busy) return;
+            busy_scope busy;
+
+            auto &s = state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            auto it = s.live.find(p);
+            if (it == s.live.end()) return;
+            drop_live(s, it->second);
+            s.live.erase(it);
+            heap_sample_filter[heap_sample_slot(p)].fetch_sub(1, std::memory_order_relaxed);
+        }
+    } // namespace detail
+} // namespace acul
+#else
+namespace acul::heap_profiler
+{
+    void start(size_t) noexcept {}
+
+    void stop() noexcept {}
+
+    bool running() noexcept { return false; }
+
+    void reset() {}
+
+    void write_pprof(stringstream &) {}
+
+    void write_folded(stringstream &, bool) {}
+} // namespace acul::heap_profiler
+#endif
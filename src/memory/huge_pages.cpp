@@ -0,0 +1,57 @@
+#include <acul/memory/huge_pages.hpp>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace acul::detail
+{
+    huge_block *map_huge_block(size_t bytes) noexcept
+    {
+        const size_t size = align_up(bytes, huge_page_size);
+#ifdef _WIN32
+        // Large pages need a privilege processes rarely hold, so the block gets regular pages. VirtualAlloc only
+        // aligns to the 64 KiB allocation granularity while huge_block_of needs a huge page boundary: reserve
+        // a huge page more than needed, give it back and map at the boundary inside it. Another thread may
+        // take the range in between, in which case the search starts over.
+        huge_block *block = nullptr;
+        for (int attempt = 0; attempt < 16 && !block; ++attempt)
+        {
+            void *probe = VirtualAlloc(nullptr, size + huge_page_size, MEM_RESERVE, PAGE_NOACCESS);
+            if (!probe) return nullptr;
+            const uintptr_t aligned = align_up(reinterpret_cast<uintptr_t>(probe), huge_page_size);
+            VirtualFree(probe, 0, MEM_RELEASE);
+            block = static_cast<huge_block *>(
+                VirtualAlloc(reinterpret_cast<void *>(aligned), size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+        }
+        if (!block) return nullptr;
+#else
+        // Over-map by a huge page and trim, so the block starts at a huge page boundary
+        void *raw = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+        const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = align_up(start, huge_page_size);
+        if (aligned != start) munmap(raw, aligned - start);
+        const size_t tail = start + huge_page_size - aligned;
+        if (tail) munmap(reinterpret_cast<void *>(aligned + size), tail);
+        auto *block = reinterpret_cast<huge_block *>(aligned);
+    #ifdef MADV_HUGEPAGE
+        madvise(block, size, MADV_HUGEPAGE);
+    #endif
+#endif
+        block->magic = huge_block_magic;
+        block->mapped = size;
+        return block;
+    }
+
+    void unmap_huge_block(huge_block *block) noexcept
+    {
+        block->magic = 0;
+#ifdef _WIN32
+        VirtualFree(block, 0, MEM_RELEASE);
+#else
+        munmap(block, block->mapped);
+#endif
+    }
+} // namespace acul::detail
@@ -0,0 +1,136 @@
+#include <acul/memory/mem_stats.hpp>
+
+#ifdef ACUL_MEM_ACCOUNTING_ENABLE
+    #include <atomic>
+    #include <bit>
+    #include <cstring>
+    #include <mutex>
+
+namespace acul
+{
+    namespace
+    {
+        constexpr u32 max_tags = 64;
+        constexpr u32 shard_count = 16;
+        /// Live bytes a shard may drift from the global total of a tag before it is folded in.
+        constexpr i64 flush_threshold = 64 << 10;
+
+        struct tag_counters
+        {
+            std::atomic<i64> pending{0};
+            std::atomic<u64> allocations{0};
+            std::atomic<u64> frees{0};
+            std::atomic<u64> histogram[mem_histogram_buckets]{};
+        };
+
+        /// Threads are spread over the shards, so concurrent allocations of a tag rarely share a cache line.
+        struct alignas(64) shard
+        {
+            tag_counters tags[max_tags];
+        };
+
+        struct tag_totals
+        {
+            std::atomic<i64> live{0};
+            std::atomic<i64> peak{0};
+        };
+
+        shard g_shards[shard_count];
+        tag_totals g_totals[max_tags];
+
+        std::mutex g_registry_lock;
+        const char *g_tag_names[max_tags] = {"untagged"};
+        std::atomic<u32> g_tag_count{1};
+
+        tag_counters &local_counters(u32 tag) noexcept
+        {
+            static std::atomic<u32> next_shard{0};
+            static thread_local u32 index = next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+            return g_shards[index].tags[tag];
+        }
+
+        size_t histogram_bucket(size_t bytes) noexcept
+        {
+            if (bytes <= 16) return 0;
+            const size_t bucket = std::bit_width(bytes - 1) - 4;
+            return bucket < mem_histogram_buckets ? bucket : mem_histogram_buckets - 1;
+        }
+
+        void add_live(u32 tag, tag_counters &counters, i64 delta) noexcept
+        {
+            const i64 pending = counters.pending.fetch_add(delta, std::memory_order_relaxed) + delta;
+            if (pending < flush_threshold && pending > -flush_threshold) return;
+
+            const i64 flushed = counters.pending.exchange(0, std::memory_order_relaxed);
+            tag_totals &totals = g_totals[tag];
+            const i64 live = totals.live.fetch_add(flushed, std::memory_order_relaxed) + flushed;
+            i64 peak = totals.peak.load(std::memory_order_relaxed);
+            while (live > peak && !totals.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+                ;
+        }
+    } // namespace
+
+    namespace detail
+    {
+        u32 register_mem_tag(const char *name) noexcept
+        {
+            std::lock_guard<std::mutex> guard(g_registry_lock);
+            const u32 count = g_tag_count.load(std::memory_order_relaxed);
+            for (u32 i = 1; i < count; ++i)
+                if (strcmp(g_tag_names[i], name) == 0) return i;
+            // Tags past the limit are counted as untagged memory
+            if (count == max_tags) return 0;
+            g_tag_names[count] = name;
+            g_tag_count.store(count + 1, std::memory_order_release);
+            return count;
+        }
+
+        void account_alloc(u32 tag, size_t bytes) noexcept
+        {
+            tag_counters &counters = local_counters(tag);
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.histogram[histogram_bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+            add_live(tag, counters, static_cast<i64>(bytes));
+        }
+
+        void account_free(u32 tag, size_t bytes) noexcept
+        {
+            tag_counters &counters = local_counters(tag);
+            counters.frees.fetch_add(1, std::memory_order_relaxed);
+            add_live(tag, counters, -static_cast<i64>(bytes));
+        }
+    } // namespace detail
+
+    vector<mem_tag_stats> mem_stats_snapshot()
+    {
+        const u32 count = g_tag_count.load(std::memory_order_acquire);
+        vector<mem_tag_stats> stats(count);
+        for (u32 tag = 0; tag < count; ++tag)
+        {
+            mem_tag_stats &s = stats[tag];
+            memset(&s, 0, sizeof(s));
+            s.name = g_tag_names[tag];
+            i64 live = g_totals[tag].live.load(std::memory_order_relaxed);
+            for (const shard &sh : g_shards)
+            {
+                const tag_counters &counters = sh.tags[tag];
+                live += counters.pending.load(std::memory_order_relaxed);
+                s.allocations += counters.allocations.load(std::memory_order_relaxed);
+                s.frees += counters.frees.load(std::memory_order_relaxed);
+                for (size_t b = 0; b < mem_histogram_buckets; ++b)
+                    s.histogram[b] += counters.histogram[b].load(std::memory_order_relaxed);
+            }
+            // Frees seen before the matching allocations can push a racing sum below zero
+            s.live_bytes = live > 0 ? static_cast<size_t>(live) : 0;
+            const i64 peak = g_totals[tag].peak.load(std::memory_order_relaxed);
+            s.peak_bytes = static_cast<size_t>(peak) > s.live_bytes ? static_cast<size_t>(peak) : s.live_bytes;
+        }
+        return stats;
+    }
+} // namespace acul
+#else
+namespace acul
+{
+    vector<mem_tag_stats> mem_stats_snapshot() { return {}; }
+} // namespace acul
+#endif
@@ -0,0 +1,55 @@
+#include <acul/memory/pool.hpp>
+#include <mutex>
+
+namespace acul::detail
+{
+    /// Guards the idle lists of all size classes, taken only when threads come and go.
+    static std::mutex g_pool_idle_lock;
+
+    pool_cache *pool_attach(pool_class &cls) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> guard(g_pool_idle_lock);
+            if (pool_cache *cache = cls.idle)
+            {
+                cls.idle = cache->next_idle;
+                cache->next_idle = nullptr;
+                return cache;
+            }
+        }
+        pool_cache *cache = alloc<pool_cache>();
+        cache->cls = &cls;
+        return cache;
+    }
+
+    void pool_detach(pool_cache *cache) noexcept
+    {
+        std::lock_guard<std::mutex> guard(g_pool_idle_lock);
+        cache->next_idle = cache->cls->idle;
+        cache->cls->idle = cache;
+    }
+
+    void *pool_refill(pool_cache *cache) noexcept
+    {
+        if (pool_free_node *returned = cache->returned.exchange(nullptr, std::memory_order_acquire))
+        {
+            cache->free = returned->next;
+            return returned;
+        }
+
+        const size_t size = cache->cls->object_size;
+        if (static_cast<size_t>(cache->end - cache->cursor) < size)
+        {
+            auto *slab = static_cast<pool_slab *>(scalable_aligned_malloc(pool_slab_size, pool_slab_size));
+            if (!slab) return nullptr;
+            slab->owner = cache;
+            cache->cls->slabs.fetch_add(1, std::memory_order_relaxed);
+            cache->cursor = reinterpret_cast<char *>(slab) + align_up(sizeof(pool_slab), cache->cls->alignment);
+            cache->end = reinterpret_cast<char *>(slab) + pool_slab_size;
+        }
+        // Objects are carved on demand, so a fresh slab costs no pass over its memory
+        void *p = cache->cursor;
+        cache->cursor += size;
+        return p;
+    }
+} // namespace acul::detail
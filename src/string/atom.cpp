@@ -0,0 +1,244 @@
+#include <acul/exception/exception.hpp>
+#include <acul/memory/alloc.hpp>
+#include <acul/string/atom.hpp>
+#include <acul/vector.hpp>
+#include <cstring>
+#include <mutex>
+
+namespace acul
+{
+    namespace
+    {
+        constexpr u32 shard_bits = 4;
+        constexpr u32 shard_count = 1u << shard_bits;
+        /// Per-shard sequence numbers fill the id bits left by the shard index and the counted flag.
+        constexpr u32 max_sequence = detail::atom_counted >> shard_bits;
+        constexpr size_t initial_capacity = 64;
+        constexpr size_t arena_block_size = 64 << 10;
+
+        /// Marks a slot whose entry was released, lookups probe past it.
+        detail::atom_rep *const tombstone = reinterpret_cast<detail::atom_rep *>(alignof(detail::atom_rep));
+
+        struct slot_array
+        {
+            size_t mask;
+            std::atomic<detail::atom_rep *> items[];
+        };
+
+        slot_array *alloc_slots(size_t capacity)
+        {
+            auto *slots = reinterpret_cast<slot_array *>(
+                alloc_n<char>(sizeof(slot_array) + capacity * sizeof(std::atomic<detail::atom_rep *>)));
+            slots->mask = capacity - 1;
+            for (size_t i = 0; i < capacity; ++i) new (&slots->items[i]) std::atomic<detail::atom_rep *>(nullptr);
+            return slots;
+        }
+
+        void release_slots(slot_array *slots) { release(reinterpret_cast<char *>(slots)); }
+
+        size_t rep_size(size_t len) { return offsetof(detail::atom_rep, data) + len + 1; }
+
+        detail::atom_rep *probe(const slot_array *slots, string_view str, size_t hash)
+        {
+            for (size_t i = hash & slots->mask;; i = (i + 1) & slots->mask)
+            {
+                detail::atom_rep *rep = slots->items[i].load(std::memory_order_acquire);
+                if (!rep) return nullptr;
+                if (rep != tombstone && rep->hash == hash && rep->len == str.size() &&
+                    memcmp(rep->data, str.data(), str.size()) == 0)
+                    return rep;
+            }
+        }
+    } // namespace
+
+    struct atom_table::shard
+    {
+        std::mutex lock;
+        std::atomic<slot_array *> slots{nullptr};
+        /// Occupied slots, tombstones included.
+        size_t used = 0;
+        std::atomic<size_t> live{0};
+        u32 sequence = 1;
+
+        /// Arena of permanent entries, along with slot arrays replaced while readers may still use them.
+        vector<char *> blocks;
+        vector<slot_array *> retired;
+        char *cursor = nullptr;
+        size_t left = 0;
+
+        char *allocate(size_t size)
+        {
+            size = (size + alignof(detail::atom_rep) - 1) & ~(alignof(detail::atom_rep) - 1);
+            if (size > arena_block_size / 4)
+            {
+                blocks.push_back(alloc_n<char>(size));
+                return blocks.back();
+            }
+            if (size > left)
+            {
+                cursor = alloc_n<char>(arena_block_size);
+                left = arena_block_size;
+                blocks.push_back(cursor);
+            }
+            char *p = cursor;
+            cursor += size;
+            left -= size;
+            return p;
+        }
+
+        /// Keeps the load factor at or below 1/2, dropping tombstones on the way.
+        void reserve_slot(bool refcounted)
+        {
+            slot_array *old = slots.load(std::memory_order_relaxed);
+            const size_t capacity = old ? old->mask + 1 : 0;
+            if ((used + 1) * 2 <= capacity) return;
+            const size_t count = live.load(std::memory_order_relaxed) + 1;
+            size_t new_capacity = capacity ? capacity : initial_capacity;
+            while (count * 2 > new_capacity) new_capacity *= 2;
+
+            slot_array *grown = alloc_slots(new_capacity);
+            if (old)
+                for (size_t i = 0; i < capacity; ++i)
+                {
+                    detail::atom_rep *rep = old->items[i].load(std::memory_order_relaxed);
+                    if (!rep || rep == tombstone) continue;
+                    size_t j = rep->hash & grown->mask;
+                    while (grown->items[j].load(std::memory_order_relaxed)) j = (j + 1) & grown->mask;
+                    grown->items[j].store(rep, std::memory_order_relaxed);
+                }
+            used = live.load(std::memory_order_relaxed);
+            slots.store(grown, std::memory_order_release);
+            // Lock-free readers may still probe the old array
+            if (old)
+            {
+                if (refcounted) release_slots(old);
+                else retired.push_back(old);
+            }
+        }
+    };
+
+    atom_table::atom_table(bool refcounted) : _shards(alloc_n<shard>(shard_count)), _refcounted(refcounted) {}
+
+    atom_table::~atom_table()
+    {
+        for (u32 s = 0; s < shard_count; ++s)
+        {
+            shard &sh = _shards[s];
+            slot_array *slots = sh.slots.load(std::memory_order_relaxed);
+            if (_refcounted && slots)
+                for (size_t i = 0; i <= slots->mask; ++i)
+                {
+                    detail::atom_rep *rep = slots->items[i].load(std::memory_order_relaxed);
+                    if (rep && rep != tombstone) release(reinterpret_cast<char *>(rep));
+                }
+            if (slots) release_slots(slots);
+            for (slot_array *old : sh.retired) release_slots(old);
+            for (char *block : sh.blocks) release(block);
+        }
+        release(_shards, shard_count);
+    }
+
+    atom atom_table::intern(string_view str)
+    {
+        const size_t hash = std::hash<string_view>()(str);
+        shard &sh = _shards[hash >> (64 - shard_bits)];
+        if (!_refcounted)
+        {
+            // Entries are never removed, so a hit needs no lock
+            const slot_array *slots = sh.slots.load(std::memory_order_acquire);
+            if (slots)
+                if (detail::atom_rep *rep = probe(slots, str, hash)) return atom(rep);
+        }
+
+        std::lock_guard<std::mutex> guard(sh.lock);
+        if (const slot_array *slots = sh.slots.load(std::memory_order_relaxed))
+            if (detail::atom_rep *rep = probe(slots, str, hash))
+            {
+                if (_refcounted) rep->count.fetch_add(1, std::memory_order_relaxed);
+                return atom(rep);
+            }
+
+        if (sh.sequence == max_sequence) throw runtime_error("atom_table: id space exhausted");
+        sh.reserve_slot(_refcounted);
+
+        const size_t bytes = rep_size(str.size());
+        auto *rep =
+            reinterpret_cast<detail::atom_rep *>(_refcounted ? alloc_n<char>(bytes) : sh.allocate(bytes));
+        new (&rep->count) std::atomic<size_t>(_refcounted ? 1 : detail::atom_permanent);
+        rep->len = str.size();
+        rep->hash = hash;
+        rep->table = this;
+        rep->id = (sh.sequence++ << shard_bits) | static_cast<u32>(&sh - _shards);
+        if (_refcounted) rep->id |= detail::atom_counted;
+        memcpy(rep->data, str.data(), str.size());
+        rep->data[str.size()] = '\0';
+
+        slot_array *slots = sh.slots.load(std::memory_order_relaxed);
+        size_t i = hash & slots->mask;
+        while (slots->items[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & slots->mask;
+        slots->items[i].store(rep, std::memory_order_release);
+        ++sh.used;
+        sh.live.fetch_add(1, std::memory_order_relaxed);
+        return atom(rep);
+    }
+
+    atom atom_table::find(string_view str) const
+    {
+        const size_t hash = std::hash<string_view>()(str);
+        shard &sh = _shards[hash >> (64 - shard_bits)];
+        if (!_refcounted)
+        {
+            const slot_array *slots = sh.slots.load(std::memory_order_acquire);
+            detail::atom_rep *rep = slots ? probe(slots, str, hash) : nullptr;
+            return rep ? atom(rep) : atom();
+        }
+
+        std::lock_guard<std::mutex> guard(sh.lock);
+        const slot_array *slots = sh.slots.load(std::memory_order_relaxed);
+        detail::atom_rep *rep = slots ? probe(slots, str, hash) : nullptr;
+        if (!rep) return atom();
+        rep->count.fetch_add(1, std::memory_order_relaxed);
+        return atom(rep);
+    }
+
+    size_t atom_table::size() const noexcept
+    {
+        size_t total = 0;
+        for (u32 s = 0; s < shard_count; ++s) total += _shards[s].live.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    atom_table &atom_table::global()
+    {
+        static atom_table *table = alloc<atom_table>();
+        return *table;
+    }
+
+    void atom_table::erase(detail::atom_rep *rep) noexcept
+    {
+        shard &sh = _shards[rep->hash >> (64 - shard_bits)];
+        {
+            std::lock_guard<std::mutex> guard(sh.lock);
+            // intern() may have taken a new reference before the lock was ours
+            if (rep->count.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            slot_array *slots = sh.slots.load(std::memory_order_relaxed);
+            size_t i = rep->hash & slots->mask;
+            while (slots->items[i].load(std::memory_order_relaxed) != rep) i = (i + 1) & slots->mask;
+            slots->items[i].store(tombstone, std::memory_order_relaxed);
+            sh.live.fetch_sub(1, std::memory_order_relaxed);
+        }
+        release(reinterpret_cast<char *>(rep));
+    }
+
+    namespace detail
+    {
+        void release_atom(atom_rep *rep) noexcept
+        {
+            // Only the last reference goes through the table, intern() revives entries under its lock
+            size_t count = rep->count.load(std::memory_order_relaxed);
+            while (count > 1)
+                if (rep->count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel)) return;
+            rep->table->erase(rep);
+        }
+    } // namespace detail
+} // namespace acul
@@ -0,0 +1,907 @@
+#include <acul/bit.hpp>
+#include <acul/string/utils.hpp>
+#include <cctype>
+#include <cfloat>
+#include <cstring>
+#include "float_table.hpp"
+
+// Shortest round-trip conversion follows Schubfach (R. Giulietti, "The Schubfach way to render doubles"):
+// the rounding interval of the binary value is scaled by one 126-bit power of ten and the shortest
+// decimal inside it is picked with a handful of 64-bit multiplications.
+//
+// Parsing follows Eisel-Lemire (D. Lemire, "Number Parsing at a Gigabyte per Second"): up to 19 significant
+// digits are multiplied by a 128-bit power of five, which decides the rounding in all but the inputs with
+// more digits; those fall back to an exact big integer comparison against the halfway point.
+namespace acul
+{
+    namespace
+    {
+        constexpr u64 mask63 = (u64(1) << 63) - 1;
+
+        ACUL_FORCEINLINE u64 mulhi(u64 a, u64 b)
+        {
+            return static_cast<u64>((static_cast<__uint128_t>(a) * b) >> 64);
+        }
+
+        // floor(e * log10(2))
+        ACUL_FORCEINLINE int flog10pow2(int e) { return static_cast<int>((e * 661971961083LL) >> 41); }
+
+        // floor(log10(3/4 * 2^e))
+        ACUL_FORCEINLINE int flog10_three_quarters_pow2(int e)
+        {
+            return static_cast<int>((e * 661971961083LL - 274743187321LL) >> 41);
+        }
+
+        // floor(e * log2(10))
+        ACUL_FORCEINLINE int flog2pow10(int e) { return static_cast<int>((e * 913124641741LL) >> 38); }
+
+        template <typename T>
+        struct float_traits;
+
+        template <>
+        struct float_traits<f64>
+        {
+            using bits_type = u64;
+            static constexpr int precision = 53;
+            static constexpr int q_min = -1074;
+            static constexpr u64 c_tiny = 3;
+        };
+
+        template <>
+        struct float_traits<f32>
+        {
+            using bits_type = u32;
+            static constexpr int precision = 24;
+            static constexpr int q_min = -149;
+            static constexpr u64 c_tiny = 8;
+        };
+
+        /// Value as the exact binary m * 2^e and the shortest decimal s * 10^k that reads back as it.
+        struct decimal_fp
+        {
+            enum
+            {
+                finite,
+                zero,
+                infinity,
+                nan
+            } kind;
+            bool negative;
+            u64 m;
+            int e;
+            u64 s;
+            int k;
+        };
+
+        ACUL_FORCEINLINE u64 round_to_odd(u64 g1, u64 g0, u64 cp)
+        {
+            u64 x1 = mulhi(g0, cp);
+            u64 y0 = g1 * cp;
+            u64 y1 = mulhi(g1, cp);
+            u64 z = (y0 >> 1) + x1;
+            u64 vbp = y1 + (z >> 63);
+            return vbp | (((z & mask63) + mask63) >> 63);
+        }
+
+        ACUL_FORCEINLINE u64 round_to_odd(u64 g, u64 cp)
+        {
+            u64 x1 = mulhi(g, cp);
+            u64 vbp = x1 >> 31;
+            return vbp | (((x1 & 0xFFFFFFFFull) + 0xFFFFFFFFull) >> 32);
+        }
+
+        template <typename T>
+        void to_decimal(int q, u64 c, int dk, decimal_fp &d)
+        {
+            constexpr u64 c_min = u64(1) << (float_traits<T>::precision - 1);
+            const u64 out = c & 0x1;
+            const u64 cb = c << 2;
+            const u64 cbr = cb + 2;
+            u64 cbl;
+            int k;
+            if (c != c_min || q == float_traits<T>::q_min)
+            {
+                cbl = cb - 2;
+                k = flog10pow2(q);
+            }
+            else
+            {
+                cbl = cb - 1;
+                k = flog10_three_quarters_pow2(q);
+            }
+
+            const u64 *g = detail::pow10_g[k - detail::pow10_k_min];
+            u64 vb, vbl, vbr;
+            if constexpr (std::is_same_v<T, f64>)
+            {
+                const int h = q + flog2pow10(-k) + 2;
+                vb = round_to_odd(g[0], g[1], cb << h);
+                vbl = round_to_odd(g[0], g[1], cbl << h);
+                vbr = round_to_odd(g[0], g[1], cbr << h);
+            }
+            else
+            {
+                const int h = q + flog2pow10(-k) + 33;
+                vb = round_to_odd(g[0] + 1, cb << h);
+                vbl = round_to_odd(g[0] + 1, cbl << h);
+                vbr = round_to_odd(g[0] + 1, cbr << h);
+            }
+
+            const u64 s = vb >> 2;
+            if (s >= 100)
+            {
+                // Try the candidates one digit shorter first
+                const u64 sp10 = s / 10 * 10;
+                const u64 tp10 = sp10 + 10;
+                const bool upin = vbl + out <= sp10 << 2;
+                const bool wpin = (tp10 << 2) + out <= vbr;
+                if (upin != wpin)
+                {
+                    d.s = upin ? sp10 : tp10;
+                    d.k = k;
+                    return;
+                }
+            }
+            const u64 t = s + 1;
+            const bool uin = vbl + out <= s << 2;
+            const bool win = (t << 2) + out <= vbr;
+            d.k = k + dk;
+            if (uin != win)
+            {
+                d.s = uin ? s : t;
+                return;
+            }
+            const i64 cmp = static_cast<i64>(vb - ((s + t) << 1));
+            d.s = cmp < 0 || (cmp == 0 && (s & 0x1) == 0) ? s : t;
+        }
+
+        /// Minimal fixed-capacity big integer used to break decimal rounding ties exactly.
+        class bigint
+        {
+        public:
+            explicit bigint(u64 value)
+            {
+                _limbs[0] = static_cast<u32>(value);
+                _limbs[1] = static_cast<u32>(value >> 32);
+                _size = _limbs[1] ? 2 : 1;
+            }
+
+            void mul_small(u32 value, u32 add = 0)
+            {
+                u64 carry = add;
+                for (int i = 0; i < _size; ++i)
+                {
+                    u64 product = static_cast<u64>(_limbs[i]) * value + carry;
+                    _limbs[i] = static_cast<u32>(product);
+                    carry = product >> 32;
+                }
+                if (carry) _limbs[_size++] = static_cast<u32>(carry);
+            }
+
+            void mul_pow10(int n)
+            {
+                for (; n >= 9; n -= 9) mul_small(1000000000u);
+                static constexpr u32 small_pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+                if (n) mul_small(small_pow10[n]);
+            }
+
+            void shift_left(int n)
+            {
+                const int words = n / 32;
+                const int bits = n % 32;
+                if (bits)
+                {
+                    u32 carry = 0;
+                    for (int i = 0; i < _size; ++i)
+                    {
+                        u32 next = _limbs[i] >> (32 - bits);
+                        _limbs[i] = (_limbs[i] << bits) | carry;
+                        carry = next;
+                    }
+                    if (carry) _limbs[_size++] = carry;
+                }
+                if (words)
+                {
+                    memmove(_limbs + words, _limbs, _size * sizeof(u32));
+                    memset(_limbs, 0, words * sizeof(u32));
+                    _size += words;
+                }
+            }
+
+            void mul_pow5(int n)
+            {
+                for (; n >= 13; n -= 13) mul_small(1220703125u);
+                static constexpr u32 small_pow5[] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+                                                     48828125, 244140625};
+                if (n) mul_small(small_pow5[n]);
+            }
+
+            /// Divides in place and returns the remainder.
+            u32 div_small(u32 value)
+            {
+                u64 rem = 0;
+                for (int i = _size - 1; i >= 0; --i)
+                {
+                    u64 cur = (rem << 32) | _limbs[i];
+                    _limbs[i] = static_cast<u32>(cur / value);
+                    rem = cur % value;
+                }
+                while (_size > 1 && _limbs[_size - 1] == 0) --_size;
+                return static_cast<u32>(rem);
+            }
+
+            bool is_zero() const { return _size == 1 && _limbs[0] == 0; }
+
+            int compare(const bigint &other) const
+            {
+                if (_size != other._size) return _size < other._size ? -1 : 1;
+                for (int i = _size - 1; i >= 0; --i)
+                    if (_limbs[i] != other._limbs[i]) return _limbs[i] < other._limbs[i] ? -1 : 1;
+                return 0;
+            }
+
+        private:
+            // 10^341 * 2^53 and 5^1074 * 2^53, the widest values built here, fit well within 4096 bits
+            u32 _limbs[128];
+            int _size;
+        };
+
+        /**
+         * @brief Drops the extra digit the scaled subnormal path produces when one digit is enough.
+         *
+         * Two-digit results of the smallest subnormals only ever try the next digit string up or down; the
+         * one-digit neighbours are checked against the exact rounding interval [2m - 1, 2m + 1] * 2^(e - 1).
+         */
+        void shorten_tiny(decimal_fp &d)
+        {
+            const u64 high = d.s / 10;
+            auto inside = [&](u64 candidate) {
+                // candidate * 10^(k + 1) vs (2m +- 1) * 2^(e - 1), scaled by 2^(1 - e) * 10^-(k + 1)
+                bigint value(candidate), lower(2 * d.m - 1), upper(2 * d.m + 1);
+                value.shift_left(1 - d.e);
+                lower.mul_pow10(-(d.k + 1));
+                upper.mul_pow10(-(d.k + 1));
+                const int cl = value.compare(lower), cu = value.compare(upper);
+                return (d.m & 0x1) ? cl > 0 && cu < 0 : cl >= 0 && cu <= 0;
+            };
+            const bool down = high > 0 && inside(high), up = inside(high + 1);
+            if (!down && !up) return;
+            const u64 rest = d.s % 10;
+            d.s = down && (!up || rest < 5 || (rest == 5 && (high & 0x1) == 0)) ? high : high + 1;
+            ++d.k;
+        }
+
+        template <typename T>
+        void decompose(T value, decimal_fp &d)
+        {
+            using traits = float_traits<T>;
+            using bits_type = typename traits::bits_type;
+            constexpr int bits_count = sizeof(T) * 8;
+            constexpr int p = traits::precision;
+            constexpr u32 exp_mask = (u32(1) << (bits_count - p)) - 1;
+
+            bits_type bits;
+            memcpy(&bits, &value, sizeof(T));
+            d.negative = (bits >> (bits_count - 1)) != 0;
+            const u32 bq = static_cast<u32>(bits >> (p - 1)) & exp_mask;
+            const u64 t = bits & ((u64(1) << (p - 1)) - 1);
+
+            if (bq == exp_mask)
+            {
+                d.kind = t ? decimal_fp::nan : decimal_fp::infinity;
+                return;
+            }
+            d.kind = decimal_fp::finite;
+            if (bq != 0)
+            {
+                const int mq = -traits::q_min + 1 - static_cast<int>(bq);
+                const u64 c = (u64(1) << (p - 1)) | t;
+                d.m = c;
+                d.e = -mq;
+                // Integers below 2^p are their own shortest representation
+                if (0 < mq && mq < p && ((c >> mq) << mq) == c)
+                {
+                    d.s = c >> mq;
+                    d.k = 0;
+                }
+                else to_decimal<T>(-mq, c, 0, d);
+            }
+            else if (t != 0)
+            {
+                d.m = t;
+                d.e = traits::q_min;
+                if (t < traits::c_tiny) to_decimal<T>(traits::q_min, 10 * t, -1, d);
+                else to_decimal<T>(traits::q_min, t, 0, d);
+                if (d.s < 100) shorten_tiny(d);
+            }
+            else
+            {
+                d.kind = decimal_fp::zero;
+                return;
+            }
+
+            while (d.s % 10 == 0)
+            {
+                d.s /= 10;
+                ++d.k;
+            }
+        }
+
+        /// Compares the exact binary value with its shortest decimal representation.
+        int compare_exact(const decimal_fp &d)
+        {
+            bigint lhs(d.m), rhs(d.s);
+            if (d.e >= 0) lhs.shift_left(d.e);
+            else rhs.shift_left(-d.e);
+            if (d.k >= 0) rhs.mul_pow10(d.k);
+            else lhs.mul_pow10(-d.k);
+            return lhs.compare(rhs);
+        }
+
+        /// Largest number of significant digits in the exact decimal expansion of a double.
+        constexpr int max_exact_digits = 768;
+
+        /**
+         * @brief Writes every significant digit of the exact binary value m * 2^e.
+         *
+         * Used when the output asks for more digits than the shortest form has, so they match printf
+         * instead of being padded with zeros.
+         */
+        void exact_digits(const decimal_fp &d, char *digits, int &n, int &dp)
+        {
+            // m * 2^e == m * 5^-e / 10^-e for negative exponents
+            bigint value(d.m);
+            int point = 0;
+            if (d.e >= 0) value.shift_left(d.e);
+            else
+            {
+                value.mul_pow5(-d.e);
+                point = -d.e;
+            }
+
+            char reversed[max_exact_digits + 9];
+            int count = 0;
+            while (!value.is_zero())
+            {
+                u32 chunk = value.div_small(1000000000u);
+                for (int i = 0; i < 9; ++i, chunk /= 10) reversed[count++] = static_cast<char>('0' + chunk % 10);
+            }
+            while (count > 0 && reversed[count - 1] == '0') --count;
+            dp = count - point;
+            int first = 0;
+            while (first < count && reversed[first] == '0') ++first;
+            n = count - first;
+            for (int i = 0; i < n; ++i) digits[i] = reversed[count - 1 - i];
+        }
+
+        /**
+         * @brief Rounds the digit string to its first `keep` digits, half to even on the exact value.
+         *
+         * Trailing zeros are dropped, so `n` may become 0 when the value rounds to zero.
+         * @param exact Whether the digits are the exact expansion rather than the shortest form.
+         */
+        void round_digits(char *digits, int &n, int &dp, int keep, const decimal_fp &d, bool exact)
+        {
+            if (keep >= n) return;
+            if (keep < 0)
+            {
+                n = 0;
+                return;
+            }
+
+            bool up;
+            const char next = digits[keep];
+            if (next != '5') up = next > '5';
+            else if (keep + 1 < n) up = true;
+            else
+            {
+                // The shortest form ends in 5 right at the cut: only the exact value decides
+                const int cmp = exact ? 0 : compare_exact(d);
+                up = cmp > 0 || (cmp == 0 && keep > 0 && ((digits[keep - 1] - '0') & 1));
+            }
+
+            n = keep;
+            if (up)
+            {
+                int i = keep - 1;
+                while (i >= 0 && digits[i] == '9') --i;
+                if (i < 0)
+                {
+                    digits[0] = '1';
+                    n = 1;
+                    ++dp;
+                }
+                else
+                {
+                    ++digits[i];
+                    n = i + 1;
+                }
+            }
+            else
+                while (n > 0 && digits[n - 1] == '0') --n;
+        }
+
+        ACUL_FORCEINLINE int exponent_length(int x) { return (x <= -100 || x >= 100) ? 5 : 4; }
+
+        int write_fixed(char *buffer, size_t size, bool negative, const char *digits, int n, int dp, int precision)
+        {
+            const int int_len = dp > 0 ? dp : 1;
+            const size_t len = negative + int_len + (precision > 0 ? precision + 1 : 0);
+            if (len > size) return 0;
+
+            char *p = buffer;
+            if (negative) *p++ = '-';
+            if (dp <= 0) *p++ = '0';
+            else
+            {
+                const int copied = dp < n ? dp : n;
+                memcpy(p, digits, copied);
+                memset(p + copied, '0', dp - copied);
+                p += dp;
+            }
+            if (precision > 0)
+            {
+                *p++ = '.';
+                int leading = dp < 0 ? -dp : 0;
+                if (leading > precision) leading = precision;
+                memset(p, '0', leading);
+                const int from = dp > 0 ? dp : 0;
+                int copied = n - from;
+                if (copied > precision - leading) copied = precision - leading;
+                if (copied < 0) copied = 0;
+                memcpy(p + leading, digits + from, copied);
+                memset(p + leading + copied, '0', precision - leading - copied);
+                p += precision;
+            }
+            return static_cast<int>(p - buffer);
+        }
+
+        int write_scientific(char *buffer, size_t size, bool negative, const char *digits, int n, int dp,
+                             int precision)
+        {
+            const int x = n ? dp - 1 : 0;
+            const size_t len = negative + 1 + (precision > 0 ? precision + 1 : 0) + exponent_length(x);
+            if (len > size) return 0;
+
+            char *p = buffer;
+            if (negative) *p++ = '-';
+            *p++ = n ? digits[0] : '0';
+            if (precision > 0)
+            {
+                *p++ = '.';
+                int copied = n > 1 ? n - 1 : 0;
+                if (copied > precision) copied = precision;
+                memcpy(p, digits + 1, copied);
+                memset(p + copied, '0', precision - copied);
+                p += precision;
+            }
+            *p++ = 'e';
+            *p++ = x < 0 ? '-' : '+';
+            int ax = x < 0 ? -x : x;
+            if (ax >= 100)
+            {
+                *p++ = static_cast<char>('0' + ax / 100);
+                ax %= 100;
+            }
+            *p++ = static_cast<char>('0' + ax / 10);
+            *p++ = static_cast<char>('0' + ax % 10);
+            return static_cast<int>(p - buffer);
+        }
+
+        template <typename T>
+        int format_float(T value, char *buffer, size_t size, float_format format, int precision)
+        {
+            decimal_fp d;
+            decompose(value, d);
+            if (d.kind == decimal_fp::infinity || d.kind == decimal_fp::nan)
+            {
+                const char *text = d.kind == decimal_fp::nan ? "-nan" : "-inf";
+                if (!d.negative) ++text;
+                const size_t len = strlen(text);
+                if (len > size) return 0;
+                memcpy(buffer, text, len);
+                return static_cast<int>(len);
+            }
+
+            char digits[max_exact_digits];
+            int n = 0, dp = 1;
+            if (d.kind == decimal_fp::finite)
+            {
+                n = to_string(d.s, digits);
+                dp = n + d.k;
+            }
+
+            // Switches to the exact expansion when the shortest digits run out before `keep`
+            bool exact = false;
+            auto need_digits = [&](int keep) {
+                if (keep <= n || d.kind != decimal_fp::finite) return;
+                exact_digits(d, digits, n, dp);
+                exact = true;
+            };
+
+            switch (format)
+            {
+                case float_format::fixed:
+                    if (precision < 0)
+                    {
+                        // Large integers print their exact digits, as the closest of equally short forms
+                        if (d.kind == decimal_fp::finite && dp > n && d.e > 0) need_digits(dp);
+                        precision = n > dp ? n - dp : 0;
+                    }
+                    else
+                    {
+                        need_digits(dp + precision);
+                        round_digits(digits, n, dp, dp + precision, d, exact);
+                    }
+                    return write_fixed(buffer, size, d.negative, digits, n, dp, precision);
+                case float_format::scientific:
+                    if (precision < 0) precision = n > 1 ? n - 1 : 0;
+                    else
+                    {
+                        need_digits(precision + 1);
+                        round_digits(digits, n, dp, precision + 1, d, exact);
+                    }
+                    return write_scientific(buffer, size, d.negative, digits, n, dp, precision);
+                case float_format::general:
+                {
+                    const int p = precision < 0 ? 6 : (precision == 0 ? 1 : precision);
+                    need_digits(p);
+                    round_digits(digits, n, dp, p, d, exact);
+                    const int x = n ? dp - 1 : 0;
+                    if (x >= -4 && x < p)
+                        return write_fixed(buffer, size, d.negative, digits, n, dp, n > dp ? n - dp : 0);
+                    return write_scientific(buffer, size, d.negative, digits, n, dp, n > 1 ? n - 1 : 0);
+                }
+                default:
+                {
+                    const int fixed_len = dp <= 0 ? 2 - dp + n : (dp < n ? n + 1 : dp);
+                    const int sci_len = n + (n > 1) + exponent_length(n ? dp - 1 : 0);
+                    if (fixed_len <= sci_len)
+                    {
+                        if (d.kind == decimal_fp::finite && dp > n && d.e > 0) need_digits(dp);
+                        return write_fixed(buffer, size, d.negative, digits, n, dp, n > dp ? n - dp : 0);
+                    }
+                    return write_scientific(buffer, size, d.negative, digits, n, dp, n > 1 ? n - 1 : 0);
+                }
+            }
+        }
+
+        template <typename T>
+        struct parse_traits;
+
+        template <>
+        struct parse_traits<f64>
+        {
+            using bits_type = u64;
+            static constexpr int mantissa_bits = 52;
+            static constexpr int min_exponent = -1023;
+            static constexpr int infinite_power = 0x7FF;
+            static constexpr int min_pow10 = -342;
+            static constexpr int max_pow10 = 308;
+            static constexpr int min_round_to_even = -4;
+            static constexpr int max_round_to_even = 23;
+            static constexpr int max_exact_pow10 = 22;
+            static constexpr u64 max_exact_mantissa = u64(1) << 53;
+            static constexpr f64 exact_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        };
+
+        template <>
+        struct parse_traits<f32>
+        {
+            using bits_type = u32;
+            static constexpr int mantissa_bits = 23;
+            static constexpr int min_exponent = -127;
+            static constexpr int infinite_power = 0xFF;
+            static constexpr int min_pow10 = -64;
+            static constexpr int max_pow10 = 38;
+            static constexpr int min_round_to_even = -17;
+            static constexpr int max_round_to_even = 10;
+            static constexpr int max_exact_pow10 = 10;
+            static constexpr u64 max_exact_mantissa = u64(1) << 24;
+            static constexpr f32 exact_pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                                  1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        };
+
+        /// Binary result as the biased exponent and the mantissa without the hidden bit.
+        struct adjusted_mantissa
+        {
+            u64 mantissa;
+            int power2;
+
+            bool operator==(const adjusted_mantissa &other) const
+            {
+                return mantissa == other.mantissa && power2 == other.power2;
+            }
+        };
+
+        /// Correctly rounded w * 10^q for an exact w.
+        template <typename T>
+        adjusted_mantissa eisel_lemire(u64 w, i64 q)
+        {
+            using traits = parse_traits<T>;
+            constexpr int mbits = traits::mantissa_bits;
+            if (w == 0 || q < traits::min_pow10) return {0, 0};
+            if (q > traits::max_pow10) return {0, traits::infinite_power};
+
+            const int lz = clz64(w);
+            w <<= lz;
+
+            // Only the top mantissa_bits + 3 bits of the product matter; the second word is needed
+            // when they might still change through a carry from below
+            const u64 *pow5 = detail::pow5_128[q - detail::pow5_q_min];
+            __uint128_t product = static_cast<__uint128_t>(w) * pow5[0];
+            u64 high = static_cast<u64>(product >> 64), low = static_cast<u64>(product);
+            constexpr u64 precision_mask = ~u64(0) >> (mbits + 3);
+            if ((high & precision_mask) == precision_mask)
+            {
+                const u64 second = static_cast<u64>((static_cast<__uint128_t>(w) * pow5[1]) >> 64);
+                low += second;
+                if (second > low) ++high;
+            }
+
+            const int upperbit = static_cast<int>(high >> 63);
+            const int shift = upperbit + 64 - mbits - 3;
+            adjusted_mantissa am;
+            am.mantissa = high >> shift;
+            am.power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - traits::min_exponent;
+
+            if (am.power2 <= 0)
+            {
+                // Subnormal: shift down to the fixed exponent before rounding
+                if (-am.power2 + 1 >= 64) return {0, 0};
+                am.mantissa >>= -am.power2 + 1;
+                am.mantissa += am.mantissa & 1;
+                am.mantissa >>= 1;
+                am.power2 = am.mantissa < (u64(1) << mbits) ? 0 : 1;
+                return am;
+            }
+
+            // Exactly halfway between two floats: round to even instead of up
+            if (low <= 1 && q >= traits::min_round_to_even && q <= traits::max_round_to_even &&
+                (am.mantissa & 3) == 1 && (am.mantissa << shift) == high)
+                am.mantissa &= ~u64(1);
+
+            am.mantissa += am.mantissa & 1;
+            am.mantissa >>= 1;
+            if (am.mantissa >= (u64(2) << mbits))
+            {
+                am.mantissa = u64(1) << mbits;
+                ++am.power2;
+            }
+            am.mantissa &= ~(u64(1) << mbits);
+            if (am.power2 >= traits::infinite_power) return {0, traits::infinite_power};
+            return am;
+        }
+
+        template <typename T>
+        ACUL_FORCEINLINE typename parse_traits<T>::bits_type to_bits(const adjusted_mantissa &am)
+        {
+            return static_cast<typename parse_traits<T>::bits_type>(
+                (static_cast<u64>(am.power2) << parse_traits<T>::mantissa_bits) | am.mantissa);
+        }
+
+        /// A double halfway point has at most 767 significant digits; more only act as a sticky bit.
+        constexpr int max_parse_digits = 780;
+
+        /// Digits as written: integer and fraction runs and the explicit exponent.
+        struct decimal_text
+        {
+            const char *int_begin, *int_end;
+            const char *frac_begin, *frac_end;
+            i64 exponent;
+        };
+
+        /**
+         * @brief Picks between the candidate and the next float up by comparing the full decimal input
+         * with the exact halfway point between them.
+         */
+        template <typename T>
+        adjusted_mantissa round_exact(const decimal_text &text, adjusted_mantissa am)
+        {
+            using traits = parse_traits<T>;
+            constexpr int mbits = traits::mantissa_bits;
+            constexpr int bias = -traits::min_exponent;
+
+            // Significant digits D and the exponent E with the decimal value D * 10^E
+            bigint lhs(0);
+            int count = 0;
+            bool sticky = false;
+            i64 dropped = 0;
+            auto take = [&](const char *begin, const char *end) {
+                for (const char *c = begin; c < end; ++c)
+                {
+                    if (count == 0 && *c == '0') continue;
+                    if (count < max_parse_digits)
+                    {
+                        lhs.mul_small(10, static_cast<u32>(*c - '0'));
+                        ++count;
+                    }
+                    else
+                    {
+                        sticky |= *c != '0';
+                        ++dropped;
+                    }
+                }
+            };
+            take(text.int_begin, text.int_end);
+            take(text.frac_begin, text.frac_end);
+            const i64 e10 = text.exponent - (text.frac_end - text.frac_begin) + dropped;
+
+            // Halfway point (2M + 1) * 2^(e2 - 1)
+            const u64 m = am.power2 ? am.mantissa | (u64(1) << mbits) : am.mantissa;
+            const int e2 = (am.power2 ? am.power2 : 1) - bias - mbits;
+            bigint rhs(2 * m + 1);
+            if (e10 >= 0) lhs.mul_pow10(static_cast<int>(e10));
+            else rhs.mul_pow10(static_cast<int>(-e10));
+            if (e2 - 1 >= 0) rhs.shift_left(e2 - 1);
+            else lhs.shift_left(1 - e2);
+
+            int cmp = lhs.compare(rhs);
+            if (cmp == 0 && sticky) cmp = 1;
+            if (cmp > 0 || (cmp == 0 && (m & 1)))
+            {
+                const u64 bits = to_bits<T>(am) + 1;
+                am.mantissa = bits & ((u64(1) << mbits) - 1);
+                am.power2 = static_cast<int>(bits >> mbits);
+            }
+            return am;
+        }
+
+        ACUL_FORCEINLINE bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+#if ACUL_IS_LITTLE_ENDIAN && !defined(__SANITIZE_ADDRESS__)
+    #define ACUL_SWAR_DIGITS 1
+#endif
+
+        /**
+         * @brief Accumulates a run of digits, eight at a time while a whole word of them is available.
+         *
+         * The word load never leaves the page of the first byte, which is readable, so it stays within
+         * mapped memory even when the string ends inside it.
+         */
+        const char *parse_digits(const char *p, u64 &w)
+        {
+#ifdef ACUL_SWAR_DIGITS
+            while ((reinterpret_cast<uintptr_t>(p) & 4095) <= 4096 - 8)
+            {
+                u64 word = load_u64u_le(p);
+                if ((((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))) !=
+                    0x3333333333333333)
+                    break;
+                word -= 0x3030303030303030;
+                word = word * 10 + (word >> 8);
+                word = (((word & 0x000000FF000000FF) * 0x000F424000000064) +
+                        (((word >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+                       32;
+                w = w * 100000000 + static_cast<u32>(word);
+                p += 8;
+            }
+#endif
+            for (; is_digit(*p); ++p) w = w * 10 + static_cast<u64>(*p - '0');
+            return p;
+        }
+
+        bool match_word(const char *&p, const char *word)
+        {
+            const char *c = p;
+            for (; *word; ++c, ++word)
+                if ((*c | 0x20) != *word) return false;
+            p = c;
+            return true;
+        }
+
+        template <typename T>
+        bool parse_float(const char *&str, T &value)
+        {
+            using traits = parse_traits<T>;
+            const char *p = str;
+            while (isspace(static_cast<unsigned char>(*p))) ++p;
+            const bool negative = *p == '-';
+            if (*p == '-' || *p == '+') ++p;
+
+            decimal_text text;
+            u64 w = 0;
+            text.int_begin = p;
+            p = parse_digits(p, w);
+            text.int_end = text.frac_begin = text.frac_end = p;
+            if (*p == '.')
+            {
+                text.frac_begin = ++p;
+                p = text.frac_end = parse_digits(p, w);
+            }
+            i64 digit_count = (text.int_end - text.int_begin) + (text.frac_end - text.frac_begin);
+
+            if (digit_count == 0)
+            {
+                p = text.int_begin;
+                T special;
+                if (match_word(p, "inf"))
+                {
+                    match_word(p, "inity");
+                    special = std::numeric_limits<T>::infinity();
+                }
+                else if (match_word(p, "nan")) special = std::numeric_limits<T>::quiet_NaN();
+                else return false;
+                value = negative ? -special : special;
+                str = p;
+                return true;
+            }
+
+            text.exponent = 0;
+            if (*p == 'e' || *p == 'E')
+            {
+                ++p;
+                const bool exponent_negative = *p == '-';
+                if (*p == '-' || *p == '+') ++p;
+                if (!is_digit(*p)) return false;
+                i64 exponent = 0;
+                for (; is_digit(*p); ++p)
+                    if (exponent < 0x10000000) exponent = exponent * 10 + (*p - '0');
+                text.exponent = exponent_negative ? -exponent : exponent;
+            }
+            str = p;
+
+            // The value is w * 10^q unless more than 19 significant digits were written
+            i64 q = text.exponent - (text.frac_end - text.frac_begin);
+            bool truncated = false;
+            if (digit_count > 19)
+            {
+                for (const char *c = text.int_begin; c < text.frac_end && (*c == '0' || *c == '.'); ++c)
+                    if (*c == '0') --digit_count;
+                if (digit_count > 19)
+                {
+                    // Keep the first 19 digits and scale by the position of the last one kept
+                    truncated = true;
+                    constexpr u64 min_19_digits = 1000000000000000000ULL;
+                    w = 0;
+                    const char *c = text.int_begin;
+                    while (w < min_19_digits && c < text.int_end) w = w * 10 + static_cast<u64>(*c++ - '0');
+                    if (w >= min_19_digits) q = text.exponent + (text.int_end - c);
+                    else
+                    {
+                        c = text.frac_begin;
+                        while (w < min_19_digits && c < text.frac_end) w = w * 10 + static_cast<u64>(*c++ - '0');
+                        q = text.exponent - (c - text.frac_begin);
+                    }
+                }
+            }
+
+            T result;
+#if FLT_EVAL_METHOD == 0
+            // Both operands are exact, so the single rounding of the product or quotient is the answer
+            if (!truncated && w <= traits::max_exact_mantissa && q >= -traits::max_exact_pow10 &&
+                q <= traits::max_exact_pow10)
+            {
+                result = static_cast<T>(w);
+                if (q < 0) result /= traits::exact_pow10[-q];
+                else result *= traits::exact_pow10[q];
+                value = negative ? -result : result;
+                return true;
+            }
+#endif
+            adjusted_mantissa am = eisel_lemire<T>(w, q);
+            // The dropped digits put the value between w and w + 1 units of the last digit kept
+            if (truncated && !(am == eisel_lemire<T>(w + 1, q))) am = round_exact<T>(text, am);
+            const typename traits::bits_type bits = to_bits<T>(am);
+            memcpy(&result, &bits, sizeof(T));
+            value = negative ? -result : result;
+            return true;
+        }
+    } // namespace
+
+    int to_string(f32 value, char *buffer, size_t buffer_size, float_format format, int precision)
+    {
+        return format_float(value, buffer, buffer_size, format, precision);
+    }
+
+    int to_string(f64 value, char *buffer, size_t buffer_size, float_format format, int precision)
+    {
+        return format_float(value, buffer, buffer_size, format, precision);
+    }
+
+    bool stof(const char *&str, f32 &value) { return parse_float(str, value); }
+
+    bool stod(const char *&str, f64 &value) { return parse_float(str, value); }
+} // namespace acul
@@ -0,0 +1,253 @@
+#include <acul/string/format.hpp>
+#include <acul/string/utils.hpp>
+#include <cmath>
+
+namespace acul::fmt::detail
+{
+    static constexpr char lower_digits[] = "0123456789abcdef";
+    static constexpr char upper_digits[] = "0123456789ABCDEF";
+
+    static size_t arg_bound(const spec &spec, const arg &arg)
+    {
+        size_t size;
+        switch (arg.type)
+        {
+            case arg_type::signed_int:
+            case arg_type::unsigned_int:
+                size = spec.type == 'b' ? 66 : 24;
+                break;
+            case arg_type::character:
+                size = 4;
+                break;
+            case arg_type::boolean:
+                size = 5;
+                break;
+            case arg_type::f32:
+            case arg_type::f64:
+            {
+                f64 value = arg.type == arg_type::f32 ? arg.f : arg.d;
+                size_t precision = spec.precision < 0 ? 6 : spec.precision;
+                if (spec.type == 'f') size = (fabs(value) < 1e15 ? 18 : 312) + precision;
+                else size = 32 + precision;
+                break;
+            }
+            case arg_type::string:
+                size = arg.s.size;
+                break;
+            default:
+                size = 18;
+                break;
+        }
+        return size > spec.width ? size : spec.width;
+    }
+
+    /**
+     * @brief Appends the rendered value with the field padding applied.
+     * @param prefix Length of the sign and base prefix that zero padding is inserted after.
+     */
+    static void write_padded(string &dst, const spec &spec, const char *data, size_t size, size_t prefix,
+                             char default_align)
+    {
+        if (size >= spec.width)
+        {
+            dst.append(data, size);
+            return;
+        }
+        size_t padding = spec.width - size;
+        if (spec.zero && !spec.align)
+        {
+            dst.append(data, prefix);
+            dst.append(padding, '0');
+            dst.append(data + prefix, size - prefix);
+            return;
+        }
+        char align = spec.align ? spec.align : default_align;
+        size_t left = align == '>' ? padding : align == '^' ? padding / 2 : 0;
+        dst.append(left, spec.fill);
+        dst.append(data, size);
+        dst.append(padding - left, spec.fill);
+    }
+
+    static void write_integer(string &dst, const spec &spec, u64 magnitude, bool negative)
+    {
+        char buf[72];
+        char *end = buf + sizeof(buf);
+        char *p = end;
+        const char *digits = spec.type == 'X' ? upper_digits : lower_digits;
+        switch (spec.type)
+        {
+            case 'x':
+            case 'X':
+                do *--p = digits[magnitude & 0xF];
+                while (magnitude >>= 4);
+                break;
+            case 'o':
+                do *--p = digits[magnitude & 0x7];
+                while (magnitude >>= 3);
+                break;
+            case 'b':
+                do *--p = digits[magnitude & 0x1];
+                while (magnitude >>= 1);
+                break;
+            default:
+                p = end - to_string(magnitude, buf);
+                memmove(p, buf, end - p);
+                break;
+        }
+
+        size_t prefix = 0;
+        if (spec.alt && spec.type && spec.type != 'd')
+        {
+            if (spec.type == 'o') *--p = '0';
+            else
+            {
+                *--p = spec.type;
+                *--p = '0';
+            }
+            prefix = spec.type == 'o' ? 1 : 2;
+        }
+        if (negative)
+        {
+            *--p = '-';
+            ++prefix;
+        }
+        write_padded(dst, spec, p, end - p, prefix, '>');
+    }
+
+    static void write_float(string &dst, const spec &spec, f64 value, bool single)
+    {
+        char buf[1088];
+        float_format format;
+        int precision = spec.precision;
+        switch (spec.type)
+        {
+            case 'f':
+                format = float_format::fixed;
+                if (precision < 0) precision = 6;
+                break;
+            case 'e':
+                format = float_format::scientific;
+                if (precision < 0) precision = 6;
+                break;
+            case 'g':
+                format = float_format::general;
+                break;
+            default:
+                format = precision < 0 ? float_format::shortest : float_format::general;
+                break;
+        }
+        int len = single ? to_string(static_cast<f32>(value), buf, sizeof(buf), format, precision)
+                         : to_string(value, buf, sizeof(buf), format, precision);
+        if (len <= 0) return;
+        size_t prefix = buf[0] == '-' ? 1 : 0;
+        if (!std::isfinite(value))
+        {
+            struct spec plain = spec;
+            plain.zero = false;
+            write_padded(dst, plain, buf, len, prefix, '>');
+        }
+        else write_padded(dst, spec, buf, len, prefix, '>');
+    }
+
+    static void write_arg(string &dst, const spec &spec, const arg &arg)
+    {
+        switch (arg.type)
+        {
+            case arg_type::signed_int:
+                if (spec.type == 'c')
+                {
+                    char c = static_cast<char>(arg.i);
+                    write_padded(dst, spec, &c, 1, 0, '<');
+                }
+                else write_integer(dst, spec, arg.i < 0 ? 0 - static_cast<u64>(arg.i) : arg.i, arg.i < 0);
+                break;
+            case arg_type::unsigned_int:
+                if (spec.type == 'c')
+                {
+                    char c = static_cast<char>(arg.u);
+                    write_padded(dst, spec, &c, 1, 0, '<');
+                }
+                else write_integer(dst, spec, arg.u, false);
+                break;
+            case arg_type::character:
+                if (spec.type && spec.type != 'c') write_integer(dst, spec, static_cast<unsigned char>(arg.c), false);
+                else write_padded(dst, spec, &arg.c, 1, 0, '<');
+                break;
+            case arg_type::boolean:
+                if (arg.b) write_padded(dst, spec, "true", 4, 0, '<');
+                else write_padded(dst, spec, "false", 5, 0, '<');
+                break;
+            case arg_type::f32:
+                write_float(dst, spec, arg.f, true);
+                break;
+            case arg_type::f64:
+                write_float(dst, spec, arg.d, false);
+                break;
+            case arg_type::string:
+                write_padded(dst, spec, arg.s.data, arg.s.size, 0, '<');
+                break;
+            case arg_type::pointer:
+            {
+                struct spec hex = spec;
+                hex.type = 'x';
+                hex.alt = true;
+                write_integer(dst, hex, reinterpret_cast<uintptr_t>(arg.p), false);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void vformat_to(string &dst, string_view format, const arg *args)
+    {
+        const char *begin = format.data();
+        const char *end = begin + format.size();
+        const char *error = nullptr;
+
+        // Upper bound of the output, so the destination grows at most once
+        size_t bound = 0;
+        const arg *next = args;
+        for (const char *p = begin; p < end;)
+        {
+            if (*p == '{' && p + 1 < end && p[1] != '{')
+            {
+                spec spec;
+                p = parse_spec(p + 1, end, spec, error);
+                if (!p) return;
+                bound += arg_bound(spec, *next++);
+            }
+            else
+            {
+                bound += 1;
+                p += (*p == '{' || *p == '}') ? 2 : 1;
+            }
+        }
+        dst.reserve(dst.size() + bound);
+
+        next = args;
+        const char *literal = begin;
+        for (const char *p = begin; p < end;)
+        {
+            if (*p != '{' && *p != '}')
+            {
+                ++p;
+                continue;
+            }
+            if (p > literal) dst.append(literal, p - literal);
+            if (*p == '}' || p[1] == '{')
+            {
+                dst.push_back(*p);
+                p += 2;
+            }
+            else
+            {
+                spec spec;
+                p = parse_spec(p + 1, end, spec, error);
+                write_arg(dst, spec, *next++);
+            }
+            literal = p;
+        }
+        if (end > literal) dst.append(literal, end - literal);
+    }
+} // namespace acul::fmt::detail
@@ -0,0 +1,279 @@
+#include <acul/detail/isa/dispatch.hpp>
+#include <algorithm>
+#include "multi_search.hpp"
+
+namespace acul
+{
+    namespace detail
+    {
+        static teddy_pattern pack_pattern(const string &pattern, u32 id, bool icase)
+        {
+            teddy_pattern entry{0, 0, 0, id, static_cast<u32>(pattern.size())};
+            u8 prefix[8] = {}, mask[8] = {}, fold[8] = {};
+            for (size_t j = 0; j < pattern.size() && j < sizeof(prefix); ++j)
+            {
+                prefix[j] = static_cast<u8>(pattern[j]);
+                mask[j] = 0xFF;
+                // Lower-case letters only meet their upper-case form when 0x20 is set
+                if (icase && static_cast<u8>(pattern[j] - 'a') < 26) fold[j] = 0x20;
+            }
+            memcpy(&entry.prefix, prefix, sizeof(prefix));
+            memcpy(&entry.mask, mask, sizeof(mask));
+            memcpy(&entry.fold, fold, sizeof(fold));
+            return entry;
+        }
+
+        static void compile_teddy(teddy_program &program)
+        {
+            const auto &patterns = program.patterns;
+            size_t shortest = SIZE_MAX;
+            vector<u32> ids;
+            for (u32 id = 0; id < patterns.size(); ++id)
+            {
+                if (patterns[id].empty()) continue;
+                shortest = std::min(shortest, patterns[id].size());
+                ids.push_back(id);
+            }
+            program.fingerprint = static_cast<u32>(std::min<size_t>(shortest, teddy_max_fingerprint));
+
+            // Patterns sharing a prefix go to the same bucket, so a candidate rarely checks more than one of
+            // them needlessly
+            const u32 k = program.fingerprint;
+            std::sort(ids.begin(), ids.end(), [&](u32 a, u32 b) {
+                const int cmp = memcmp(patterns[a].data(), patterns[b].data(), k);
+                return cmp != 0 ? cmp < 0 : a < b;
+            });
+            const size_t per_bucket = (ids.size() + teddy_buckets - 1) / teddy_buckets;
+
+            memset(program.lo, 0, sizeof(program.lo));
+            memset(program.hi, 0, sizeof(program.hi));
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                const u32 bucket = static_cast<u32>(i / per_bucket);
+                const u8 bit = static_cast<u8>(1u << bucket);
+                const string &pattern = patterns[ids[i]];
+                program.buckets[bucket].push_back(pack_pattern(pattern, ids[i], program.icase));
+                for (u32 j = 0; j < k; ++j)
+                {
+                    const u8 c = static_cast<u8>(pattern[j]);
+                    program.lo[j][c & 0x0F] |= bit;
+                    program.hi[j][c >> 4] |= bit;
+                    if (program.icase)
+                    {
+                        const u8 upper = static_cast<u8>(search::ascii_upper(static_cast<char>(c)));
+                        program.lo[j][upper & 0x0F] |= bit;
+                        program.hi[j][upper >> 4] |= bit;
+                    }
+                }
+            }
+        }
+
+        static void compile_automaton(multi_search_program &program)
+        {
+            const auto &patterns = program.teddy.patterns;
+            const bool icase = program.teddy.icase;
+            memset(program.classes, 0, sizeof(program.classes));
+            program.class_count = 1;
+            for (const string &pattern : patterns)
+                for (char ch : pattern)
+                {
+                    const u8 c = static_cast<u8>(ch);
+                    if (program.classes[c] == 0) program.classes[c] = static_cast<u16>(program.class_count++);
+                }
+            if (icase)
+                for (int c = 'A'; c <= 'Z'; ++c) program.classes[c] = program.classes[c + ('a' - 'A')];
+
+            // Trie, missing edges are marked until the failure links fill them
+            constexpr u32 none = UINT32_MAX;
+            const u32 classes = program.class_count;
+            auto &next = program.next;
+            next.assign(classes, none);
+            vector<std::pair<u32, u32>> ends;
+            for (u32 id = 0; id < patterns.size(); ++id)
+            {
+                if (patterns[id].empty()) continue;
+                u32 state = 0;
+                for (char ch : patterns[id])
+                {
+                    u32 &edge = next[state * classes + program.classes[static_cast<u8>(ch)]];
+                    if (edge == none)
+                    {
+                        edge = static_cast<u32>(next.size() / classes);
+                        next.insert(next.end(), static_cast<size_t>(classes), none);
+                    }
+                    state = next[state * classes + program.classes[static_cast<u8>(ch)]];
+                }
+                ends.emplace_back(state, id);
+            }
+            const u32 states = static_cast<u32>(next.size() / classes);
+
+            std::sort(ends.begin(), ends.end());
+            program.out_begin.assign(states + 1, 0);
+            program.out_ids.resize(ends.size());
+            for (size_t i = 0; i < ends.size(); ++i)
+            {
+                ++program.out_begin[ends[i].first + 1];
+                program.out_ids[i] = ends[i].second;
+            }
+            for (u32 s = 0; s < states; ++s) program.out_begin[s + 1] += program.out_begin[s];
+            auto has_output = [&](u32 s) { return program.out_begin[s + 1] != program.out_begin[s]; };
+
+            // Breadth-first pass turning the trie into a DFA: a missing edge follows the failure link
+            vector<u32> fail(states, 0);
+            program.dict.assign(states, 0);
+            vector<u32> queue;
+            queue.reserve(states);
+            for (u32 c = 0; c < classes; ++c)
+            {
+                u32 &edge = next[c];
+                if (edge == none) edge = 0;
+                else queue.push_back(edge);
+            }
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                const u32 s = queue[head];
+                for (u32 c = 0; c < classes; ++c)
+                {
+                    u32 &edge = next[s * classes + c];
+                    const u32 fallback = next[fail[s] * classes + c];
+                    if (edge == none)
+                    {
+                        edge = fallback;
+                        continue;
+                    }
+                    fail[edge] = fallback;
+                    program.dict[edge] = has_output(fallback) ? fallback : program.dict[fallback];
+                    queue.push_back(edge);
+                }
+            }
+
+            // Entries become row offsets of the target state so the scan needs no multiply, with the
+            // reporting states flagged
+            for (u32 &target : next)
+            {
+                const bool reports = has_output(target) || program.dict[target] != 0;
+                target = target * classes | (reports ? automaton_reports : 0);
+            }
+        }
+
+        static void aho_corasick_find(const multi_search_program &program, const char *data, size_t size,
+                                      vector<multi_match> &dst)
+        {
+            const auto &patterns = program.teddy.patterns;
+            const u32 *next = program.next.data();
+            const u32 *out_begin = program.out_begin.data();
+            const u32 classes = program.class_count;
+            u32 row = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                const u32 target = next[row + program.classes[static_cast<u8>(data[i])]];
+                row = target & ~automaton_reports;
+                if (!(target & automaton_reports)) continue;
+                const u32 state = row / classes;
+                for (u32 s = out_begin[state] != out_begin[state + 1] ? state : program.dict[state]; s != 0;
+                     s = program.dict[s])
+                    for (u32 k = out_begin[s]; k < out_begin[s + 1]; ++k)
+                    {
+                        const u32 id = program.out_ids[k];
+                        dst.push_back({i + 1 - patterns[id].size(), id});
+                    }
+            }
+        }
+    } // namespace detail
+
+    multi_matcher::multi_matcher(const string_view *patterns, size_t count, bool ignore_case) : _program(nullptr)
+    {
+        compile(patterns, count, ignore_case);
+    }
+
+    multi_matcher::multi_matcher(const vector<string> &patterns, bool ignore_case) : _program(nullptr)
+    {
+        vector<string_view> views;
+        views.reserve(patterns.size());
+        for (const string &pattern : patterns) views.emplace_back(pattern.data(), pattern.size());
+        compile(views.data(), views.size(), ignore_case);
+    }
+
+    multi_matcher &multi_matcher::operator=(multi_matcher &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (_program) release(_program);
+            _program = other._program;
+            other._program = nullptr;
+        }
+        return *this;
+    }
+
+    multi_matcher::~multi_matcher()
+    {
+        if (_program) release(_program);
+    }
+
+    size_t multi_matcher::size() const noexcept { return _program ? _program->teddy.patterns.size() : 0; }
+
+    bool multi_matcher::ignore_case() const noexcept { return _program && _program->teddy.icase; }
+
+    bool multi_matcher::vectorized() const noexcept
+    {
+        return _program && _program->use_teddy && detail::g_isa_dispatcher.teddy_find;
+    }
+
+    void multi_matcher::compile(const string_view *patterns, size_t count, bool ignore_case)
+    {
+        // Built aside and published once complete, so a throwing step leaves no half-built matcher behind
+        auto *program = alloc<detail::multi_search_program>();
+        try
+        {
+            auto &teddy = program->teddy;
+            teddy.icase = ignore_case;
+            teddy.patterns.reserve(count);
+            bool any = false;
+            for (size_t i = 0; i < count; ++i)
+            {
+                string pattern(patterns[i].data(), patterns[i].size());
+                if (ignore_case)
+                    for (char &c : pattern) c = detail::search::ascii_lower(c);
+                any |= !pattern.empty();
+                teddy.patterns.push_back(std::move(pattern));
+            }
+            program->use_teddy = any && count <= detail::teddy_max_patterns;
+            if (program->use_teddy) detail::compile_teddy(teddy);
+            // The automaton is only needed when the prefilter is not available for this set or CPU
+            if (!program->use_teddy || !detail::g_isa_dispatcher.teddy_find) detail::compile_automaton(*program);
+        }
+        catch (...)
+        {
+            release(program);
+            throw;
+        }
+        _program = program;
+    }
+
+    size_t multi_matcher::find_all(const char *data, size_t size, vector<multi_match> &dst) const
+    {
+        const size_t first = dst.size();
+        if (vectorized()) detail::g_isa_dispatcher.teddy_find(_program->teddy, data, size, dst);
+        else detail::aho_corasick_find(*_program, data, size, dst);
+
+        // The automaton reports by end offset and Teddy orders matches at one offset by bucket
+        auto less = [](const multi_match &a, const multi_match &b) {
+            return a.offset != b.offset ? a.offset < b.offset : a.pattern < b.pattern;
+        };
+        if (!std::is_sorted(dst.begin() + first, dst.end(), less)) std::sort(dst.begin() + first, dst.end(), less);
+        return dst.size() - first;
+    }
+
+    size_t multi_matcher::find_all(const string_view_pool<char> &lines, vector<line_match> &dst) const
+    {
+        const size_t first = dst.size();
+        vector<multi_match> matches;
+        for (size_t line = 0; line < lines.size(); ++line)
+        {
+            matches.clear();
+            find_all(lines[line].data(), lines[line].size(), matches);
+            for (const auto &match : matches) dst.push_back({line, match.offset, match.pattern});
+        }
+        return dst.size() - first;
+    }
+} // namespace acul
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <acul/bit.hpp>
+#include <acul/string/multi_search.hpp>
+#include "search_scalar.hpp"
+
+// Compiled form of multi_matcher shared by the Teddy kernels and the Aho–Corasick fallback.
+namespace acul::detail
+{
+    /// Teddy splits the patterns into 8 buckets, one bit each in the nibble masks.
+    constexpr u32 teddy_buckets = 8;
+    constexpr size_t teddy_max_patterns = 64;
+    /// Leading pattern bytes tested by the prefilter.
+    constexpr u32 teddy_max_fingerprint = 3;
+
+    /// Pattern entry of a Teddy bucket with its first 8 bytes packed for a single compare.
+    struct teddy_pattern
+    {
+        u64 prefix;
+        /// 0xFF for the bytes the pattern covers.
+        u64 mask;
+        /// 0x20 for letters when case is ignored, OR-ed into the input to fold it.
+        u64 fold;
+        u32 id;
+        u32 size;
+    };
+
+    struct teddy_program
+    {
+        /// Patterns as searched, lower-cased when matching ignores case.
+        vector<string> patterns;
+        bool icase = false;
+        /// Bytes tested per candidate, the shortest pattern length capped at teddy_max_fingerprint.
+        u32 fingerprint = 0;
+        /// Bucket bits of the patterns whose j-th byte has the given low (lo) or high (hi) nibble.
+        alignas(16) u8 lo[teddy_max_fingerprint][16];
+        alignas(16) u8 hi[teddy_max_fingerprint][16];
+        vector<teddy_pattern> buckets[teddy_buckets];
+    };
+
+    constexpr u32 automaton_reports = 0x80000000u;
+
+    struct multi_search_program
+    {
+        teddy_program teddy;
+        bool use_teddy = false;
+
+        /// Automaton input: bytes that occur in no pattern share class 0.
+        u16 classes[256];
+        u32 class_count = 1;
+        /// Transition table, class_count entries per state, state 0 is the root. Entries hold the row offset
+        /// of the target, flagged with automaton_reports when patterns end there.
+        vector<u32> next;
+        /// Patterns ending at the state are out_ids[out_begin[s], out_begin[s + 1]).
+        vector<u32> out_begin;
+        vector<u32> out_ids;
+        /// Nearest proper suffix state with patterns of its own, 0 when there is none.
+        vector<u32> dict;
+    };
+
+    /// Checks the patterns of the buckets flagged for a Teddy candidate at `pos`.
+    inline void teddy_verify(const teddy_program &program, const char *data, size_t size, size_t pos, u32 buckets,
+                             vector<multi_match> &dst)
+    {
+        const size_t left = size - pos;
+        const bool packed = left >= sizeof(u64);
+        const u64 head = packed ? load_u64u(data + pos) : 0;
+        while (buckets)
+        {
+            for (const teddy_pattern &entry : program.buckets[pop_lsb(buckets)])
+            {
+                if (entry.size > left) continue;
+                if (packed)
+                {
+                    if (((head | entry.fold) & entry.mask) != entry.prefix) continue;
+                    if (entry.size > sizeof(u64))
+                    {
+                        const string &pattern = program.patterns[entry.id];
+                        const size_t rest = entry.size - sizeof(u64);
+                        const char *p = data + pos + sizeof(u64);
+                        const char *q = pattern.data() + sizeof(u64);
+                        if (program.icase ? !search::icase_equal(p, q, rest) : memcmp(p, q, rest) != 0) continue;
+                    }
+                }
+                else
+                {
+                    const char *q = program.patterns[entry.id].data();
+                    if (program.icase ? !search::icase_equal(data + pos, q, entry.size)
+                                      : memcmp(data + pos, q, entry.size) != 0)
+                        continue;
+                }
+                dst.push_back({pos, entry.id});
+            }
+        }
+    }
+} // namespace acul::detail
@@ -0,0 +1,148 @@
+#include <acul/bit.hpp>
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <immintrin.h>
+#include "search_scalar.hpp"
+
+// 32-byte version of the SSE4.2 kernels.
+namespace acul::detail::avx2
+{
+    namespace
+    {
+        ACUL_FORCEINLINE __m256i load(const char *p)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        ACUL_FORCEINLINE u32 eq_mask(__m256i v, __m256i ch)
+        {
+            return static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, ch)));
+        }
+
+        /// ASCII upper-case letters get 0x20 added, everything else is left as is.
+        ACUL_FORCEINLINE __m256i fold(__m256i v, __m256i first, __m256i flip)
+        {
+            const __m256i t = _mm256_sub_epi8(v, first);
+            const __m256i in_range = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(25)), t);
+            return _mm256_add_epi8(v, _mm256_and_si256(in_range, flip));
+        }
+
+        template <bool Upper>
+        ACUL_FORCEINLINE void convert_case(const char *src, size_t size, char *dst)
+        {
+            const __m256i first = _mm256_set1_epi8(Upper ? 'a' : 'A');
+            const __m256i flip = _mm256_set1_epi8(Upper ? -0x20 : 0x20);
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), fold(load(src + i), first, flip));
+            if constexpr (Upper) scalar::to_upper(src + i, size - i, dst + i);
+            else scalar::to_lower(src + i, size - i, dst + i);
+        }
+    } // namespace
+
+    size_t find(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find(data, size, needle, needle_size);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 32 <= size; i += 32)
+        {
+            u32 mask = eq_mask(load(data + i), first) & eq_mask(load(data + i + shift), last);
+            while (mask)
+            {
+                const size_t pos = i + pop_lsb(mask);
+                if (search::match_inner(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find(data + i, size - i, needle, needle_size), i);
+    }
+
+    size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::rfind(data, size, needle, needle_size);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        // Candidates left to check are [0, end)
+        size_t end = size - shift;
+        while (end >= 32)
+        {
+            end -= 32;
+            u32 mask = eq_mask(load(data + end), first) & eq_mask(load(data + end + shift), last);
+            while (mask)
+            {
+                const unsigned bit = 63 - clz64(mask);
+                if (search::match_inner(data + end + bit, needle, needle_size)) return end + bit;
+                mask &= ~(1u << bit);
+            }
+        }
+        return scalar::rfind(data, end + shift, needle, needle_size);
+    }
+
+    size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size)
+    {
+        if (set_size == 0 || set_size > 16) return scalar::find_first_of(data, size, set, set_size);
+        __m256i chars[16];
+        for (size_t k = 0; k < set_size; ++k) chars[k] = _mm256_set1_epi8(set[k]);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i v = load(data + i);
+            __m256i hit = _mm256_cmpeq_epi8(v, chars[0]);
+            for (size_t k = 1; k < set_size; ++k) hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, chars[k]));
+            const u32 mask = static_cast<u32>(_mm256_movemask_epi8(hit));
+            if (mask) return i + ctz32(mask);
+        }
+        return search::offset(scalar::find_first_of(data + i, size - i, set, set_size), i);
+    }
+
+    size_t count(const char *data, size_t size, char ch)
+    {
+        const __m256i needle = _mm256_set1_epi8(ch);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i total = zero;
+        size_t i = 0;
+        while (i + 32 <= size)
+        {
+            // Byte counters are drained every 255 blocks before they can wrap
+            __m256i acc = zero;
+            const size_t stop = i + 255 * 32 < size ? i + 255 * 32 : size;
+            for (; i + 32 <= stop; i += 32) acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(load(data + i), needle));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+        }
+        const __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+        const size_t result = static_cast<size_t>(_mm_cvtsi128_si64(sums)) + _mm_extract_epi64(sums, 1);
+        return result + scalar::count(data + i, size - i, ch);
+    }
+
+    size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find_icase(data, size, needle, needle_size);
+        const __m256i upper_a = _mm256_set1_epi8('A');
+        const __m256i flip = _mm256_set1_epi8(0x20);
+        const __m256i first = _mm256_set1_epi8(search::ascii_lower(needle[0]));
+        const __m256i last = _mm256_set1_epi8(search::ascii_lower(needle[needle_size - 1]));
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 32 <= size; i += 32)
+        {
+            u32 mask = eq_mask(fold(load(data + i), upper_a, flip), first) &
+                       eq_mask(fold(load(data + i + shift), upper_a, flip), last);
+            while (mask)
+            {
+                const size_t pos = i + pop_lsb(mask);
+                if (search::match_inner_icase(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find_icase(data + i, size - i, needle, needle_size), i);
+    }
+
+    void to_lower(const char *src, size_t size, char *dst) { convert_case<false>(src, size, dst); }
+
+    void to_upper(const char *src, size_t size, char *dst) { convert_case<true>(src, size, dst); }
+} // namespace acul::detail::avx2
@@ -0,0 +1,137 @@
+#include <acul/bit.hpp>
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <immintrin.h>
+#include "search_scalar.hpp"
+
+// 64-byte kernels on AVX-512BW compare masks; tails use masked loads and stores instead of scalar loops.
+namespace acul::detail::avx512
+{
+    namespace
+    {
+        ACUL_FORCEINLINE __m512i load(const char *p) { return _mm512_loadu_si512(p); }
+
+        ACUL_FORCEINLINE __mmask64 tail_mask(size_t n) { return n >= 64 ? ~__mmask64(0) : (__mmask64(1) << n) - 1; }
+
+        ACUL_FORCEINLINE __m512i fold(__m512i v, __m512i first, __m512i flip)
+        {
+            const __mmask64 in_range = _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, first), _mm512_set1_epi8(25));
+            return _mm512_mask_add_epi8(v, in_range, v, flip);
+        }
+
+        template <bool Upper>
+        ACUL_FORCEINLINE void convert_case(const char *src, size_t size, char *dst)
+        {
+            const __m512i first = _mm512_set1_epi8(Upper ? 'a' : 'A');
+            const __m512i flip = _mm512_set1_epi8(Upper ? -0x20 : 0x20);
+            size_t i = 0;
+            for (; i + 64 <= size; i += 64) _mm512_storeu_si512(dst + i, fold(load(src + i), first, flip));
+            if (i < size)
+            {
+                const __mmask64 m = tail_mask(size - i);
+                _mm512_mask_storeu_epi8(dst + i, m, fold(_mm512_maskz_loadu_epi8(m, src + i), first, flip));
+            }
+        }
+    } // namespace
+
+    size_t find(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find(data, size, needle, needle_size);
+        const __m512i first = _mm512_set1_epi8(needle[0]);
+        const __m512i last = _mm512_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 64 <= size; i += 64)
+        {
+            u64 mask = _mm512_cmpeq_epi8_mask(load(data + i), first) &
+                       _mm512_cmpeq_epi8_mask(load(data + i + shift), last);
+            for (; mask; mask &= mask - 1)
+            {
+                const size_t pos = i + ctz64(mask);
+                if (search::match_inner(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find(data + i, size - i, needle, needle_size), i);
+    }
+
+    size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::rfind(data, size, needle, needle_size);
+        const __m512i first = _mm512_set1_epi8(needle[0]);
+        const __m512i last = _mm512_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        // Candidates left to check are [0, end)
+        size_t end = size - shift;
+        while (end >= 64)
+        {
+            end -= 64;
+            u64 mask = _mm512_cmpeq_epi8_mask(load(data + end), first) &
+                       _mm512_cmpeq_epi8_mask(load(data + end + shift), last);
+            while (mask)
+            {
+                const unsigned bit = 63 - clz64(mask);
+                if (search::match_inner(data + end + bit, needle, needle_size)) return end + bit;
+                mask &= ~(u64(1) << bit);
+            }
+        }
+        return scalar::rfind(data, end + shift, needle, needle_size);
+    }
+
+    size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size)
+    {
+        if (set_size == 0 || set_size > 16) return scalar::find_first_of(data, size, set, set_size);
+        __m512i chars[16];
+        for (size_t k = 0; k < set_size; ++k) chars[k] = _mm512_set1_epi8(set[k]);
+
+        for (size_t i = 0; i < size; i += 64)
+        {
+            const __mmask64 valid = tail_mask(size - i);
+            const __m512i v = _mm512_maskz_loadu_epi8(valid, data + i);
+            u64 mask = 0;
+            for (size_t k = 0; k < set_size; ++k) mask |= _mm512_cmpeq_epi8_mask(v, chars[k]);
+            mask &= valid;
+            if (mask) return i + ctz64(mask);
+        }
+        return search::npos;
+    }
+
+    size_t count(const char *data, size_t size, char ch)
+    {
+        const __m512i needle = _mm512_set1_epi8(ch);
+        size_t result = 0;
+        for (size_t i = 0; i < size; i += 64)
+        {
+            const __mmask64 valid = tail_mask(size - i);
+            result += popcount64(_mm512_mask_cmpeq_epi8_mask(valid, _mm512_maskz_loadu_epi8(valid, data + i), needle));
+        }
+        return result;
+    }
+
+    size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find_icase(data, size, needle, needle_size);
+        const __m512i upper_a = _mm512_set1_epi8('A');
+        const __m512i flip = _mm512_set1_epi8(0x20);
+        const __m512i first = _mm512_set1_epi8(search::ascii_lower(needle[0]));
+        const __m512i last = _mm512_set1_epi8(search::ascii_lower(needle[needle_size - 1]));
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 64 <= size; i += 64)
+        {
+            u64 mask = _mm512_cmpeq_epi8_mask(fold(load(data + i), upper_a, flip), first) &
+                       _mm512_cmpeq_epi8_mask(fold(load(data + i + shift), upper_a, flip), last);
+            for (; mask; mask &= mask - 1)
+            {
+                const size_t pos = i + ctz64(mask);
+                if (search::match_inner_icase(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find_icase(data + i, size - i, needle, needle_size), i);
+    }
+
+    void to_lower(const char *src, size_t size, char *dst) { convert_case<false>(src, size, dst); }
+
+    void to_upper(const char *src, size_t size, char *dst) { convert_case<true>(src, size, dst); }
+} // namespace acul::detail::avx512
@@ -0,0 +1,81 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include "search_scalar.hpp"
+
+namespace acul::detail::scalar
+{
+    size_t find(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0) return 0;
+        if (needle_size > size) return search::npos;
+
+        // memchr narrows the candidates down to the first byte
+        const char *p = data;
+        const char *const last = data + size - needle_size;
+        while (p <= last)
+        {
+            p = static_cast<const char *>(memchr(p, needle[0], last - p + 1));
+            if (!p) break;
+            if (memcmp(p + 1, needle + 1, needle_size - 1) == 0) return p - data;
+            ++p;
+        }
+        return search::npos;
+    }
+
+    size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0) return size;
+        if (needle_size > size) return search::npos;
+        for (size_t start = size - needle_size + 1; start-- > 0;)
+            if (data[start] == needle[0] && memcmp(data + start + 1, needle + 1, needle_size - 1) == 0) return start;
+        return search::npos;
+    }
+
+    size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size)
+    {
+        if (set_size == 1)
+        {
+            const void *p = memchr(data, set[0], size);
+            return p ? static_cast<const char *>(p) - data : search::npos;
+        }
+        u64 bitmap[4] = {};
+        for (size_t i = 0; i < set_size; ++i)
+        {
+            const u8 c = static_cast<u8>(set[i]);
+            bitmap[c >> 6] |= u64(1) << (c & 63);
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            const u8 c = static_cast<u8>(data[i]);
+            if (bitmap[c >> 6] & (u64(1) << (c & 63))) return i;
+        }
+        return search::npos;
+    }
+
+    size_t count(const char *data, size_t size, char ch)
+    {
+        size_t result = 0;
+        for (size_t i = 0; i < size; ++i) result += data[i] == ch;
+        return result;
+    }
+
+    size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0) return 0;
+        if (needle_size > size) return search::npos;
+        const char first = search::ascii_lower(needle[0]);
+        for (size_t i = 0; i + needle_size <= size; ++i)
+            if (search::ascii_lower(data[i]) == first && search::icase_equal(data + i + 1, needle + 1, needle_size - 1))
+                return i;
+        return search::npos;
+    }
+
+    void to_lower(const char *src, size_t size, char *dst)
+    {
+        for (size_t i = 0; i < size; ++i) dst[i] = search::ascii_lower(src[i]);
+    }
+
+    void to_upper(const char *src, size_t size, char *dst)
+    {
+        for (size_t i = 0; i < size; ++i) dst[i] = search::ascii_upper(src[i]);
+    }
+} // namespace acul::detail::scalar
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <acul/api.hpp>
+#include <acul/scalars.hpp>
+#include <cstring>
+
+// Scalar pieces shared by the search kernels: ASCII case folding and candidate verification.
+namespace acul::detail::search
+{
+    constexpr size_t npos = SIZE_MAX;
+
+    ACUL_FORCEINLINE char ascii_lower(char c) { return static_cast<u8>(c - 'A') < 26 ? c + ('a' - 'A') : c; }
+
+    ACUL_FORCEINLINE char ascii_upper(char c) { return static_cast<u8>(c - 'a') < 26 ? c - ('a' - 'A') : c; }
+
+    inline bool icase_equal(const char *a, const char *b, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            if (ascii_lower(a[i]) != ascii_lower(b[i])) return false;
+        return true;
+    }
+
+    /// Checks the middle of a candidate whose first and last bytes already matched.
+    ACUL_FORCEINLINE bool match_inner(const char *p, const char *needle, size_t size)
+    {
+        return size <= 2 || memcmp(p + 1, needle + 1, size - 2) == 0;
+    }
+
+    ACUL_FORCEINLINE bool match_inner_icase(const char *p, const char *needle, size_t size)
+    {
+        return size <= 2 || icase_equal(p + 1, needle + 1, size - 2);
+    }
+
+    /// Maps positions found in a sub-range back to the full range.
+    ACUL_FORCEINLINE size_t offset(size_t pos, size_t base) { return pos == npos ? npos : base + pos; }
+} // namespace acul::detail::search
@@ -0,0 +1,140 @@
+#include <acul/bit.hpp>
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <nmmintrin.h>
+#include "search_scalar.hpp"
+
+// Candidates are filtered on the first and last needle bytes 16 positions at a time and verified with memcmp.
+namespace acul::detail::sse42
+{
+    namespace
+    {
+        ACUL_FORCEINLINE __m128i load(const char *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+
+        ACUL_FORCEINLINE u32 eq_mask(__m128i v, __m128i ch) { return _mm_movemask_epi8(_mm_cmpeq_epi8(v, ch)); }
+
+        /// ASCII upper-case letters get 0x20 added, everything else is left as is.
+        ACUL_FORCEINLINE __m128i fold(__m128i v, __m128i first, __m128i flip)
+        {
+            const __m128i t = _mm_sub_epi8(v, first);
+            const __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(25)), t);
+            return _mm_add_epi8(v, _mm_and_si128(in_range, flip));
+        }
+
+        template <bool Upper>
+        ACUL_FORCEINLINE void convert_case(const char *src, size_t size, char *dst)
+        {
+            const __m128i first = _mm_set1_epi8(Upper ? 'a' : 'A');
+            const __m128i flip = _mm_set1_epi8(Upper ? -0x20 : 0x20);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), fold(load(src + i), first, flip));
+            if constexpr (Upper) scalar::to_upper(src + i, size - i, dst + i);
+            else scalar::to_lower(src + i, size - i, dst + i);
+        }
+    } // namespace
+
+    size_t find(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find(data, size, needle, needle_size);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 16 <= size; i += 16)
+        {
+            u32 mask = eq_mask(load(data + i), first) & eq_mask(load(data + i + shift), last);
+            while (mask)
+            {
+                const size_t pos = i + pop_lsb(mask);
+                if (search::match_inner(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find(data + i, size - i, needle, needle_size), i);
+    }
+
+    size_t rfind(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::rfind(data, size, needle, needle_size);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+        const size_t shift = needle_size - 1;
+
+        // Candidates left to check are [0, end)
+        size_t end = size - shift;
+        while (end >= 16)
+        {
+            end -= 16;
+            u32 mask = eq_mask(load(data + end), first) & eq_mask(load(data + end + shift), last);
+            while (mask)
+            {
+                const unsigned bit = 63 - clz64(mask);
+                if (search::match_inner(data + end + bit, needle, needle_size)) return end + bit;
+                mask &= ~(1u << bit);
+            }
+        }
+        return scalar::rfind(data, end + shift, needle, needle_size);
+    }
+
+    size_t find_first_of(const char *data, size_t size, const char *set, size_t set_size)
+    {
+        if (set_size == 0 || set_size > 16) return scalar::find_first_of(data, size, set, set_size);
+        alignas(16) char set_buf[16] = {};
+        memcpy(set_buf, set, set_size);
+        const __m128i set_v = _mm_load_si128(reinterpret_cast<const __m128i *>(set_buf));
+        const int len = static_cast<int>(set_size);
+        constexpr int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const int index = _mm_cmpestri(set_v, len, load(data + i), 16, mode);
+            if (index < 16) return i + index;
+        }
+        return search::offset(scalar::find_first_of(data + i, size - i, set, set_size), i);
+    }
+
+    size_t count(const char *data, size_t size, char ch)
+    {
+        const __m128i needle = _mm_set1_epi8(ch);
+        const __m128i zero = _mm_setzero_si128();
+        size_t result = 0, i = 0;
+        while (i + 16 <= size)
+        {
+            // Byte counters are drained every 255 blocks before they can wrap
+            __m128i acc = zero;
+            const size_t stop = i + 255 * 16 < size ? i + 255 * 16 : size;
+            for (; i + 16 <= stop; i += 16) acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(load(data + i), needle));
+            const __m128i sums = _mm_sad_epu8(acc, zero);
+            result += static_cast<size_t>(_mm_cvtsi128_si64(sums)) + _mm_extract_epi64(sums, 1);
+        }
+        return result + scalar::count(data + i, size - i, ch);
+    }
+
+    size_t find_icase(const char *data, size_t size, const char *needle, size_t needle_size)
+    {
+        if (needle_size == 0 || needle_size > size) return scalar::find_icase(data, size, needle, needle_size);
+        const __m128i upper_a = _mm_set1_epi8('A');
+        const __m128i flip = _mm_set1_epi8(0x20);
+        const __m128i first = _mm_set1_epi8(search::ascii_lower(needle[0]));
+        const __m128i last = _mm_set1_epi8(search::ascii_lower(needle[needle_size - 1]));
+        const size_t shift = needle_size - 1;
+
+        size_t i = 0;
+        for (; i + shift + 16 <= size; i += 16)
+        {
+            u32 mask = eq_mask(fold(load(data + i), upper_a, flip), first) &
+                       eq_mask(fold(load(data + i + shift), upper_a, flip), last);
+            while (mask)
+            {
+                const size_t pos = i + pop_lsb(mask);
+                if (search::match_inner_icase(data + pos, needle, needle_size)) return pos;
+            }
+        }
+        return search::offset(scalar::find_icase(data + i, size - i, needle, needle_size), i);
+    }
+
+    void to_lower(const char *src, size_t size, char *dst) { convert_case<false>(src, size, dst); }
+
+    void to_upper(const char *src, size_t size, char *dst) { convert_case<true>(src, size, dst); }
+} // namespace acul::detail::sse42
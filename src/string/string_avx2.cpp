@@ -1,118 +1,129 @@
+#include <acul/string/line_index.hpp>
 #include <acul/string/string_view_pool.hpp>
 #include <immintrin.h>
 
 namespace acul::detail::avx2
 {
-    void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst)
+    namespace
     {
-        const char *const data_end = data + size;
-
-        const __m256i ch_nl = _mm256_set1_epi8('\n');
-        const __m256i ch_cr = _mm256_set1_epi8('\r');
+        template <typename Sink>
+        void split_lines(const char *data, size_t size, Sink &dst)
+        {
+            const char *const data_end = data + size;
 
-        const char *line_start = data;
-        const char *p = data;
+            const __m256i ch_nl = _mm256_set1_epi8('\n');
+            const __m256i ch_cr = _mm256_set1_epi8('\r');
 
-        bool prev_chunk_ended_with_cr = false;
+            const char *line_start = data;
+            const char *p = data;
 
-        while ((p + 32) <= data_end)
-        {
-            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
-            int mask_nl = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, ch_nl));
-            int mask_cr = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, ch_cr));
+            bool prev_chunk_ended_with_cr = false;
 
-            if (prev_chunk_ended_with_cr)
+            while ((p + 32) <= data_end)
             {
-                if (p[0] == '\n')
-                {
-                    size_t line_len = static_cast<size_t>((p - 1) - line_start);
-                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-                    dst.push(line_start, line_len);
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                int mask_nl = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, ch_nl));
+                int mask_cr = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, ch_cr));
 
-                    line_start = p + 1;
-                    mask_nl &= ~1;
-                }
-                else
+                if (prev_chunk_ended_with_cr)
                 {
-                    size_t line_len = static_cast<size_t>((p - 1) - line_start);
-                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-                    dst.push(line_start, line_len);
-                    line_start = p;
+                    if (p[0] == '\n')
+                    {
+                        size_t line_len = static_cast<size_t>((p - 1) - line_start);
+                        if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                        dst.push(line_start, line_len);
+
+                        line_start = p + 1;
+                        mask_nl &= ~1;
+                    }
+                    else
+                    {
+                        size_t line_len = static_cast<size_t>((p - 1) - line_start);
+                        if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                        dst.push(line_start, line_len);
+                        line_start = p;
+                    }
+                    prev_chunk_ended_with_cr = false;
                 }
-                prev_chunk_ended_with_cr = false;
-            }
 
-            bool ends_with_cr = (p[31] == '\r');
-            if (ends_with_cr) { mask_cr &= ~(1u << 31); }
+                bool ends_with_cr = (p[31] == '\r');
+                if (ends_with_cr) { mask_cr &= ~(1u << 31); }
 
-            mask_cr &= ~(mask_nl >> 1);
-            unsigned mask = static_cast<unsigned>(mask_nl | mask_cr);
+                mask_cr &= ~(mask_nl >> 1);
+                unsigned mask = static_cast<unsigned>(mask_nl | mask_cr);
 
-            while (mask)
-            {
-                int index = __builtin_ctz(mask);
-                const char *sep_pos = p + index;
+                while (mask)
+                {
+                    int index = __builtin_ctz(mask);
+                    const char *sep_pos = p + index;
 
-                size_t line_len = static_cast<size_t>(sep_pos - line_start);
-                if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                    size_t line_len = static_cast<size_t>(sep_pos - line_start);
+                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
 
-                dst.push(line_start, line_len);
-                line_start = sep_pos + 1;
+                    dst.push(line_start, line_len);
+                    line_start = sep_pos + 1;
 
-                mask &= (mask - 1);
-            }
+                    mask &= (mask - 1);
+                }
 
-            prev_chunk_ended_with_cr = ends_with_cr;
-            p += 32;
-        }
+                prev_chunk_ended_with_cr = ends_with_cr;
+                p += 32;
+            }
 
-        if (p < data_end)
-        {
-            if (prev_chunk_ended_with_cr)
+            if (p < data_end)
             {
-                if (*p == '\n')
-                {
-                    size_t line_len = static_cast<size_t>((p - 1) - line_start);
-                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-                    dst.push(line_start, line_len);
-                    ++p;
-                    line_start = p;
-                }
-                else
+                if (prev_chunk_ended_with_cr)
                 {
-                    size_t line_len = static_cast<size_t>((p - 1) - line_start);
-                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-                    dst.push(line_start, line_len);
-                    line_start = p;
+                    if (*p == '\n')
+                    {
+                        size_t line_len = static_cast<size_t>((p - 1) - line_start);
+                        if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                        dst.push(line_start, line_len);
+                        ++p;
+                        line_start = p;
+                    }
+                    else
+                    {
+                        size_t line_len = static_cast<size_t>((p - 1) - line_start);
+                        if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                        dst.push(line_start, line_len);
+                        line_start = p;
+                    }
+                    prev_chunk_ended_with_cr = false;
                 }
-                prev_chunk_ended_with_cr = false;
-            }
 
-            const char *s = p;
-            while (s < data_end)
-            {
-                char c = *s;
-                if (c == '\n' || c == '\r')
+                const char *s = p;
+                while (s < data_end)
                 {
-                    bool is_crlf = (c == '\r' && (s + 1) < data_end && s[1] == '\n');
+                    char c = *s;
+                    if (c == '\n' || c == '\r')
+                    {
+                        bool is_crlf = (c == '\r' && (s + 1) < data_end && s[1] == '\n');
 
-                    size_t line_len = static_cast<size_t>(s - line_start);
-                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                        size_t line_len = static_cast<size_t>(s - line_start);
+                        if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
 
-                    dst.push(line_start, line_len);
+                        dst.push(line_start, line_len);
 
-                    if (is_crlf) ++s;
-                    line_start = s + 1;
+                        if (is_crlf) ++s;
+                        line_start = s + 1;
+                    }
+                    ++s;
                 }
-                ++s;
             }
-        }
 
-        if (line_start < data_end)
-        {
-            size_t line_len = static_cast<size_t>(data_end - line_start);
-            if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-            dst.push(line_start, line_len);
+            if (line_start < data_end)
+            {
+                size_t line_len = static_cast<size_t>(data_end - line_start);
+                if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                dst.push(line_start, line_len);
+            }
         }
-    }
+    } // namespace
+
+    void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst) { split_lines(data, size, dst); }
+
+    void fill_line_index(const char *data, size_t size, line_index<u32> &dst) { split_lines(data, size, dst); }
+
+    void fill_line_index(const char *data, size_t size, line_index<u64> &dst) { split_lines(data, size, dst); }
 } // namespace acul::detail::avx2
\ No newline at end of file
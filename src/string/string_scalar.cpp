@@ -1,36 +1,47 @@
 #include <acul/api.hpp>
+#include <acul/string/line_index.hpp>
 #include <acul/string/string_view_pool.hpp>
 
 namespace acul::detail::scalar
 {
-    void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst)
+    namespace
     {
-        const char *p = data;
-        const char *end = data + size;
-        const char *line_start = p;
-
-        while (p < end)
+        template <typename Sink>
+        void split_lines(const char *data, size_t size, Sink &dst)
         {
-            if (*p == '\n')
+            const char *p = data;
+            const char *end = data + size;
+            const char *line_start = p;
+
+            while (p < end)
             {
-                size_t line_len = p - line_start;
-                if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-                dst.push(line_start, line_len);
-                ++p;
-                line_start = p;
+                if (*p == '\n')
+                {
+                    size_t line_len = p - line_start;
+                    if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                    dst.push(line_start, line_len);
+                    ++p;
+                    line_start = p;
+                }
+                else
+                {
+                    ++p;
+                }
             }
-            else
+
+            if (line_start < end)
             {
-                ++p;
+                size_t line_len = end - line_start;
+                if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
+                dst.push(line_start, line_len);
             }
         }
+    } // namespace
 
-        if (line_start < end)
-        {
-            size_t line_len = end - line_start;
-            if (line_len > 0 && line_start[line_len - 1] == '\r') --line_len;
-            dst.push(line_start, line_len);
-        }
-    }
+    void fill_line_buffer(const char *data, size_t size, string_view_pool<char> &dst) { split_lines(data, size, dst); }
+
+    void fill_line_index(const char *data, size_t size, line_index<u32> &dst) { split_lines(data, size, dst); }
+
+    void fill_line_index(const char *data, size_t size, line_index<u64> &dst) { split_lines(data, size, dst); }
 
 } // namespace acul::detail::scalar
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <immintrin.h>
+#include "multi_search.hpp"
+
+// 32-byte version of the SSE4.2 Teddy kernel, the nibble tables are repeated in both 128-bit lanes.
+namespace acul::detail::avx2
+{
+    namespace
+    {
+        template <u32 K>
+        ACUL_FORCEINLINE __m256i candidates(const char *p, const __m256i *lo, const __m256i *hi, __m256i nibble)
+        {
+            __m256i m = _mm256_set1_epi8(-1);
+            for (u32 j = 0; j < K; ++j)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + j));
+                const __m256i l = _mm256_shuffle_epi8(lo[j], _mm256_and_si256(v, nibble));
+                const __m256i h = _mm256_shuffle_epi8(hi[j], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                m = _mm256_and_si256(m, _mm256_and_si256(l, h));
+            }
+            return m;
+        }
+
+        template <u32 K>
+        void scan(const teddy_program &program, const char *data, size_t size, vector<multi_match> &dst)
+        {
+            __m256i lo[K], hi[K];
+            for (u32 j = 0; j < K; ++j)
+            {
+                lo[j] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(program.lo[j])));
+                hi[j] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(program.hi[j])));
+            }
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i zero = _mm256_setzero_si256();
+            alignas(32) u8 lanes[32];
+
+            auto report = [&](__m256i m, size_t base, u32 valid) {
+                u32 mask = ~static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, zero))) & valid;
+                if (!mask) return;
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), m);
+                while (mask)
+                {
+                    const u32 lane = pop_lsb(mask);
+                    teddy_verify(program, data, size, base + lane, lanes[lane], dst);
+                }
+            };
+
+            size_t i = 0;
+            for (; i + 32 + K - 1 <= size; i += 32) report(candidates<K>(data + i, lo, hi, nibble), i, ~0u);
+            for (; i < size; i += 32)
+            {
+                alignas(32) char tail[64] = {};
+                const size_t left = size - i;
+                memcpy(tail, data + i, left < sizeof(tail) ? left : sizeof(tail));
+                report(candidates<K>(tail, lo, hi, nibble), i, left >= 32 ? ~0u : (1u << left) - 1);
+            }
+        }
+    } // namespace
+
+    void teddy_find(const teddy_program &program, const char *data, size_t size, vector<multi_match> &dst)
+    {
+        switch (program.fingerprint)
+        {
+            case 1:
+                scan<1>(program, data, size, dst);
+                break;
+            case 2:
+                scan<2>(program, data, size, dst);
+                break;
+            default:
+                scan<3>(program, data, size, dst);
+                break;
+        }
+    }
+} // namespace acul::detail::avx2
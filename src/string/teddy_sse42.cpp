@@ -0,0 +1,77 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <tmmintrin.h>
+#include "multi_search.hpp"
+
+// Teddy prefilter: each position gets the AND of the bucket bits looked up by the nibbles of its first
+// `fingerprint` bytes, lanes left non-zero are candidates checked against the patterns of their buckets.
+namespace acul::detail::sse42
+{
+    namespace
+    {
+        template <u32 K>
+        ACUL_FORCEINLINE __m128i candidates(const char *p, const __m128i *lo, const __m128i *hi, __m128i nibble)
+        {
+            __m128i m = _mm_set1_epi8(-1);
+            for (u32 j = 0; j < K; ++j)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + j));
+                const __m128i l = _mm_shuffle_epi8(lo[j], _mm_and_si128(v, nibble));
+                const __m128i h = _mm_shuffle_epi8(hi[j], _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+                m = _mm_and_si128(m, _mm_and_si128(l, h));
+            }
+            return m;
+        }
+
+        template <u32 K>
+        void scan(const teddy_program &program, const char *data, size_t size, vector<multi_match> &dst)
+        {
+            __m128i lo[K], hi[K];
+            for (u32 j = 0; j < K; ++j)
+            {
+                lo[j] = _mm_load_si128(reinterpret_cast<const __m128i *>(program.lo[j]));
+                hi[j] = _mm_load_si128(reinterpret_cast<const __m128i *>(program.hi[j]));
+            }
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i zero = _mm_setzero_si128();
+            alignas(16) u8 lanes[16];
+
+            auto report = [&](__m128i m, size_t base, u32 valid) {
+                u32 mask = ~static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m, zero))) & valid;
+                if (!mask) return;
+                _mm_store_si128(reinterpret_cast<__m128i *>(lanes), m);
+                while (mask)
+                {
+                    const u32 lane = pop_lsb(mask);
+                    teddy_verify(program, data, size, base + lane, lanes[lane], dst);
+                }
+            };
+
+            size_t i = 0;
+            for (; i + 16 + K - 1 <= size; i += 16) report(candidates<K>(data + i, lo, hi, nibble), i, 0xFFFF);
+            // The last positions are classified from a zero-padded copy so the loads stay in bounds
+            for (; i < size; i += 16)
+            {
+                alignas(16) char tail[32] = {};
+                const size_t left = size - i;
+                memcpy(tail, data + i, left < sizeof(tail) ? left : sizeof(tail));
+                report(candidates<K>(tail, lo, hi, nibble), i, left >= 16 ? 0xFFFF : (1u << left) - 1);
+            }
+        }
+    } // namespace
+
+    void teddy_find(const teddy_program &program, const char *data, size_t size, vector<multi_match> &dst)
+    {
+        switch (program.fingerprint)
+        {
+            case 1:
+                scan<1>(program, data, size, dst);
+                break;
+            case 2:
+                scan<2>(program, data, size, dst);
+                break;
+            default:
+                scan<3>(program, data, size, dst);
+                break;
+        }
+    }
+} // namespace acul::detail::sse42
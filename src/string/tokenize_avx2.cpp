@@ -0,0 +1,76 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <immintrin.h>
+#include "tokenize_scalar.hpp"
+
+// 64-byte blocks from two 32-byte compares, otherwise the same as the SSE4.2 kernel.
+namespace acul::detail::avx2
+{
+    namespace
+    {
+        struct block_masks
+        {
+            u64 delim;
+            u64 quote;
+            u64 nl;
+        };
+
+        ACUL_FORCEINLINE block_masks classify(const char *p, const __m256i *delims, size_t delim_count, __m256i quote,
+                                              __m256i nl)
+        {
+            block_masks m{0, 0, 0};
+            for (int k = 0; k < 64 / 32; ++k)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + k * 32));
+                __m256i d = _mm256_cmpeq_epi8(v, delims[0]);
+                for (size_t i = 1; i < delim_count; ++i) d = _mm256_or_si256(d, _mm256_cmpeq_epi8(v, delims[i]));
+                const int shift = k * 32;
+                auto bits = [shift](__m256i x) {
+                    return static_cast<u64>(static_cast<u32>(_mm256_movemask_epi8(x))) << shift;
+                };
+                m.delim |= bits(d);
+                m.quote |= bits(_mm256_cmpeq_epi8(v, quote));
+                m.nl |= bits(_mm256_cmpeq_epi8(v, nl));
+            }
+            return m;
+        }
+    } // namespace
+
+    void tokenize(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                  token_table &dst)
+    {
+        if (delim_count == 0 || delim_count > 16) return scalar::tokenize(data, size, delims, delim_count, quote, dst);
+        __m256i delim_v[16];
+        for (size_t i = 0; i < delim_count; ++i) delim_v[i] = _mm256_set1_epi8(delims[i]);
+        const __m256i quote_v = _mm256_set1_epi8(quote);
+        const __m256i nl_v = _mm256_set1_epi8('\n');
+
+        const char *const end = data + size;
+        const char *field_start = data;
+        u64 inside_carry = 0;
+        for (size_t i = 0; i < size; i += 64)
+        {
+            // The tail is classified from a padded copy and masked to the valid bytes
+            alignas(64) char tail[64];
+            const char *block = data + i;
+            u64 valid = ~u64(0);
+            if (size - i < 64)
+            {
+                memset(tail, 0, sizeof(tail));
+                memcpy(tail, block, size - i);
+                block = tail;
+                valid = (u64(1) << (size - i)) - 1;
+            }
+            const block_masks m = classify(block, delim_v, delim_count, quote_v, nl_v);
+            u64 inside = 0;
+            if (quote)
+            {
+                // Quote toggles, carried over from the previous block
+                inside = tokenize::prefix_xor(m.quote & valid) ^ inside_carry;
+                inside_carry = static_cast<u64>(static_cast<i64>(inside) >> 63);
+            }
+            const u64 seps = (m.delim | m.nl) & ~inside & valid;
+            tokenize::emit_block(data + i, seps, m.nl, field_start, quote, dst);
+        }
+        tokenize::finish(field_start, end, quote, dst);
+    }
+} // namespace acul::detail::avx2
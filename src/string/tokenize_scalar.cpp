@@ -0,0 +1,37 @@
+#include "tokenize_scalar.hpp"
+
+namespace acul::detail::scalar
+{
+    void tokenize(const char *data, size_t size, const char *delims, size_t delim_count, char quote,
+                  token_table &dst)
+    {
+        u64 bitmap[4] = {};
+        for (size_t i = 0; i < delim_count; ++i)
+        {
+            const u8 c = static_cast<u8>(delims[i]);
+            bitmap[c >> 6] |= u64(1) << (c & 63);
+        }
+
+        const char *const end = data + size;
+        const char *field_start = data;
+        bool inside = false;
+        for (const char *p = data; p < end; ++p)
+        {
+            const char c = *p;
+            if (quote && c == quote) inside = !inside;
+            else if (inside) continue;
+            else if (c == '\n')
+            {
+                tokenize::emit_field(field_start, p, true, quote, dst);
+                dst.end_record();
+                field_start = p + 1;
+            }
+            else if (bitmap[static_cast<u8>(c) >> 6] & (u64(1) << (c & 63)))
+            {
+                tokenize::emit_field(field_start, p, false, quote, dst);
+                field_start = p + 1;
+            }
+        }
+        tokenize::finish(field_start, end, quote, dst);
+    }
+} // namespace acul::detail::scalar
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <acul/bit.hpp>
+#include <acul/string/tokenizer.hpp>
+
+// Field emission shared by the tokenizer kernels, so every ISA trims fields the same way.
+namespace acul::detail::tokenize
+{
+    ACUL_FORCEINLINE void emit_field(const char *begin, const char *end, bool at_newline, char quote, token_table &dst)
+    {
+        if (at_newline && end > begin && end[-1] == '\r') --end;
+        if (quote && end - begin >= 2 && *begin == quote && end[-1] == quote)
+        {
+            ++begin;
+            --end;
+        }
+        dst.push(begin, end - begin);
+    }
+
+    /// Closes the last record when the text does not end with a newline.
+    ACUL_FORCEINLINE void finish(const char *field_start, const char *end, char quote, token_table &dst)
+    {
+        if (field_start < end || dst.record_open())
+        {
+            emit_field(field_start, end, true, quote, dst);
+            dst.end_record();
+        }
+    }
+
+    /// Mask with bit i set when an odd number of bits at or below i are set in `x`.
+    ACUL_FORCEINLINE u64 prefix_xor(u64 x)
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    /**
+     * @brief Emits the fields ending in one 64-byte block.
+     * @param seps Delimiters and newlines outside quotes, relative to `base`.
+     * @param nl Newlines in the block.
+     */
+    ACUL_FORCEINLINE void emit_block(const char *base, u64 seps, u64 nl, const char *&field_start, char quote,
+                                     token_table &dst)
+    {
+        while (seps)
+        {
+            const unsigned bit = ctz64(seps);
+            const bool at_newline = (nl >> bit) & 1;
+            emit_field(field_start, base + bit, at_newline, quote, dst);
+            if (at_newline) dst.end_record();
+            field_start = base + bit + 1;
+            seps &= seps - 1;
+        }
+    }
+} // namespace acul::detail::tokenize
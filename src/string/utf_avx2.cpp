@@ -0,0 +1,211 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <immintrin.h>
+#include "utf_scalar.hpp"
+
+// 32-byte version of the SSE4.2 kernels; the lookup tables are repeated in both 128-bit lanes.
+namespace acul::detail::avx2
+{
+    namespace
+    {
+        enum : u8
+        {
+            too_short = 1 << 0,
+            too_long = 1 << 1,
+            overlong_3 = 1 << 2,
+            too_large = 1 << 3,
+            surrogate = 1 << 4,
+            overlong_2 = 1 << 5,
+            too_large_1000 = 1 << 6,
+            overlong_4 = 1 << 6,
+            two_conts = 1 << 7,
+            carry = too_short | too_long | two_conts
+        };
+
+        ACUL_FORCEINLINE __m256i lookup(__m128i table, __m256i index)
+        {
+            return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(table), index);
+        }
+
+        /// Input shifted right by N bytes with the tail of the previous block shifted in.
+        template <int N>
+        ACUL_FORCEINLINE __m256i prev(__m256i input, __m256i prev_input)
+        {
+            return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+        }
+
+        struct utf8_checker
+        {
+            __m256i error = _mm256_setzero_si256();
+            __m256i prev_input = _mm256_setzero_si256();
+            __m256i prev_incomplete = _mm256_setzero_si256();
+
+            static ACUL_FORCEINLINE __m256i high_nibbles(__m256i v)
+            {
+                return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+            }
+
+            ACUL_FORCEINLINE void check(__m256i input)
+            {
+                if (_mm256_movemask_epi8(input) == 0)
+                {
+                    error = _mm256_or_si256(error, prev_incomplete);
+                    prev_incomplete = _mm256_setzero_si256();
+                    prev_input = input;
+                    return;
+                }
+
+                const __m256i prev1 = prev<1>(input, prev_input);
+                const __m256i byte_1_high = lookup(
+                    _mm_setr_epi8(too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                                  two_conts, two_conts, two_conts, two_conts, too_short | overlong_2, too_short,
+                                  too_short | overlong_3 | surrogate,
+                                  too_short | too_large | too_large_1000 | overlong_4),
+                    high_nibbles(prev1));
+                constexpr u8 large = carry | too_large | too_large_1000;
+                const __m256i byte_1_low =
+                    lookup(_mm_setr_epi8(carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+                                         carry | too_large, large, large, large, large, large, large, large, large,
+                                         large | surrogate, large, large),
+                           _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+                constexpr u8 cont_1000 = too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4;
+                constexpr u8 cont_1001 = too_long | overlong_2 | two_conts | overlong_3 | too_large;
+                constexpr u8 cont_101 = too_long | overlong_2 | two_conts | surrogate | too_large;
+                const __m256i byte_2_high =
+                    lookup(_mm_setr_epi8(too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                                         too_short, cont_1000, cont_1001, cont_101, cont_101, too_short, too_short,
+                                         too_short, too_short),
+                           high_nibbles(input));
+                const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+                const __m256i third =
+                    _mm256_subs_epu8(prev<2>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                const __m256i fourth =
+                    _mm256_subs_epu8(prev<3>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                const __m256i must23 =
+                    _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+                error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+
+                prev_incomplete = _mm256_subs_epu8(
+                    input, _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+                                            static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)));
+                prev_input = input;
+            }
+
+            bool valid() const
+            {
+                const __m256i all = _mm256_or_si256(error, prev_incomplete);
+                return _mm256_testz_si256(all, all);
+            }
+        };
+
+        ACUL_FORCEINLINE u32 utf16_units(__m256i input)
+        {
+            const u32 leads = _mm256_movemask_epi8(_mm256_cmpgt_epi8(input, _mm256_set1_epi8(-65)));
+            const __m256i lead4 = _mm256_set1_epi8(static_cast<char>(0xF0));
+            const u32 wide = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(input, lead4), input));
+            return popcount32(leads) + popcount32(wide);
+        }
+    } // namespace
+
+    size_t utf8_to_utf16_length(const char *data, size_t size)
+    {
+        utf8_checker checker;
+        size_t count = 0, i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            checker.check(input);
+            count += utf16_units(input);
+        }
+        if (i < size)
+        {
+            alignas(32) char tail[32] = {};
+            memcpy(tail, data + i, size - i);
+            const __m256i input = _mm256_load_si256(reinterpret_cast<const __m256i *>(tail));
+            checker.check(input);
+            count += utf16_units(input) - (32 - (size - i));
+        }
+        return checker.valid() ? count : utf::invalid;
+    }
+
+    size_t utf8_to_utf16(const char *data, size_t size, c16 *dst)
+    {
+        const u8 *p = reinterpret_cast<const u8 *>(data);
+        const u8 *const end = p + size;
+        c16 *out = dst;
+        while (end - p >= 32)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                                    _mm256_cvtepu8_epi16(_mm256_castsi256_si128(input)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 16),
+                                    _mm256_cvtepu8_epi16(_mm256_extracti128_si256(input, 1)));
+                p += 32;
+                out += 32;
+            }
+            else out = utf::convert_utf8(p, p + 32, end, out);
+        }
+        return utf::convert_utf8(p, end, end, out) - dst;
+    }
+
+    size_t utf16_to_utf8_length(const c16 *data, size_t size)
+    {
+        const __m256i ascii_mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        const __m256i bmp_mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+        const __m256i surrogate = _mm256_set1_epi16(static_cast<short>(0xD800));
+        const __m256i zero = _mm256_setzero_si256();
+        const c16 *p = data;
+        const c16 *const end = data + size;
+        size_t count = 0;
+        while (end - p >= 16)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            const __m256i high = _mm256_and_si256(input, bmp_mask);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(high, surrogate)) == 0)
+            {
+                const u32 ascii =
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(input, ascii_mask), zero));
+                const u32 two = _mm256_movemask_epi8(_mm256_cmpeq_epi16(high, zero));
+                count += 16 + (32 - popcount32(ascii)) / 2 + (32 - popcount32(two)) / 2;
+                p += 16;
+                continue;
+            }
+            const c16 *stop = p + 16;
+            while (p < stop)
+            {
+                u32 cp;
+                const int n = utf::decode_utf16(p, end, cp);
+                if (n < 0) return utf::invalid;
+                p += n;
+                count += utf::utf8_size(cp);
+            }
+        }
+        const size_t rest = utf::utf8_length(p, end);
+        return rest == utf::invalid ? rest : count + rest;
+    }
+
+    size_t utf16_to_utf8(const c16 *data, size_t size, char *dst)
+    {
+        const __m256i ascii_mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        const c16 *p = data;
+        const c16 *const end = data + size;
+        char *out = dst;
+        while (end - p >= 16)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            if (_mm256_testz_si256(input, ascii_mask))
+            {
+                // packus interleaves the lanes; restore the order before storing the low half
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(input, input), 0xD8);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(packed));
+                p += 16;
+                out += 16;
+            }
+            else out = utf::convert_utf16(p, p + 16, end, out);
+        }
+        return utf::convert_utf16(p, end, end, out) - dst;
+    }
+} // namespace acul::detail::avx2
@@ -0,0 +1,26 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include "utf_scalar.hpp"
+
+namespace acul::detail::scalar
+{
+    size_t utf8_to_utf16_length(const char *data, size_t size)
+    {
+        const u8 *p = reinterpret_cast<const u8 *>(data);
+        return utf::utf16_length(p, p + size);
+    }
+
+    size_t utf8_to_utf16(const char *data, size_t size, c16 *dst)
+    {
+        const u8 *p = reinterpret_cast<const u8 *>(data);
+        const u8 *end = p + size;
+        return utf::convert_utf8(p, end, end, dst) - dst;
+    }
+
+    size_t utf16_to_utf8_length(const c16 *data, size_t size) { return utf::utf8_length(data, data + size); }
+
+    size_t utf16_to_utf8(const c16 *data, size_t size, char *dst)
+    {
+        const c16 *end = data + size;
+        return utf::convert_utf16(data, end, end, dst) - dst;
+    }
+} // namespace acul::detail::scalar
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <acul/api.hpp>
+#include <acul/bit.hpp>
+#include <acul/scalars.hpp>
+
+// Scalar UTF-8/UTF-16 primitives shared by every ISA kernel for tails and non-ASCII blocks.
+namespace acul::detail::utf
+{
+    /// Returned by the length pre-passes for ill-formed input.
+    constexpr size_t invalid = SIZE_MAX;
+
+    constexpr u32 replacement_char = 0xFFFD;
+
+    /**
+     * @brief Decodes one UTF-8 sequence.
+     * @return Bytes consumed, or minus the length of the maximal ill-formed subpart to skip
+     */
+    ACUL_FORCEINLINE int decode_utf8(const u8 *p, const u8 *end, u32 &cp)
+    {
+        const u8 b0 = p[0];
+        if (b0 < 0x80)
+        {
+            cp = b0;
+            return 1;
+        }
+
+        int len;
+        u8 lo = 0x80, hi = 0xBF;
+        if (b0 < 0xC2) return -1;
+        else if (b0 < 0xE0)
+        {
+            len = 2;
+            cp = b0 & 0x1F;
+        }
+        else if (b0 < 0xF0)
+        {
+            len = 3;
+            cp = b0 & 0x0F;
+            if (b0 == 0xE0) lo = 0xA0;      // overlong
+            else if (b0 == 0xED) hi = 0x9F; // surrogates
+        }
+        else if (b0 < 0xF5)
+        {
+            len = 4;
+            cp = b0 & 0x07;
+            if (b0 == 0xF0) lo = 0x90;      // overlong
+            else if (b0 == 0xF4) hi = 0x8F; // above U+10FFFF
+        }
+        else return -1;
+
+        for (int i = 1; i < len; ++i)
+        {
+            if (p + i >= end || p[i] < lo || p[i] > hi) return -i;
+            lo = 0x80;
+            hi = 0xBF;
+            cp = (cp << 6) | (p[i] & 0x3F);
+        }
+        return len;
+    }
+
+    /**
+     * @brief Decodes one UTF-16 code point.
+     * @return Units consumed, or -1 for an unpaired surrogate
+     */
+    ACUL_FORCEINLINE int decode_utf16(const c16 *p, const c16 *end, u32 &cp)
+    {
+        const u32 u = p[0];
+        if (u - 0xD800 >= 0x800)
+        {
+            cp = u;
+            return 1;
+        }
+        if (u <= 0xDBFF && p + 1 < end && static_cast<u32>(p[1] - 0xDC00) < 0x400)
+        {
+            cp = 0x10000 + ((u - 0xD800) << 10) + (p[1] - 0xDC00);
+            return 2;
+        }
+        return -1;
+    }
+
+    ACUL_FORCEINLINE int utf8_size(u32 cp) { return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4; }
+
+    ACUL_FORCEINLINE int utf16_size(u32 cp) { return cp < 0x10000 ? 1 : 2; }
+
+    ACUL_FORCEINLINE int encode_utf8(u32 cp, char *out)
+    {
+        if (cp < 0x80)
+        {
+            out[0] = static_cast<char>(cp);
+            return 1;
+        }
+        if (cp < 0x800)
+        {
+            out[0] = static_cast<char>(0xC0 | (cp >> 6));
+            out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        if (cp < 0x10000)
+        {
+            out[0] = static_cast<char>(0xE0 | (cp >> 12));
+            out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+
+    ACUL_FORCEINLINE int encode_utf16(u32 cp, c16 *out)
+    {
+        if (cp < 0x10000)
+        {
+            out[0] = static_cast<c16>(cp);
+            return 1;
+        }
+        cp -= 0x10000;
+        out[0] = static_cast<c16>(0xD800 + (cp >> 10));
+        out[1] = static_cast<c16>(0xDC00 + (cp & 0x3FF));
+        return 2;
+    }
+
+    /// UTF-16 length of the UTF-8 range starting at `p`, or `invalid`.
+    inline size_t utf16_length(const u8 *p, const u8 *end)
+    {
+        size_t count = 0;
+        while (p < end)
+        {
+            if (end - p >= 8 && (load_u64u(p) & 0x8080808080808080ULL) == 0)
+            {
+                p += 8;
+                count += 8;
+                continue;
+            }
+            u32 cp;
+            const int n = decode_utf8(p, end, cp);
+            if (n < 0) return invalid;
+            p += n;
+            count += n == 4 ? 2 : 1;
+        }
+        return count;
+    }
+
+    /// Converts well-formed UTF-8 up to `end`; stops after the code point that crosses `stop`.
+    inline c16 *convert_utf8(const u8 *&p, const u8 *stop, const u8 *end, c16 *out)
+    {
+        while (p < stop)
+        {
+            u32 cp;
+            p += decode_utf8(p, end, cp);
+            out += encode_utf16(cp, out);
+        }
+        return out;
+    }
+
+    /// UTF-8 length of the UTF-16 range starting at `p`, or `invalid`.
+    inline size_t utf8_length(const c16 *p, const c16 *end)
+    {
+        size_t count = 0;
+        while (p < end)
+        {
+            u32 cp;
+            const int n = decode_utf16(p, end, cp);
+            if (n < 0) return invalid;
+            p += n;
+            count += utf8_size(cp);
+        }
+        return count;
+    }
+
+    /// Converts well-formed UTF-16 up to `end`; stops after the code point that crosses `stop`.
+    inline char *convert_utf16(const c16 *&p, const c16 *stop, const c16 *end, char *out)
+    {
+        while (p < stop)
+        {
+            u32 cp;
+            p += decode_utf16(p, end, cp);
+            out += encode_utf8(cp, out);
+        }
+        return out;
+    }
+} // namespace acul::detail::utf
@@ -0,0 +1,200 @@
+#include <acul/string/detail/string_isa_fn.hpp>
+#include <smmintrin.h>
+#include "utf_scalar.hpp"
+
+// UTF-8 validation follows the lookup algorithm of Keiser and Lemire ("Validating UTF-8 In Less Than One
+// Instruction Per Byte"): three 16-entry tables indexed by nibbles of each byte and its predecessor flag
+// every two-byte error pattern, and a saturating compare checks the third and fourth bytes.
+namespace acul::detail::sse42
+{
+    namespace
+    {
+        enum : u8
+        {
+            too_short = 1 << 0,      // lead byte followed by a lead or ASCII byte
+            too_long = 1 << 1,       // ASCII followed by a continuation
+            overlong_3 = 1 << 2,     // E0 80..9F
+            too_large = 1 << 3,      // F4 90..BF, F5+
+            surrogate = 1 << 4,      // ED A0..BF
+            overlong_2 = 1 << 5,     // C0..C1
+            too_large_1000 = 1 << 6, // F5+ 80..8F
+            overlong_4 = 1 << 6,     // F0 80..8F
+            two_conts = 1 << 7,      // continuation after continuation, unless a 3/4-byte sequence needs it
+            carry = too_short | too_long | two_conts
+        };
+
+        struct utf8_checker
+        {
+            __m128i error = _mm_setzero_si128();
+            __m128i prev_input = _mm_setzero_si128();
+            __m128i prev_incomplete = _mm_setzero_si128();
+
+            static ACUL_FORCEINLINE __m128i high_nibbles(__m128i v)
+            {
+                return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+            }
+
+            ACUL_FORCEINLINE void check(__m128i input)
+            {
+                if (_mm_movemask_epi8(input) == 0)
+                {
+                    // An ASCII block is fine unless the previous one ended inside a sequence
+                    error = _mm_or_si128(error, prev_incomplete);
+                    prev_incomplete = _mm_setzero_si128();
+                    prev_input = input;
+                    return;
+                }
+
+                const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+                const __m128i byte_1_high = _mm_shuffle_epi8(
+                    _mm_setr_epi8(too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                                  two_conts, two_conts, two_conts, two_conts, too_short | overlong_2, too_short,
+                                  too_short | overlong_3 | surrogate,
+                                  too_short | too_large | too_large_1000 | overlong_4),
+                    high_nibbles(prev1));
+                constexpr u8 large = carry | too_large | too_large_1000;
+                const __m128i byte_1_low = _mm_shuffle_epi8(
+                    _mm_setr_epi8(carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+                                  carry | too_large, large, large, large, large, large, large, large, large,
+                                  large | surrogate, large, large),
+                    _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+                constexpr u8 cont_1000 = too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4;
+                constexpr u8 cont_1001 = too_long | overlong_2 | two_conts | overlong_3 | too_large;
+                constexpr u8 cont_101 = too_long | overlong_2 | two_conts | surrogate | too_large;
+                const __m128i byte_2_high = _mm_shuffle_epi8(
+                    _mm_setr_epi8(too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                                  too_short, cont_1000, cont_1001, cont_101, cont_101, too_short, too_short, too_short,
+                                  too_short),
+                    high_nibbles(input));
+                const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+                // Bytes two and three after a 3/4-byte lead must be continuations, which two_conts flagged
+                const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+                const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+                const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+                error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+
+                prev_incomplete = _mm_subs_epu8(
+                    input, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+                                         static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)));
+                prev_input = input;
+            }
+
+            bool valid() const
+            {
+                const __m128i all = _mm_or_si128(error, prev_incomplete);
+                return _mm_testz_si128(all, all);
+            }
+        };
+
+        /// UTF-16 units of a valid block: every non-continuation byte, plus one more for 4-byte leads.
+        ACUL_FORCEINLINE u32 utf16_units(__m128i input)
+        {
+            const u32 leads = _mm_movemask_epi8(_mm_cmpgt_epi8(input, _mm_set1_epi8(-65)));
+            const __m128i lead4 = _mm_set1_epi8(static_cast<char>(0xF0));
+            const u32 wide = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(input, lead4), input));
+            return popcount32(leads) + popcount32(wide);
+        }
+    } // namespace
+
+    size_t utf8_to_utf16_length(const char *data, size_t size)
+    {
+        utf8_checker checker;
+        size_t count = 0, i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            checker.check(input);
+            count += utf16_units(input);
+        }
+        if (i < size)
+        {
+            // Zero padding reads as ASCII: it completes nothing and is not counted
+            alignas(16) char tail[16] = {};
+            memcpy(tail, data + i, size - i);
+            const __m128i input = _mm_load_si128(reinterpret_cast<const __m128i *>(tail));
+            checker.check(input);
+            count += utf16_units(input) - (16 - (size - i));
+        }
+        return checker.valid() ? count : utf::invalid;
+    }
+
+    size_t utf8_to_utf16(const char *data, size_t size, c16 *dst)
+    {
+        const u8 *p = reinterpret_cast<const u8 *>(data);
+        const u8 *const end = p + size;
+        c16 *out = dst;
+        while (end - p >= 16)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            if (_mm_movemask_epi8(input) == 0)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_cvtepu8_epi16(input));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_cvtepu8_epi16(_mm_srli_si128(input, 8)));
+                p += 16;
+                out += 16;
+            }
+            else out = utf::convert_utf8(p, p + 16, end, out);
+        }
+        return utf::convert_utf8(p, end, end, out) - dst;
+    }
+
+    size_t utf16_to_utf8_length(const c16 *data, size_t size)
+    {
+        const __m128i ascii_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i bmp_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+        const __m128i surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+        const __m128i zero = _mm_setzero_si128();
+        const c16 *p = data;
+        const c16 *const end = data + size;
+        size_t count = 0;
+        while (end - p >= 8)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const __m128i high = _mm_and_si128(input, bmp_mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate)) == 0)
+            {
+                // 1 byte per unit, +1 from U+0080, +1 from U+0800; movemask sets two bits per unit
+                const u32 ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(input, ascii_mask), zero));
+                const u32 two = _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero));
+                count += 8 + (16 - popcount32(ascii)) / 2 + (16 - popcount32(two)) / 2;
+                p += 8;
+                continue;
+            }
+            // Pairs may straddle the block end, so the scalar step can run one unit past it
+            const c16 *stop = p + 8;
+            while (p < stop)
+            {
+                u32 cp;
+                const int n = utf::decode_utf16(p, end, cp);
+                if (n < 0) return utf::invalid;
+                p += n;
+                count += utf::utf8_size(cp);
+            }
+        }
+        const size_t rest = utf::utf8_length(p, end);
+        return rest == utf::invalid ? rest : count + rest;
+    }
+
+    size_t utf16_to_utf8(const c16 *data, size_t size, char *dst)
+    {
+        const __m128i ascii_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const c16 *p = data;
+        const c16 *const end = data + size;
+        char *out = dst;
+        while (end - p >= 8)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            if (_mm_testz_si128(input, ascii_mask))
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(input, input));
+                p += 8;
+                out += 8;
+            }
+            else out = utf::convert_utf16(p, p + 8, end, out);
+        }
+        return utf::convert_utf16(p, end, end, out) - dst;
+    }
+} // namespace acul::detail::sse42
@@ -1,7 +1,11 @@
+#include <acul/string/string_view_pool.hpp>
 #include <acul/string/utils.hpp>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
 #include <cmath>
 #include <cstdarg>
 #include <cstring>
+#include "utf_scalar.hpp"
 
 #ifdef _WIN32
     #include <winnls.h>
@@ -9,57 +13,70 @@
 
 namespace acul
 {
-    u16string utf8_to_utf16(const string &src)
+    u16string utf8_to_utf16(const char *data, size_t size)
     {
-        u16string out;
-        unsigned int codepoint;
-        for (size_t i = 0; i < src.size();)
+        const auto &utf = detail::g_isa_dispatcher.utf;
+        u16string result;
+        size_t length = utf.utf8_to_utf16_length(data, size);
+        if (length != detail::utf::invalid)
         {
-            unsigned char ch = static_cast<unsigned char>(src[i]);
-            if (ch <= 0x7f)
-                codepoint = ch;
-            else if (ch <= 0xbf)
-                codepoint = (codepoint << 6) | (ch & 0x3f);
-            else if (ch <= 0xdf)
-                codepoint = ch & 0x1f;
-            else if (ch <= 0xef)
-                codepoint = ch & 0x0f;
-            else
-                codepoint = ch & 0x07;
-            i++;
-            if (((src[i] & 0xc0) != 0x80) && (codepoint <= 0x10ffff))
-            {
-                if (codepoint > 0xffff)
-                {
-                    c16 buf[2] = {static_cast<c16>((codepoint >> 10) + 0xd800),
-                                  static_cast<c16>((codepoint & 0x03ff) + 0xdc00)};
-                    out.append(buf, 2);
-                }
-                else if (codepoint < 0xd800 || codepoint >= 0xe000)
-                    out.push_back(codepoint);
-            }
+            result.resize(length);
+            utf.utf8_to_utf16(data, size, result.data());
+            return result;
+        }
+
+        // Ill-formed input: measure and convert again with each maximal invalid subpart as U+FFFD
+        const u8 *begin = reinterpret_cast<const u8 *>(data);
+        const u8 *end = begin + size;
+        length = 0;
+        for (const u8 *p = begin; p < end;)
+        {
+            u32 cp;
+            const int n = detail::utf::decode_utf8(p, end, cp);
+            p += n < 0 ? -n : n;
+            length += n < 0 ? 1 : detail::utf::utf16_size(cp);
         }
-        return out;
+        result.resize(length);
+        c16 *out = result.data();
+        for (const u8 *p = begin; p < end;)
+        {
+            u32 cp;
+            const int n = detail::utf::decode_utf8(p, end, cp);
+            p += n < 0 ? -n : n;
+            out += detail::utf::encode_utf16(n < 0 ? detail::utf::replacement_char : cp, out);
+        }
+        return result;
     }
 
-    string utf16_to_utf8(const u16string &src)
+    string utf16_to_utf8(const c16 *data, size_t size)
     {
+        const auto &utf = detail::g_isa_dispatcher.utf;
         string result;
-        for (auto cp : src)
+        size_t length = utf.utf16_to_utf8_length(data, size);
+        if (length != detail::utf::invalid)
         {
-            if (cp < 0x80)
-                result.push_back(static_cast<u8>(cp));
-            else if (cp < 0x800)
-            {
-                u8 chs[] = {static_cast<u8>((cp >> 6) | 0xc0), static_cast<u8>((cp & 0x3f) | 0x80)};
-                result.append(std::begin(chs), std::end(chs));
-            }
-            else
-            {
-                u8 chs[] = {static_cast<u8>((cp >> 12) | 0xe0), static_cast<u8>(((cp >> 6) & 0x3f) | 0x80),
-                            static_cast<u8>((cp & 0x3f) | 0x80)};
-                result.append(std::begin(chs), std::end(chs));
-            }
+            result.resize(length);
+            utf.utf16_to_utf8(data, size, result.data());
+            return result;
+        }
+
+        const c16 *end = data + size;
+        length = 0;
+        for (const c16 *p = data; p < end;)
+        {
+            u32 cp;
+            const int n = detail::utf::decode_utf16(p, end, cp);
+            p += n < 0 ? 1 : n;
+            length += n < 0 ? 3 : detail::utf::utf8_size(cp);
+        }
+        result.resize(length);
+        char *out = result.data();
+        for (const c16 *p = data; p < end;)
+        {
+            u32 cp;
+            const int n = detail::utf::decode_utf16(p, end, cp);
+            p += n < 0 ? 1 : n;
+            out += detail::utf::encode_utf8(n < 0 ? detail::utf::replacement_char : cp, out);
         }
         return result;
     }
@@ -87,154 +104,33 @@ namespace acul
         return output.substr(from, to);
     }
 
-#if defined(__clang__)
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wvla-cxx-extension"
-#endif
     string format(const char *format, ...) noexcept
     {
-        string result;
         va_list args;
         va_start(args, format);
-
-        va_list args_copy;
-        va_copy(args_copy, args);
-        int size = vsnprintf(nullptr, 0, format, args_copy) + 1;
-        va_end(args_copy);
-
-        if (size <= 1) { result = ""; }
-        else
-        {
-            char buf[size];
-            vsnprintf(buf, size, format, args);
-            result = string(buf, buf + size - 1);
-        }
-
+        string result = format_va_list(format, args);
         va_end(args);
         return result;
     }
 
     string format_va_list(const char *format, va_list args) noexcept
     {
-        string result;
+        // Most messages fit the stack buffer and are rendered once. Longer ones are rendered again
+        // straight into the result storage.
+        char buf[256];
         va_list args_copy;
         va_copy(args_copy, args);
-        int size = vsnprintf(nullptr, 0, format, args_copy) + 1;
+        int size = vsnprintf(buf, sizeof(buf), format, args_copy);
         va_end(args_copy);
-        if (size <= 1)
-            result = "";
-        else
-        {
-            char buf[size];
-            va_copy(args_copy, args);
-            vsnprintf(buf, size, format, args_copy);
-            va_end(args_copy);
-            result = string(buf, buf + size - 1);
-        }
-        return result;
-    }
-
-    int to_string(f32 value, char *buffer, size_t buffer_size, int precision)
-    {
-        if (buffer_size < 2) return 0;
-
-        char *ptr = buffer;
-        if (value < 0)
-        {
-            *ptr = '-';
-            value = -value;
-            ptr++;
-            buffer_size--;
-        }
-
-        if (fabs(value) < pow(10, -precision))
-        {
-            if (buffer_size >= 2)
-            {
-                *ptr = '0';
-                ptr++;
-                --buffer_size;
-                if (precision > 0 && buffer_size > static_cast<size_t>(precision + 1))
-                {
-                    *ptr = '.';
-                    ptr++;
-
-                    for (int i = 0; i < precision; i++)
-                    {
-                        *ptr = '0';
-                        ptr++;
-                    }
-
-                    return ptr - buffer;
-                }
-                return ptr - buffer - 1;
-            }
-            else
-                return 0;
-        }
-
-        f32 temp_value = value;
-        int num_digits = 0;
-        if (temp_value >= 1)
-        {
-            while (temp_value >= 1)
-            {
-                ++num_digits;
-                temp_value /= 10;
-            }
-        }
-        int int_value = (int)value;
-        if (num_digits < 0 || (size_t)num_digits > buffer_size - 1) return 0;
+        if (size <= 0) return string();
+        if (static_cast<size_t>(size) < sizeof(buf)) return string(buf, static_cast<size_t>(size));
 
-        // Reverse order array for storing digits
-        char reverse_order[num_digits];
-
-        int i = 0;
-        do {
-            reverse_order[i++] = int_value % 10;
-            int_value /= 10;
-        } while (int_value);
-
-        // Writing digits to the buffer in the correct order
-        while (i--)
-        {
-            *ptr = '0' + reverse_order[i];
-            ptr++;
-        }
-
-        if (value - (int)value > 0 || precision > 0)
-        {
-            if (buffer_size - num_digits - 2 < 0) return 0;
-
-            *ptr = '.';
-            ptr++;
-
-            f32 fraction = value - (int)value;
-
-            int num_fractional_digits = 0;
-            while (fraction > 0 && (num_fractional_digits < precision || precision == 0) && buffer_size > 2)
-            {
-                fraction *= 10;
-                int digit = (int)(fraction + 0.5f);
-                fraction -= digit;
-                *ptr = '0' + digit;
-                ptr++;
-                ++num_fractional_digits;
-            }
-
-            while (num_fractional_digits < precision)
-            {
-                *ptr = '0';
-                ++ptr;
-                ++num_fractional_digits;
-            }
-        }
-
-        return ptr - buffer;
+        string result(static_cast<size_t>(size), '\0');
+        va_copy(args_copy, args);
+        vsnprintf(result.data(), static_cast<size_t>(size) + 1, format, args_copy);
+        va_end(args_copy);
+        return result;
     }
-#if defined(__clang__)
-    #pragma clang diagnostic pop
-#endif
 
     bool stoi(const char *&str, int &value)
     {
@@ -305,82 +201,6 @@ namespace acul
         return true;
     }
 
-    bool stof(const char *&str, f32 &value)
-    {
-        const char *ptr = str;
-        bool negative = false;
-
-        // Skip white spaces
-        while (isspace(*ptr)) ptr++;
-
-        // Check optional sign
-        if (*ptr == '+')
-            ptr++;
-        else if (*ptr == '-')
-        {
-            negative = true;
-            ptr++;
-        }
-
-        // Parse integer part
-        if (!isdigit(*ptr)) return false; // At least one digit is required
-
-        f32 integer_part = 0.0;
-        while (isdigit(*ptr))
-        {
-            integer_part *= 10.0;
-            integer_part += *ptr - '0';
-            ptr++;
-        }
-
-        // Parse fractional part
-        f32 fractional_part = 0.0;
-        f32 fractional_div = 1.0;
-        if (*ptr == '.')
-        {
-            ptr++;
-            while (isdigit(*ptr))
-            {
-                fractional_part *= 10.0;
-                fractional_part += *ptr - '0';
-                fractional_div *= 10.0;
-                ptr++;
-            }
-        }
-
-        // Parse exponential part
-        int exponent_part = 0;
-        if (*ptr == 'e' || *ptr == 'E')
-        {
-            ptr++;
-            bool exponent_negative = false;
-            if (*ptr == '+')
-                ptr++;
-            else if (*ptr == '-')
-            {
-                exponent_negative = true;
-                ptr++;
-            }
-
-            if (!isdigit(*ptr)) return false; // At least one digit is required
-
-            while (isdigit(*ptr))
-            {
-                exponent_part *= 10;
-                exponent_part += *ptr - '0';
-                ptr++;
-            }
-
-            if (exponent_negative) exponent_part = -exponent_part;
-        }
-
-        f32 result = (integer_part + fractional_part / fractional_div) * pow(10.0, exponent_part);
-        value = negative ? -result : result;
-
-        str = ptr; // Update the input pointer
-        return true;
-    }
-
     string read_word(const char *&str)
     {
         const char *begin = str;
@@ -390,4 +210,45 @@ namespace acul
         str = end;
         return string(begin, end);
     }
+
+    void fill_line_buffer_parallel(const char *data, size_t size, string_view_pool<char> &dst, size_t min_range)
+    {
+        // A few ranges per worker keep the threads busy when line density varies across the file
+        const size_t workers = static_cast<size_t>(oneapi::tbb::this_task_arena::max_concurrency());
+        size_t ranges = size / (min_range ? min_range : 1);
+        if (ranges > workers * 4) ranges = workers * 4;
+        if (ranges < 2 || workers < 2) return fill_line_buffer(data, size, dst);
+
+        vector<size_t> bounds;
+        bounds.reserve(ranges + 1);
+        bounds.push_back(0);
+        for (size_t i = 1; i < ranges; ++i)
+        {
+            // Move the split point past the next '\n' so every range starts on a fresh line
+            const size_t nominal = size / ranges * i;
+            if (nominal < bounds.back()) continue;
+            const void *nl = memchr(data + nominal, '\n', size - nominal);
+            if (!nl) break;
+            const size_t cut = static_cast<const char *>(nl) - data + 1;
+            if (cut >= size) break;
+            bounds.push_back(cut);
+        }
+        bounds.push_back(size);
+
+        // The first range goes straight into dst, the others are appended after it in order
+        const size_t count = bounds.size() - 1;
+        vector<string_view_pool<char>> pools(count);
+        oneapi::tbb::parallel_for(size_t(0), count, [&](size_t i) {
+            detail::g_isa_dispatcher.fill_line_buffer(data + bounds[i], bounds[i + 1] - bounds[i],
+                                                      i == 0 ? dst : pools[i]);
+        });
+
+        vector<size_t> offsets(count + 1);
+        offsets[1] = dst.size();
+        for (size_t i = 1; i < count; ++i) offsets[i + 1] = offsets[i] + pools[i].size();
+        dst.resize(offsets[count]);
+        oneapi::tbb::parallel_for(size_t(1), count, [&](size_t i) {
+            if (!pools[i].empty()) memcpy(&dst[offsets[i]], &pools[i][0], pools[i].size() * sizeof(string_view));
+        });
+    }
 } // namespace acul
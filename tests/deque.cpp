@@ -0,0 +1,205 @@
+#include <acul/deque.hpp>
+#include <acul/string/string.hpp>
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+void test_deque_push_pop()
+{
+    acul::deque<int> d;
+    assert(d.empty());
+    assert(d.begin() == d.end());
+
+    // Cross several segments at both ends
+    const int count = static_cast<int>(acul::deque<int>::segment_size) * 3;
+    for (int i = 0; i < count; ++i) d.push_back(i);
+    for (int i = 1; i <= count; ++i) d.push_front(-i);
+    assert(d.size() == static_cast<size_t>(count * 2));
+    assert(d.front() == -count);
+    assert(d.back() == count - 1);
+    for (int i = 0; i < count * 2; ++i) assert(d[i] == i - count);
+
+    const int *first_back = &d[count];
+    for (int i = 0; i < count; ++i) d.pop_front();
+    assert(d.front() == 0);
+    assert(&d.front() == first_back);
+
+    while (d.size() > 1) d.pop_back();
+    assert(d.front() == 0 && d.back() == 0);
+    d.pop_back();
+    assert(d.empty());
+}
+
+void test_deque_fifo()
+{
+    // A FIFO cycles through the same segments instead of drifting off the map
+    acul::deque<size_t, acul::mem_allocator<size_t>, 256> d;
+    size_t next = 0;
+    for (size_t round = 0; round < 1000; ++round)
+    {
+        for (size_t i = 0; i < 50; ++i) d.push_back(round * 50 + i);
+        for (size_t i = 0; i < 50; ++i)
+        {
+            assert(d.front() == next++);
+            d.pop_front();
+        }
+    }
+    assert(d.empty());
+}
+
+void test_deque_non_trivial()
+{
+    acul::deque<acul::string> d;
+    d.emplace_back("first string that does not fit in sso");
+    d.emplace_front("b");
+    d.push_back(acul::string("c"));
+    assert(d.size() == 3);
+    assert(d[0] == "b");
+    assert(d[1] == "first string that does not fit in sso");
+    assert(d.at(2) == "c");
+
+    auto copy = d;
+    assert(copy == d);
+
+    auto moved = std::move(copy);
+    assert(moved == d);
+    assert(copy.empty());
+
+    d.clear();
+    assert(d.empty());
+    d.push_back("again");
+    assert(d.front() == "again");
+}
+
+void test_deque_insert_erase()
+{
+    acul::deque<int> d(100);
+    std::iota(d.begin(), d.end(), 0);
+
+    auto it = d.insert(d.begin() + 10, -1);
+    assert(*it == -1);
+    assert(d.size() == 101);
+    assert(d[9] == 9 && d[10] == -1 && d[11] == 10);
+
+    it = d.insert(d.end() - 10, -2);
+    assert(*it == -2);
+    assert(d[91] == -2 && d[92] == 90);
+
+    d.erase(d.begin() + 10);
+    d.erase(d.begin() + 90);
+    assert(d.size() == 100);
+    for (int i = 0; i < 100; ++i) assert(d[i] == i);
+
+    d.erase(d.begin() + 5, d.begin() + 15);
+    assert(d.size() == 90);
+    assert(d[4] == 4 && d[5] == 15);
+
+    d.erase(d.end() - 20, d.end() - 10);
+    assert(d.size() == 80);
+    assert(d.back() == 99);
+    assert(d[69] == 79 && d[70] == 90);
+}
+
+void test_deque_iterators()
+{
+    acul::deque<int, acul::mem_allocator<int>, 64> d;
+    for (int i = 0; i < 200; ++i) d.push_back(i);
+
+    auto it = std::find(d.begin(), d.end(), 150);
+    assert(it - d.begin() == 150);
+    assert(*(it - 100) == 50);
+    assert(it[-150] == 0);
+    assert(d.end() - it == 50);
+    assert(d.begin() < it);
+
+    decltype(d)::const_iterator cit = d.begin();
+    assert(*cit == 0);
+
+    int sum = 0;
+    for (auto r = d.rbegin(); r != d.rend(); ++r) sum += *r;
+    assert(sum == 199 * 200 / 2);
+
+    std::sort(d.begin(), d.end(), std::greater<int>());
+    assert(d.front() == 199 && d.back() == 0);
+
+    d.resize(10);
+    assert(d.size() == 10 && d.back() == 190);
+    d.resize(12, 7);
+    assert(d.back() == 7);
+}
+
+template <typename T>
+struct counted_segments : acul::mem_allocator<T>
+{
+    static inline int live = 0;
+
+    static T *allocate(size_t num)
+    {
+        ++live;
+        return acul::mem_allocator<T>::allocate(num);
+    }
+
+    static void deallocate(T *p, size_t num = 0) noexcept
+    {
+        --live;
+        acul::mem_allocator<T>::deallocate(p, num);
+    }
+};
+
+struct throwing_element
+{
+    int value;
+
+    explicit throwing_element(int v) : value(v)
+    {
+        if (v < 0) throw v;
+    }
+};
+
+void test_deque_throwing_element()
+{
+    {
+        // Every throw lands on a segment boundary, where a new segment has just been taken
+        acul::deque<throwing_element, counted_segments<throwing_element>, 64> d;
+        const int per_segment = static_cast<int>(decltype(d)::segment_size);
+        for (int round = 0; round < 4; ++round)
+        {
+            for (int i = 0; i < per_segment; ++i) d.emplace_back(i);
+            bool thrown = false;
+            try
+            {
+                d.emplace_back(-1);
+            }
+            catch (int)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+
+            thrown = false;
+            try
+            {
+                d.emplace_front(-1);
+            }
+            catch (int)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+            d.emplace_front(round);
+        }
+        assert(d.size() == static_cast<size_t>(per_segment * 4 + 4));
+        assert(d.front().value == 3 && d.back().value == per_segment - 1);
+    }
+    assert(counted_segments<throwing_element>::live == 0);
+}
+
+void test_deque()
+{
+    test_deque_push_pop();
+    test_deque_fifo();
+    test_deque_non_trivial();
+    test_deque_insert_erase();
+    test_deque_iterators();
+    test_deque_throwing_element();
+}
@@ -1,5 +1,6 @@
 #include <acul/event.hpp>
 #include <acul/functional/unique_function.hpp>
+#include <acul/string/string.hpp>
 #include <cassert>
 
 using namespace acul;
@@ -28,6 +29,22 @@ void test_event()
     assert(make_pre_event_id(id) == (id | 0x4000000000000000ULL));
     assert(make_post_event_id(id) == (id | 0x8000000000000000ULL));
 
+    // Named ids
+    using namespace acul::events::literals;
+    static_assert("asset.loaded"_id == make_event_id("asset.loaded"));
+    static_assert(("asset.loaded"_id & 0xC000000000000000ULL) == 0);
+    assert("asset.loaded"_id == (std::hash<string>()("asset.loaded") & 0x3FFFFFFFFFFFFFFFULL));
+    switch (make_post_event_id("asset.loaded"_id))
+    {
+        case make_pre_event_id("asset.loaded"_id):
+            assert(false);
+            break;
+        case make_post_event_id("asset.loaded"_id):
+            break;
+        default:
+            assert(false);
+    }
+
     // Bind & Dispatch
     int call_count = 0;
 
@@ -1,6 +1,21 @@
 #include <acul/hash/hl_hashmap.hpp>
 #include "hashmap_common.hpp"
 
+// Tables smaller than a scan block are walked byte by byte, where every tag but the empty one is occupied
+void test_hl_hashmap_small_tables()
+{
+    for (int n = 1; n <= 40; ++n)
+    {
+        acul::hl_hashmap<int, int> m;
+        for (int i = 0; i < n; ++i) m.emplace(i * 7919, i);
+        auto copy = m;
+        size_t count = 0, copied = 0;
+        for (auto &kv : m) count += m.contains(kv.first);
+        for (auto &kv : copy) copied += copy.at(kv.first) == m.at(kv.first);
+        assert(count == static_cast<size_t>(n) && copied == count);
+    }
+}
+
 void test_hl_hashmap()
 {
     using container_t = acul::hl_hashmap<int, int>;
@@ -9,4 +24,5 @@ void test_hl_hashmap()
     test_hashmap_iteration<container_t>();
     test_hashmap_update_path<container_t>();
     test_hashmap_erase<container_t>();
+    test_hl_hashmap_small_tables();
 }
@@ -41,6 +41,50 @@ void test_file()
     assert(read_by_block_result.success());
     assert(!dst.empty());
 
+    // --- read_lines
+    {
+        // Lines of varying length across many small chunks, the last one without a terminator
+        string content;
+        for (int i = 0; i < 200; ++i)
+        {
+            content += "line ";
+            content += to_string(i);
+            content += string(i % 37, 'x');
+            content += i % 3 ? "\n" : "\r\n";
+        }
+        content += "tail";
+        path lines_file = data / "test_lines.txt";
+        assert(write_binary(lines_file, content.c_str(), content.size()));
+
+        vector<string> lines;
+        auto collect = [&lines](const string_view_pool<char> &batch) {
+            for (const auto &line : batch) lines.emplace_back(line.data(), line.size());
+        };
+        assert(read_lines(lines_file, collect, 64).success());
+        assert(lines.size() == 201);
+        for (int i = 0; i < 200; ++i)
+        {
+            string expected = "line ";
+            expected += to_string(i);
+            expected += string(i % 37, 'x');
+            assert(lines[i] == expected);
+        }
+        assert(lines.back() == "tail");
+
+        // Exceptions thrown by the callback reach the caller
+        bool thrown = false;
+        try
+        {
+            read_lines(lines_file, [](const string_view_pool<char> &) { throw bad_alloc(1); }, 64);
+        }
+        catch (const bad_alloc &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        remove_file(lines_file.str().c_str());
+    }
+
     // --- write_by_block
 
     path copy_file = data / "copy_file.txt";
@@ -42,6 +42,19 @@ void test_log()
 
     set_default_logger(filelog);
     service->log(filelog, level::info, "File log: %d", 456);
+
+    filelog->set_level(level::warn);
+    assert(filelog->get_level() == level::warn);
+    assert(!is_enabled(filelog, level::info));
+    service->log(filelog, level::info, "Filtered log: %d", 1);
+
+    int evaluated = 0;
+    LOG_INFO("Filtered macro: %d", ++evaluated);
+    assert(evaluated == 0);
+
+    for (int i = 0; i < 7; ++i) LOG_WARN_EVERY_N(3, "Every n: %d", i);
+    for (int i = 0; i < 3; ++i) LOG_WARN_EVERY_N(i - 1, "Every non-positive n: %d", i);
+    for (int i = 0; i < 10; ++i) LOG_ERROR_RATE_LIMITED(2, "Rate limited: %d", i);
     {
         auto next = service->dispatch();
         while (next != std::chrono::steady_clock::time_point::max()) next = service->dispatch();
@@ -54,7 +67,114 @@ void test_log()
 
         string content(buffer.data(), buffer.size());
         assert(content.find("File log: 456") != string::npos);
+        assert(content.find("Filtered") == string::npos);
+
+        auto count = [&content](const char *needle) {
+            int n = 0;
+            for (size_t pos = content.find(needle); pos != string::npos; pos = content.find(needle, pos + 1)) ++n;
+            return n;
+        };
+        assert(count("Every n: ") == 3);
+        assert(content.find("Every n: 3") != string::npos);
+        assert(count("Every non-positive n: ") == 1);
+        int limited = count("Rate limited: ");
+        assert(limited >= 2 && limited <= 4);
     }
 
     fs::remove_file(filepath.c_str());
+
+    auto read_file = [](const string &path) {
+        vector<char> buffer;
+        assert(fs::read_binary(path, buffer));
+        return string(buffer.data(), buffer.size());
+    };
+    auto flush = [service]() {
+        auto next = service->dispatch();
+        while (next != std::chrono::steady_clock::time_point::max()) next = service->dispatch();
+        service->await();
+    };
+
+    string textpath = string(output_dir) + "/test_log_text.txt";
+    auto *textlog = service->add_logger<file_logger>("text", textpath, std::ios::out);
+    textlog->set_pattern("[%(level_name)] %(message)\n");
+    textlog->with("asset", "rock").with("bytes", 1024u).with("ratio", 0.5).with("step", 0.1).info("loaded");
+    textlog->with("skipped", true).debug("debug");
+    textlog->set_level(level::info);
+    textlog->with("filtered", 1).debug("filtered");
+    flush();
+    service->remove_logger("text");
+    {
+        string content = read_file(textpath);
+        assert(content.find("[INFO] loaded asset=rock bytes=1024 ratio=0.5 step=0.1\n") != string::npos);
+        assert(content.find("[DEBUG] debug skipped=true\n") != string::npos);
+        assert(content.find("filtered") == string::npos);
+    }
+    fs::remove_file(textpath.c_str());
+
+    string jsonpath = string(output_dir) + "/test_log_json.txt";
+    auto *jsonlog = service->add_logger<file_logger>("json", jsonpath, std::ios::out);
+    jsonlog->set_encoder(make_shared<json_encoder>());
+    jsonlog->with("path", string("a\"b\\c")).with("delta", -3).warn("line\nbreak");
+    flush();
+    service->remove_logger("json");
+    {
+        string content = read_file(jsonpath);
+        assert(content.find("\"level\":\"WARN\"") != string::npos);
+        assert(content.find("\"logger\":\"json\"") != string::npos);
+        assert(content.find("\"msg\":\"line\\nbreak\"") != string::npos);
+        assert(content.find("\"path\":\"a\\\"b\\\\c\",\"delta\":-3}\n") != string::npos);
+    }
+    fs::remove_file(jsonpath.c_str());
+
+    string logfmtpath = string(output_dir) + "/test_log_logfmt.txt";
+    auto *logfmtlog = service->add_logger<file_logger>("logfmt", logfmtpath, std::ios::out);
+    logfmtlog->set_encoder(make_shared<logfmt_encoder>());
+    logfmtlog->with("asset", "tree 01").with("ok", false).error("load failed");
+    flush();
+    service->remove_logger("logfmt");
+    {
+        string content = read_file(logfmtpath);
+        assert(content.find("level=ERROR") != string::npos);
+        assert(content.find("logger=logfmt msg=\"load failed\" asset=\"tree 01\" ok=false\n") != string::npos);
+    }
+    fs::remove_file(logfmtpath.c_str());
+
+    string binpath = string(output_dir) + "/test_log_bin.bin";
+    auto *binlog = service->add_logger<file_logger>("bin", binpath, std::ios::out | std::ios::binary);
+    binlog->set_encoder(make_shared<binary_encoder>());
+    binlog->with("id", (i64)-42).with("size", (u64)1 << 40).with("scale", 1.25f).with("name", "mesh").info("first");
+    binlog->with("empty", string()).trace("second");
+    flush();
+    service->remove_logger("bin");
+    {
+        string content = read_file(binpath);
+        bin_stream stream;
+        stream.write(content.data(), content.size());
+
+        record rec;
+        assert(binary_encoder::decode(stream, rec));
+        assert(rec.level == level::info && rec.message == "first" && rec.timestamp != 0);
+        assert(rec.fields.size() == 4);
+        assert(rec.fields[0].key == "id" && rec.fields[0].type == field_type::signed_int && rec.fields[0].i == -42);
+        assert(rec.fields[1].type == field_type::unsigned_int && rec.fields[1].u == (u64)1 << 40);
+        assert(rec.fields[2].type == field_type::floating && rec.fields[2].f == 1.25);
+        assert(rec.fields[3].type == field_type::string && rec.fields[3].str == "mesh");
+
+        assert(binary_encoder::decode(stream, rec));
+        assert(rec.level == level::trace && rec.message == "second");
+        assert(rec.fields.size() == 1 && rec.fields[0].str.empty());
+        assert(!binary_encoder::decode(stream, rec));
+
+        // A record cut anywhere is rejected, including in the middle of a field
+        u32 payload;
+        stream.pos(0);
+        stream.read(payload);
+        for (u32 cut = 0; cut < payload; ++cut)
+        {
+            bin_stream truncated;
+            truncated.write(cut).write(content.data() + sizeof(u32), cut);
+            assert(!binary_encoder::decode(truncated, rec));
+        }
+    }
+    fs::remove_file(binpath.c_str());
 }
@@ -1,5 +1,22 @@
+#include <acul/hash/hashmap.hpp>
+#include <acul/hash/hl_hashmap.hpp>
+#include <acul/forward_list.hpp>
+#include <acul/list.hpp>
+#include <acul/memory/arena.hpp>
+#include <acul/memory/heap_profiler.hpp>
+#include <acul/memory/huge_pages.hpp>
+#include <acul/memory/intrusive_ptr.hpp>
+#include <acul/memory/mem_stats.hpp>
+#include <acul/memory/pool.hpp>
 #include <acul/memory/smart_ptr.hpp>
+#include <acul/string/sstream.hpp>
+#include <acul/string/string.hpp>
+#include <acul/string/utils.hpp>
+#include <acul/vector.hpp>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <thread>
 
 struct Dummy
 {
@@ -45,6 +62,116 @@ void test_weak_ptr()
     assert(!wp.lock());
 }
 
+struct CountedDummy
+{
+    static inline std::atomic<int> alive{0};
+    int value = 7;
+
+    CountedDummy() { ++alive; }
+    ~CountedDummy() { --alive; }
+};
+
+void test_ts_shared_ptr()
+{
+    static_assert(sizeof(acul::detail::atomic_mem_control_block) == sizeof(acul::detail::mem_control_block));
+    {
+        acul::ts_shared_ptr<CountedDummy> shared = acul::make_ts_shared<CountedDummy>();
+        acul::ts_weak_ptr<CountedDummy> weak = shared;
+        acul::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&] {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    acul::ts_shared_ptr<CountedDummy> copy = shared;
+                    auto locked = weak.lock();
+                    assert(copy->value == 7 && locked);
+                    copy.reset();
+                }
+            });
+        for (auto &t : threads) t.join();
+        assert(shared.use_count() == 1 && CountedDummy::alive == 1);
+    }
+    assert(CountedDummy::alive == 0);
+
+    // The last owner may be on any thread
+    acul::ts_shared_ptr<CountedDummy> owner = acul::make_ts_shared<CountedDummy>();
+    acul::ts_weak_ptr<CountedDummy> observer = owner;
+    std::thread([p = std::move(owner)]() mutable { p.reset(); }).join();
+    assert(observer.expired() && !observer.lock() && CountedDummy::alive == 0);
+}
+
+struct SelfDummy : acul::enable_shared_from_this<SelfDummy>
+{
+};
+
+struct TsSelfDummy
+    : acul::enable_shared_from_this<TsSelfDummy, acul::mem_allocator<TsSelfDummy>, acul::atomic_ref_policy>
+{
+};
+
+void test_shared_from_this()
+{
+    auto shared = acul::make_shared<SelfDummy>();
+    auto self = shared->shared_from_this();
+    assert(self.get() == shared.get() && shared.use_count() == 2);
+
+    acul::shared_ptr<SelfDummy> adopted(acul::alloc<SelfDummy>());
+    assert(adopted->shared_from_this().get() == adopted.get());
+
+    auto ts_shared = acul::make_ts_shared<TsSelfDummy>();
+    assert(ts_shared->shared_from_this().get() == ts_shared.get());
+    assert(ts_shared.use_count() == 1);
+}
+
+struct IntrusiveDummy : acul::ref_counted<IntrusiveDummy>
+{
+    static inline int alive = 0;
+    int value;
+
+    explicit IntrusiveDummy(int v = 0) : value(v) { ++alive; }
+    ~IntrusiveDummy() { --alive; }
+};
+
+struct WeakIntrusiveDummy : acul::ref_counted<WeakIntrusiveDummy, acul::atomic_ref_policy, true>
+{
+    static inline int alive = 0;
+
+    WeakIntrusiveDummy() { ++alive; }
+    ~WeakIntrusiveDummy() { --alive; }
+};
+
+void test_intrusive_ptr()
+{
+    static_assert(sizeof(acul::intrusive_ptr<IntrusiveDummy>) == sizeof(void *));
+    {
+        auto p1 = acul::make_intrusive<IntrusiveDummy>(5);
+        assert(p1 && p1->value == 5 && p1.use_count() == 1);
+        auto p2 = p1;
+        assert(p2.use_count() == 2 && p1 == p2);
+
+        // A raw pointer taken from an owner may be adopted again
+        acul::intrusive_ptr<IntrusiveDummy> p3(p1.get());
+        assert(p1.use_count() == 3);
+        p1.reset();
+        p2.reset();
+        assert(p3.use_count() == 1 && IntrusiveDummy::alive == 1);
+
+        IntrusiveDummy *raw = p3.detach();
+        assert(!p3 && raw->use_count() == 1);
+        p3.reset(raw, false);
+    }
+    assert(IntrusiveDummy::alive == 0);
+
+    acul::intrusive_weak_ptr<WeakIntrusiveDummy> weak;
+    {
+        auto strong = acul::make_intrusive<WeakIntrusiveDummy>();
+        weak = strong;
+        assert(!weak.expired() && weak.lock() == strong);
+        assert(strong.use_count() == 1);
+    }
+    assert(WeakIntrusiveDummy::alive == 0 && weak.expired() && !weak.lock());
+}
+
 struct ComplexDummy
 {
     int a;
@@ -96,11 +223,258 @@ void test_alloc_array_release()
     acul::release(arr);
 }
 
+void test_arena()
+{
+    using namespace acul;
+    arena a(4096);
+    assert(a.allocate(0) == nullptr && a.reserved() == 0);
+
+    // Alignment, in-place growth of the latest allocation and its release
+    char *p = static_cast<char *>(a.allocate(3, 1));
+    void *q = a.allocate(40, 64);
+    assert(reinterpret_cast<uintptr_t>(q) % 64 == 0 && static_cast<char *>(q) > p);
+    assert(a.resize(q, 200) && !a.resize(p, 10));
+    const size_t used = a.used();
+    a.deallocate(q);
+    assert(a.used() < used && a.allocate(8, 1) == q);
+
+    // Oversized requests get their own block, reset keeps the blocks for the next round
+    void *big = a.allocate(10000);
+    assert(big && a.extent(big) == 10000 && a.extent(&a) == 0);
+    const size_t reserved = a.reserved();
+    a.reset();
+    assert(a.used() == 0);
+    for (int i = 0; i < 100; ++i) a.allocate(100);
+    assert(a.reserved() == reserved);
+
+    // No scope, no memory
+    assert(current_arena() == nullptr && arena_allocator<int>::allocate(4) == nullptr);
+
+    arena frame, nested;
+    {
+        arena_scope scope(frame);
+        assert(current_arena() == &frame);
+
+        vector<int, arena_allocator<int>> v;
+        for (int i = 0; i < 10000; ++i) v.push_back(i);
+        assert(v.size() == 10000 && v[9999] == 9999);
+
+        list<string, arena_allocator<string>> l;
+        for (int i = 0; i < 100; ++i) l.push_back(to_string(i));
+        assert(l.size() == 100 && l.back() == "99");
+
+        basic_string<char, arena_allocator<char>> s;
+        for (int i = 0; i < 100; ++i) s += "arena ";
+        assert(s.size() == 600 && s.find("arena arena") == 0);
+
+        hashmap<int, int, arena_allocator<std::byte>> map;
+        for (int i = 0; i < 1000; ++i) map[i] = i * 2;
+        assert(map.size() == 1000 && map[500] == 1000);
+
+        // Growth inside a nested scope copies from the outer arena
+        {
+            arena_scope inner(nested);
+            assert(current_arena() == &nested);
+            for (int i = 0; i < 10000; ++i) v.push_back(i);
+        }
+        assert(current_arena() == &frame && v.size() == 20000 && v[15000] == 5000);
+        assert(nested.used() > 0);
+    }
+    assert(current_arena() == nullptr && frame.used() > 0);
+    frame.reset();
+    assert(frame.used() == 0);
+}
+
+void test_pool()
+{
+    using namespace acul;
+
+    // Freed objects are handed out again first
+    using small = pool<24, 8>;
+    void *a = small::allocate();
+    void *b = small::allocate();
+    assert(a && b && a != b && reinterpret_cast<uintptr_t>(b) % 8 == 0);
+    small::deallocate(a);
+    assert(small::allocate() == a);
+    small::deallocate(a);
+    small::deallocate(b);
+
+    // Sizes that round to the same class share slabs and free lists
+    using rounded = pool<20, 8>;
+    using shared_small = pool<24, 8, true>;
+    assert(&rounded::size_class() == &small::size_class());
+    assert(&shared_small::size_class() != &small::size_class());
+    void *c = rounded::allocate();
+    rounded::deallocate(c);
+    assert(small::allocate() == c);
+    small::deallocate(c);
+
+    list<int, pool_allocator<int>> l;
+    forward_list<int, pool_allocator<int>> fl;
+    for (int i = 0; i < 20000; ++i)
+    {
+        l.push_back(i);
+        fl.push_front(i);
+    }
+    assert(l.size() == 20000 && l.back() == 19999 && fl.front() == 19999);
+    l.clear();
+    assert(l.empty());
+
+    // A thread leaving hands its cache to the next one
+    using handed = pool<40, 8>;
+    void *left = nullptr, *taken = nullptr;
+    std::thread([&] {
+        left = handed::allocate();
+        handed::deallocate(left);
+    }).join();
+    std::thread([&] { taken = handed::allocate(); }).join();
+    assert(left && taken == left);
+
+    // Shared pools send objects back to the thread that allocated them
+    using shared = pool<32, 8, true>;
+    void *objects[100];
+    for (auto &p : objects) p = shared::allocate();
+    std::thread([&] {
+        for (auto *p : objects) shared::deallocate(p);
+        assert(shared::allocate() != objects[99]);
+    }).join();
+    for (int i = 0; i < 100; ++i)
+    {
+        void *p = shared::allocate();
+        bool returned = false;
+        for (auto *o : objects) returned |= o == p;
+        assert(returned);
+    }
+}
+
+struct test_mem_tag
+{
+    static constexpr const char *name = "test";
+};
+
+static const acul::mem_tag_stats *find_mem_tag(const acul::vector<acul::mem_tag_stats> &stats, const char *name)
+{
+    for (auto &s : stats)
+        if (strcmp(s.name, name) == 0) return &s;
+    return nullptr;
+}
+
+void test_mem_stats()
+{
+    using namespace acul;
+    if constexpr (!mem_accounting_enabled)
+    {
+        assert(mem_stats_snapshot().empty());
+        return;
+    }
+
+    {
+        vector<char, mem_allocator<char, test_mem_tag>> buffer(100 << 10);
+        auto stats = mem_stats_snapshot();
+        assert(stats[0].name && strcmp(stats[0].name, "untagged") == 0);
+        auto *s = find_mem_tag(stats, "test");
+        assert(s && s->live_bytes >= (100 << 10) && s->allocations >= 1);
+        u64 bucketed = 0;
+        for (u64 n : s->histogram) bucketed += n;
+        assert(bucketed == s->allocations);
+
+        // Containers count under their default tags
+        string str(1000, 'x');
+        hashmap<int, int> map{{1, 2}};
+        stats = mem_stats_snapshot();
+        auto *strings = find_mem_tag(stats, "string");
+        auto *tables = find_mem_tag(stats, "hash_table");
+        assert(strings && strings->live_bytes >= 1000 && tables && tables->live_bytes > 0);
+    }
+
+    auto stats = mem_stats_snapshot();
+    auto *s = find_mem_tag(stats, "test");
+    assert(s && s->live_bytes == 0 && s->frees == s->allocations && s->peak_bytes >= (100 << 10));
+}
+
+ACUL_NOINLINE static void allocate_profiled_blocks(acul::vector<acul::vector<char>> &blocks)
+{
+    for (int i = 0; i < 1000; ++i) blocks.emplace_back(4096);
+}
+
+void test_heap_profiler()
+{
+    using namespace acul;
+    heap_profiler::start(4096);
+    if constexpr (!heap_profiler::enabled)
+    {
+        stringstream ss;
+        heap_profiler::write_pprof(ss);
+        assert(!heap_profiler::running() && ss.str().empty());
+        return;
+    }
+
+    vector<vector<char>> blocks;
+    blocks.reserve(1000);
+    allocate_profiled_blocks(blocks);
+    stringstream folded;
+    heap_profiler::write_folded(folded);
+    assert(folded.str().find("allocate_profiled_blocks") != string::npos);
+
+    stringstream pprof;
+    heap_profiler::write_pprof(pprof);
+    string profile = pprof.str();
+    assert(profile.find("heap profile: ") == 0 && profile.find("@ heap_v2/4096") != string::npos);
+    assert(profile.find("MAPPED_LIBRARIES:") != string::npos);
+
+    // Freed samples leave the live profile, not the allocation one
+    blocks.clear();
+    stringstream live, total;
+    heap_profiler::write_folded(live);
+    heap_profiler::write_folded(total, false);
+    assert(live.str().find("allocate_profiled_blocks") == string::npos);
+    assert(total.str().find("allocate_profiled_blocks") != string::npos);
+
+    heap_profiler::stop();
+    heap_profiler::reset();
+}
+
+struct test_huge_policy
+{
+    static constexpr size_t threshold = 64 << 10;
+};
+
+void test_huge_pages()
+{
+    using namespace acul;
+
+    u64 *aligned = mem_allocator<u64>::allocate_aligned(100, 4096);
+    assert(aligned && reinterpret_cast<uintptr_t>(aligned) % 4096 == 0);
+    mem_allocator<u64>::deallocate_aligned(aligned);
+
+    // Growing past the threshold moves the data to its own mapping, later growth stays there while it fits
+    vector<u64, huge_page_allocator<u64, test_huge_policy>> v;
+    for (u64 i = 0; i < 200000; ++i) v.push_back(i);
+    assert(detail::huge_block_of(v.data()) && reinterpret_cast<uintptr_t>(v.data()) % 64 == 0);
+    for (u64 i = 0; i < v.size(); ++i) assert(v[i] == i);
+
+    vector<u64, huge_page_allocator<u64, test_huge_policy>> small(16);
+    assert(!detail::huge_block_of(small.data()));
+
+    hl_hashmap<u64, u64, std::hash<u64>, std::equal_to<u64>, huge_page_allocator<std::byte, test_huge_policy>> map;
+    for (u64 i = 0; i < 50000; ++i) map[i * 0x9E3779B97F4A7C15ULL] = i;
+    for (u64 i = 0; i < 50000; ++i) assert(map.find(i * 0x9E3779B97F4A7C15ULL)->second == i);
+    assert(map.find(1) == map.end());
+}
+
 void test_memory()
 {
     test_shared_ptr();
     test_weak_ptr();
+    test_ts_shared_ptr();
+    test_shared_from_this();
+    test_intrusive_ptr();
     test_unique_ptr();
     test_alloc_release();
     test_alloc_array_release();
+    test_arena();
+    test_pool();
+    test_mem_stats();
+    test_heap_profiler();
+    test_huge_pages();
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <acul/queue.hpp>
+#include <acul/string/string.hpp>
+#include <cassert>
+#include <string>
+
+void test_ring_queue_fifo()
+{
+    acul::queue<int> q;
+    assert(q.empty());
+    assert(q.capacity() == 0);
+
+    for (int i = 0; i < 10; ++i) q.push(i);
+    assert(q.size() == 10);
+    assert(q.capacity() == 16);
+    assert(q.front() == 0 && q.back() == 9);
+
+    // Wrap around without growing
+    for (int i = 0; i < 8; ++i) q.pop();
+    for (int i = 10; i < 24; ++i) q.push(i);
+    assert(q.capacity() == 16);
+    for (int i = 0; i < 16; ++i) assert(q[i] == i + 8);
+
+    // Grow while wrapped
+    q.push(24);
+    assert(q.capacity() == 32);
+    int expected = 8;
+    for (int value : q) assert(value == expected++);
+    assert(expected == 25);
+
+    while (!q.empty())
+    {
+        assert(q.front() == 25 - static_cast<int>(q.size()));
+        q.pop();
+    }
+}
+
+void test_ring_queue_non_trivial()
+{
+    acul::ring_queue<acul::string> q;
+    for (int i = 0; i < 12; ++i) q.emplace("long string that does not fit in sso");
+    for (int i = 0; i < 10; ++i) q.pop();
+    for (int i = 0; i < 20; ++i) q.push(acul::string(std::to_string(i).c_str()));
+    assert(q.size() == 22);
+    assert(q.capacity() == 32);
+    assert(q[0] == "long string that does not fit in sso");
+    assert(q[2] == "0");
+    assert(q.back() == "19");
+
+    auto copy = q;
+    assert(copy.size() == q.size());
+    assert(copy[21] == "19");
+
+    auto moved = std::move(copy);
+    assert(copy.empty());
+    assert(moved.front() == q.front());
+
+    q.clear();
+    assert(q.empty());
+    q.swap(moved);
+    assert(q.size() == 22 && moved.empty());
+}
+
+void test_ring_queue_reserve()
+{
+    acul::ring_queue<size_t> q(100);
+    assert(q.capacity() == 128);
+    q.reserve(50);
+    assert(q.capacity() == 128);
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        q.push(i);
+        if (i % 2) q.pop();
+    }
+    assert(q.size() == 5000);
+    assert(q.front() == 5000 && q.back() == 9999);
+}
+
+// Not trivially relocatable, and a destroyed element no longer holds its value
+struct poisoned_on_destroy
+{
+    int value;
+
+    poisoned_on_destroy(int v) : value(v) {}
+    poisoned_on_destroy(const poisoned_on_destroy &other) : value(other.value) {}
+    ~poisoned_on_destroy() { value = -1; }
+};
+
+void test_ring_queue_self_push()
+{
+    // Growing relocates the element the argument refers to
+    acul::queue<acul::string> q;
+    for (int i = 0; i < 16; ++i) q.push(acul::string(std::to_string(i).c_str()) + " long enough for the heap");
+    assert(q.size() == q.capacity());
+    q.push(q.front());
+    q.emplace(q[1]);
+    assert(q.size() == 18 && q.capacity() == 32);
+    assert(q[16] == "0 long enough for the heap" && q[17] == "1 long enough for the heap");
+
+    acul::queue<poisoned_on_destroy> values;
+    for (int i = 0; i < 16; ++i) values.push(i + 100);
+    values.pop();
+    values.push(116);
+    values.push(values.front());
+    assert(values.back().value == 101 && values.front().value == 101);
+}
+
+void test_queue()
+{
+    test_ring_queue_fifo();
+    test_ring_queue_non_trivial();
+    test_ring_queue_reserve();
+    test_ring_queue_self_push();
+}
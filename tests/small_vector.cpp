@@ -0,0 +1,154 @@
+#include <acul/small_vector.hpp>
+#include <acul/string/string.hpp>
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+void test_small_vector_inline()
+{
+    acul::small_vector<int, 4> v;
+    assert(v.empty());
+    assert(v.is_inline());
+    assert(v.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i) v.push_back(i);
+    assert(v.is_inline());
+    assert(v.size() == 4);
+
+    // Spill to the heap
+    v.push_back(4);
+    assert(!v.is_inline());
+    assert(v.size() == 5);
+    for (int i = 0; i < 5; ++i) assert(v[i] == i);
+
+    v.resize(2);
+    v.shrink_to_fit();
+    assert(v.is_inline());
+    assert(v.size() == 2);
+    assert(v[0] == 0 && v[1] == 1);
+}
+
+void test_small_vector_non_trivial()
+{
+    acul::small_vector<acul::string, 2> v;
+    v.emplace_back("first string that does not fit in sso");
+    v.emplace_back("b");
+    v.emplace_back("c");
+    assert(!v.is_inline());
+    assert(v[0] == "first string that does not fit in sso");
+    assert(v[2] == "c");
+
+    v.insert(v.begin() + 1, acul::string("inserted"));
+    assert(v.size() == 4);
+    assert(v[1] == "inserted");
+    assert(v[2] == "b");
+
+    v.erase(v.begin(), v.begin() + 2);
+    assert(v.size() == 2);
+    assert(v[0] == "b");
+    assert(v[1] == "c");
+}
+
+void test_small_vector_copy_move_assign()
+{
+    acul::small_vector<acul::string, 2> inline_src = {"a", "b"};
+    acul::small_vector<acul::string, 2> heap_src = {"a", "b", "c"};
+
+    // Copy
+    auto c1 = inline_src;
+    auto c2 = heap_src;
+    assert(c1 == inline_src);
+    assert(c2 == heap_src);
+
+    // Move of inline elements moves them one by one
+    auto m1 = std::move(inline_src);
+    assert(m1.is_inline());
+    assert(m1.size() == 2 && m1[1] == "b");
+    assert(inline_src.empty());
+
+    // Move of spilled elements takes the heap block
+    const acul::string *block = heap_src.data();
+    auto m2 = std::move(heap_src);
+    assert(m2.data() == block);
+    assert(heap_src.empty() && heap_src.is_inline());
+
+    // Assign
+    m1 = m2;
+    assert(m1 == m2);
+    m2 = std::move(c1);
+    assert(m2.size() == 2 && m2[0] == "a");
+
+    m1.swap(m2);
+    assert(m1.size() == 2);
+    assert(m2.size() == 3);
+}
+
+void test_small_vector_insert_erase()
+{
+    acul::small_vector<int, 4> v = {1, 2, 4};
+
+    v.insert(v.begin() + 2, 3);
+    assert(v.size() == 4);
+    assert(v[2] == 3);
+    assert(v[3] == 4);
+
+    v.insert(v.begin(), 3, 0);
+    assert(v.size() == 7);
+    assert(v[2] == 0 && v[3] == 1);
+
+    int tail[] = {5, 6};
+    v.insert(v.end(), tail, tail + 2);
+    assert(v.size() == 9);
+    assert(v.back() == 6);
+
+    v.erase(v.begin(), v.begin() + 3);
+    assert(v.size() == 6);
+    assert(v.front() == 1);
+
+    v.erase(v.begin() + 1);
+    assert(v[1] == 3);
+}
+
+void test_small_vector_assign()
+{
+    acul::small_vector<int, 8> v;
+    v.assign(5, 42);
+    assert(v.size() == 5);
+    for (auto &e : v) assert(e == 42);
+
+    v.assign({1, 2, 3});
+    assert(v.size() == 3);
+    assert(v[2] == 3);
+
+    v.resize(6, 7);
+    assert(v.size() == 6);
+    assert(v[5] == 7);
+}
+
+void test_small_vector_iterators()
+{
+    acul::small_vector<int, 4> v(6);
+    std::iota(v.begin(), v.end(), 10);
+
+    // Check construct
+    acul::small_vector<int, 4> b{v.begin(), v.end()};
+    assert(b == v);
+
+    auto it = std::find_if(v.begin(), v.end(), [](int x) { return x > 12; });
+    assert(it != v.end());
+    assert(*it == 13);
+
+    int sum = 0;
+    for (auto r = v.rbegin(); r != v.rend(); ++r) sum += *r;
+    assert(sum == 10 + 11 + 12 + 13 + 14 + 15);
+}
+
+void test_small_vector()
+{
+    test_small_vector_inline();
+    test_small_vector_non_trivial();
+    test_small_vector_copy_move_assign();
+    test_small_vector_insert_erase();
+    test_small_vector_assign();
+    test_small_vector_iterators();
+}
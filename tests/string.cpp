@@ -1,10 +1,24 @@
+#include <acul/hash/hashmap.hpp>
+#include <acul/hash/hl_hashmap.hpp>
+#include <acul/string/atom.hpp>
+#include <acul/string/format.hpp>
+#include <acul/string/hash.hpp>
+#include <acul/string/inline_string.hpp>
+#include <acul/string/line_index.hpp>
+#include <acul/string/line_reader.hpp>
+#include <acul/string/multi_search.hpp>
 #include <acul/string/refstring.hpp>
 #include <acul/string/sstream.hpp>
 #include <acul/string/string.hpp>
 #include <acul/string/string_view.hpp>
 #include <acul/string/string_view_pool.hpp>
+#include <acul/string/tokenizer.hpp>
 #include <acul/string/utils.hpp>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <oneapi/tbb/task_arena.h>
+#include <thread>
 
 
 void test_basic_string()
@@ -56,6 +70,10 @@ void test_sstream()
         ss << "Hello" << " " << 123 << '1';
         assert(ss.str() == "Hello 1231");
 
+        ss.clear();
+        ss << 3.5 << ' ' << 0.1f;
+        assert(ss.str() == "3.5 0.1");
+
         ss.clear();
         assert(ss.str().empty());
     }
@@ -97,6 +115,14 @@ void test_string_view_pool()
         assert(strcmp(pool[1].data(), "defg") == 0);
         assert(strcmp(pool[0].data(), "abc") == 0);
     }
+    {
+        acul::string_view_pool<char, acul::mem_allocator<char>, 2> pool;
+        pool.push("a", 1);
+        pool.push("b", 1);
+        pool.push("c", 1);
+        assert(pool.size() == 3);
+        assert(pool[0] == "a" && pool[2] == "c");
+    }
 }
 
 void test_string_view()
@@ -133,6 +159,21 @@ void test_utils()
     acul::string back_to_utf8 = acul::utf16_to_utf8(utf16);
     assert(utf8 == back_to_utf8);
 
+    // Surrogate pairs, multi-byte text longer than one SIMD block, ill-formed input
+    acul::string mixed = "caf\xC3\xA9 \xE2\x82\xAC 100 \xF0\x9F\x98\x80 the quick brown fox jumps over the lazy dog";
+    acul::u16string mixed16 = acul::utf8_to_utf16(mixed);
+    assert(mixed16.size() == mixed.size() - 1 - 2 - 2);
+    assert(mixed16[3] == 0xE9 && mixed16[5] == 0x20AC && mixed16[11] == 0xD83D && mixed16[12] == 0xDE00);
+    assert(acul::utf16_to_utf8(mixed16) == mixed);
+    assert(acul::validate_utf8(mixed.data(), mixed.size()));
+    assert(!acul::validate_utf8("\xC0\xAF", 2));         // overlong
+    assert(!acul::validate_utf8("\xED\xA0\x80", 3));     // encoded surrogate
+    assert(!acul::validate_utf8("abc\xE2\x82", 5));       // truncated
+    assert(acul::utf8_to_utf16("a\xFF" "b", 3) == acul::utf8_to_utf16("a\xEF\xBF\xBD" "b"));
+    const c16 lone[] = {u'x', 0xD800, u'y'};
+    assert(!acul::validate_utf16(lone, 3));
+    assert(acul::utf16_to_utf8(lone, 3) == "x\xEF\xBF\xBDy");
+
     // trim
     acul::string trimmed = acul::trim(acul::string("  hello world   "));
     assert(trimmed == "hello world");
@@ -178,6 +219,38 @@ void test_utils()
     ok = acul::stof(str3, fvalue);
     assert(ok && (fvalue > 3.13f && fvalue < 3.15f));
 
+    const char *str_f = " -1.5e-3,";
+    ok = acul::stof(str_f, fvalue);
+    assert(ok && fvalue == -1.5e-3f && *str_f == ',');
+
+    // stod
+    const char *str_d = "0.1 2.2250738585072014e-308 123456789012345678901234567890 4.9e-324 1e400 .5";
+    f64 dvalue = 0.0;
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == 0.1 && *str_d == ' ');
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == 2.2250738585072014e-308);
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == 123456789012345678901234567890.0);
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == 4.9e-324);
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == std::numeric_limits<f64>::infinity());
+    ok = acul::stod(str_d, dvalue);
+    assert(ok && dvalue == 0.5 && *str_d == '\0');
+
+    // Halfway between 1 and the next double rounds to even, one more digit rounds up
+    const char *str_half = "1.00000000000000011102230246251565404236316680908203125";
+    ok = acul::stod(str_half, dvalue);
+    assert(ok && dvalue == 1.0);
+    const char *str_above = "1.000000000000000111022302462515654042363166809082031251";
+    ok = acul::stod(str_above, dvalue);
+    assert(ok && dvalue == 1.0000000000000002);
+
+    const char *str_bad = "e5";
+    ok = acul::stod(str_bad, dvalue);
+    assert(!ok && *str_bad == 'e');
+
     // str_range
     const char *str4 = "hello";
     acul::string range = acul::strip_controls(str4);
@@ -193,6 +266,403 @@ void test_utils()
     // Negative
     acul::string negative = acul::to_string(-12345);
     assert(negative == "-12345");
+
+    // 64-bit limits
+    assert(acul::to_string(UINT64_MAX) == "18446744073709551615");
+    assert(acul::to_string(INT64_MIN) == "-9223372036854775808");
+
+    // Floats: shortest round-trip and printf-style precision
+    assert(acul::to_string(0.1) == "0.1");
+    assert(acul::to_string(0.1f) == "0.1");
+    assert(acul::to_string(1e22) == "1e+22");
+    assert(acul::to_string(-0.0) == "-0");
+    assert(acul::to_string(5e-324) == "5e-324");
+    assert(acul::to_string(1.7976931348623157e308) == "1.7976931348623157e+308");
+    assert(acul::to_string(123456789012345680000.0) == "123456789012345683968");
+    {
+        char buf[64];
+        int len = acul::to_string(2.675, buf, sizeof(buf), acul::float_format::fixed, 2);
+        assert(acul::string(buf, len) == "2.67");
+        len = acul::to_string(727454.625f, buf, sizeof(buf), acul::float_format::fixed, 2);
+        assert(acul::string(buf, len) == "727454.62");
+        len = acul::to_string(1234.5, buf, sizeof(buf), acul::float_format::scientific, 3);
+        assert(acul::string(buf, len) == "1.234e+03");
+        len = acul::to_string(0.0001234, buf, sizeof(buf), acul::float_format::general, -1);
+        assert(acul::string(buf, len) == "0.0001234");
+        assert(acul::to_string(1.0, buf, 2, acul::float_format::fixed, 3) == 0);
+    }
+
+    // format longer than the stack buffer
+    acul::string long_fmt = acul::format("%0300d", 7);
+    assert(long_fmt.size() == 300 && long_fmt[0] == '0' && long_fmt[299] == '7');
+}
+
+void test_format()
+{
+    namespace fmt = acul::fmt;
+    assert(fmt::format("plain") == "plain");
+    assert(fmt::format("{{}} {}", 1) == "{} 1");
+    assert(fmt::format("{} {} {}", -42, 42u, 'c') == "-42 42 c");
+    assert(fmt::format("{} {}", true, false) == "true false");
+    assert(fmt::format("{}|{}", acul::string("str"), acul::string_view("view")) == "str|view");
+    assert(fmt::format("{:x} {:X} {:#x} {:o} {:#b}", 255, 255, 255, 8, 5) == "ff FF 0xff 10 0b101");
+    assert(fmt::format("{:>5}|{:<5}|{:^5}|{:*^6}", 1, 2, 3, "ab") == "    1|2    |  3  |**ab**");
+    assert(fmt::format("{:05} {:#06x}", -42, 255) == "-0042 0x00ff");
+    assert(fmt::format("{:.2f} {:f}", 3.14159, 0.5) == "3.14 0.500000");
+    assert(fmt::format("{} {}", 0.1, 1.5f) == "0.1 1.5");
+    assert(fmt::format("{:e} {:.3g} {:8.1f}", 1500.0, 0.000123456, -2.25) == "1.500000e+03 0.000123     -2.2");
+    assert(fmt::format("{}", (const void *)0x10) == "0x10");
+    assert(fmt::format("{}", INT64_MIN) == "-9223372036854775808");
+
+    acul::string dst = "head:";
+    fmt::format_to(dst, " {}-{}", 1, 2);
+    assert(dst == "head: 1-2");
+
+    acul::stringstream ss;
+    ss << "a";
+    fmt::format_to(ss, "{:02}:{:02}", 5, 30);
+    assert(ss.str() == "a05:30");
+}
+
+void test_search()
+{
+    // Long enough that matches land in the vector body and in the scalar tail
+    acul::string text;
+    for (int i = 0; i < 10; ++i) text += "lorem ipsum dolor ";
+    text += "Needle|end";
+    acul::string_view view(text.c_str(), text.size());
+
+    assert(text.find(acul::string("Needle")) == 180);
+    assert(text.find(acul::string("ipsum"), 7) == 24);
+    assert(text.find(acul::string("absent")) == acul::string::npos);
+    assert(view.find("end") == 187);
+    assert(view.substr(0, 189).find("end") == acul::string_view::npos);
+    assert(text.rfind("ipsum") == 168);
+    assert(view.rfind("lorem", 100) == 90);
+    assert(text.find_first_of("|N") == 180);
+    assert(view.find_first_of("xyz|") == 186);
+    assert(view.find_first_of("0123456789!?#$%^&*|") == 186);
+    assert(text.find_first_of("QZ") == acul::string::npos);
+
+    acul::string with_nul("ab\0cd\0ef", 8);
+    assert(with_nul.find(acul::string("ef")) == 6);
+
+    assert(acul::count(text, ' ') == 30);
+    assert(acul::count(text.c_str(), 0, ' ') == 0);
+    assert(acul::find_insensitive_case(text, "nEEDLE|") == 180);
+    assert(acul::find_insensitive_case(text.c_str(), 185, "needle|") == (size_t)-1);
+    assert(acul::to_upper(text).find(acul::string("LOREM IPSUM")) == 0);
+    assert(acul::to_lower("MiXeD [@`{] 123") == "mixed [@`{] 123");
+    assert(acul::to_upper("MiXeD [@`{] 123") == "MIXED [@`{] 123");
+}
+
+void test_line_reader()
+{
+    acul::string text = "first\r\nsecond\n\r\n\nfourth line that is longer than a single vector register\r\nlast";
+    acul::string_view_pool<char> expected;
+    acul::fill_line_buffer(text.c_str(), text.size(), expected);
+
+    // Every chunk size splits lines and CRLF pairs at a different place
+    for (size_t chunk = 1; chunk <= text.size() + 1; ++chunk)
+    {
+        acul::line_reader reader(chunk);
+        acul::vector<acul::string> lines;
+        auto collect = [&](const acul::string_view_pool<char> &batch) {
+            for (auto &line : batch) lines.emplace_back(line.data(), line.size());
+        };
+        for (size_t pos = 0; pos < text.size(); pos += chunk)
+        {
+            const size_t n = std::min(chunk, text.size() - pos);
+            memcpy(reader.prepare(), text.c_str() + pos, n);
+            reader.commit(n, collect);
+        }
+        reader.finish(collect);
+
+        assert(lines.size() == expected.size());
+        for (size_t i = 0; i < lines.size(); ++i) assert(lines[i] == expected[i]);
+    }
+}
+
+void test_fill_line_buffer_parallel()
+{
+    acul::string text;
+    for (int i = 0; i < 2000; ++i)
+    {
+        text += acul::to_string(i);
+        text += i % 3 == 0 ? "\r\n" : i % 7 == 0 ? "\n\n" : "\n";
+    }
+    text += "tail";
+    acul::string_view_pool<char> expected, lines;
+    acul::fill_line_buffer(text.c_str(), text.size(), expected);
+
+    // Tiny ranges force many split points, some of them inside CRLF pairs
+    oneapi::tbb::task_arena arena(8);
+    arena.execute([&] {
+        for (size_t min_range : {size_t(7), size_t(64), size_t(1000), text.size()})
+        {
+            lines.clear();
+            acul::fill_line_buffer_parallel(text.c_str(), text.size(), lines, min_range);
+            assert(lines == expected);
+        }
+    });
+}
+
+template <typename Offset>
+static void check_line_index(const acul::string &text)
+{
+    acul::string_view_pool<char> expected;
+    acul::fill_line_buffer(text.c_str(), text.size(), expected);
+    acul::line_index<Offset> index;
+    acul::fill_line_buffer(text.c_str(), text.size(), index);
+    assert(index.size() == expected.size());
+    size_t i = 0;
+    for (acul::string_view line : index) assert(line == expected[i++]);
+}
+
+void test_line_index()
+{
+    acul::string text;
+    for (int i = 0; i < 150; ++i)
+    {
+        text += acul::string(i % 40, 'x');
+        text += i % 3 == 0 ? "\r\n" : i % 5 == 0 ? "\r\r\n" : "\n";
+    }
+    const char *cases[] = {"", "\n", "\r\n", "one", "one\r", "a\r\nb\nc\r\n", "\n\n\r\n\nlast line"};
+    for (const char *c : cases)
+    {
+        check_line_index<u32>(c);
+        check_line_index<u64>(c);
+    }
+    check_line_index<u32>(text);
+    check_line_index<u64>(text + "unterminated");
+
+    acul::line_index<> index;
+    acul::fill_line_buffer(text.c_str(), text.size(), index);
+    assert(index.memory_size() < index.size() * sizeof(acul::string_view) / 2);
+
+    const char *crlf = "a\r\nbc\nd";
+    acul::fill_line_buffer(crlf, 7, index);
+    assert(index.size() == 3 && index.has_cr(0) && !index.has_cr(1) && !index.has_cr(2));
+    assert(index.offset(1) == 3 && index[1] == "bc" && index.at(2) == "d");
+
+    // Usable with algorithms that rely on random access
+    using iterator = acul::line_index<>::const_iterator;
+    static_assert(std::random_access_iterator<iterator>);
+    auto before_bc = [crlf](acul::string_view s) { return s.data() < crlf + 3; };
+    auto it = std::partition_point(index.begin(), index.end(), before_bc);
+    assert(it - index.begin() == 1 && *it == "bc");
+    assert(1 + index.begin() == it && it > index.begin() && it >= it && index.begin() <= it);
+}
+
+void test_tokenizer()
+{
+    acul::string csv = "id,name,note\r\n1,\"Smith, J\",\"said \"\"hi\"\"\"\n2,,\"multi\nline\"\n";
+    for (int i = 0; i < 20; ++i) csv += "3,padding past the vector block,x\n";
+    csv += "4,last";
+
+    acul::token_table table;
+    acul::tokenize(csv.c_str(), csv.size(), {}, table);
+    assert(table.size() == 24);
+    assert(table.record_size(0) == 3 && table.field(0, 2) == "note");
+    assert(table.field(1, 1) == "Smith, J");
+    assert(acul::unescape_field(table.field(1, 2)) == "said \"hi\"");
+    assert(table.field(2, 1).empty() && table.field(2, 2) == "multi\nline");
+    assert(table.field(22, 1) == "padding past the vector block");
+    assert(table.record_size(23) == 2 && table.field(23, 1) == "last");
+
+    // Delimiter sets and no quoting, as in /proc files
+    table.clear();
+    const char *proc = "cpu  10 20\tsize:\"3\"\n";
+    acul::tokenize(proc, strlen(proc), {" \t:", '\0'}, table);
+    assert(table.size() == 1 && table.record_size(0) == 6);
+    assert(table.field(0, 1).empty() && table.field(0, 5) == "\"3\"");
+
+    acul::string_view_pool<char> parts;
+    acul::split("a,b,,c,", 7, ',', parts);
+    assert(parts.size() == 4 && parts[2].empty() && parts[3] == "c");
+}
+
+void test_multi_search()
+{
+    acul::string text;
+    for (int i = 0; i < 4; ++i) text += "ushers and their padding for the vector body; ";
+    text += "She sells HERS";
+
+    acul::vector<acul::string> patterns = {"he", "she", "hers", "his", ""};
+    acul::multi_matcher matcher(patterns);
+    acul::vector<acul::multi_match> matches;
+    // "ushers" holds three overlapping patterns, "their" and "the" one more each
+    assert(matcher.find_all(text.c_str(), text.size(), matches) == 21);
+    assert(matches[0].offset == 1 && matches[0].pattern == 1);
+    assert(matches[1].offset == 2 && matches[1].pattern == 0);
+    assert(matches[2].offset == 2 && matches[2].pattern == 2);
+    assert(matches[3].offset == 12 && matches[3].pattern == 0);
+
+    // Over 64 patterns use the automaton and must report the same matches
+    acul::vector<acul::string> many = patterns;
+    for (char c = '0'; c < '0' + 70; ++c) many.push_back(acul::string(3, c) + "#absent");
+    acul::multi_matcher large(many);
+    assert(!large.vectorized());
+    acul::vector<acul::multi_match> from_automaton;
+    large.find_all(text.c_str(), text.size(), from_automaton);
+    assert(from_automaton.size() == matches.size());
+    for (size_t i = 0; i < matches.size(); ++i)
+        assert(from_automaton[i].offset == matches[i].offset && from_automaton[i].pattern == matches[i].pattern);
+
+    acul::multi_matcher icase(patterns, true);
+    matches.clear();
+    icase.find_all(acul::string_view("She sells HERS"), matches);
+    assert(matches.size() == 4 && matches[0].pattern == 1 && matches[3].offset == 10 && matches[3].pattern == 2);
+
+    acul::string_view_pool<char> lines;
+    const char *log = "ok\nerror: he\nshe\n";
+    acul::fill_line_buffer(log, strlen(log), lines);
+    acul::vector<acul::line_match> line_matches;
+    assert(matcher.find_all(lines, line_matches) == 3);
+    assert(line_matches[0].line == 1 && line_matches[0].offset == 7 && line_matches[0].pattern == 0);
+    assert(line_matches[2].line == 2 && line_matches[2].offset == 1);
+}
+
+void test_atom()
+{
+    using namespace acul;
+
+    atom_table table;
+    atom a = table.intern("logger.core");
+    atom b = table.intern(string_view("logger.core.io", 11));
+    atom c = table.intern("logger.io");
+    assert(a == b && a != c && a.id() == b.id() && a.id() != 0);
+    assert(a.view() == "logger.core" && strcmp(a.c_str(), "logger.core") == 0);
+    assert(a.hash() == std::hash<string>()(string("logger.core")));
+    assert(table.find("logger.io") == c && !table.find("absent") && table.size() == 2);
+    assert(!atom() && atom().empty() && atom() != a);
+
+    hashmap<atom, int> counts;
+    counts[a] = 1;
+    counts[table.intern("logger.core")] += 1;
+    assert(counts.size() == 1 && counts[b] == 2);
+
+    // Concurrent interning of the same strings agrees on the entries
+    atom_table shared;
+    vector<atom> seen[2];
+    auto key = [](int i) {
+        char buf[16];
+        return string(buf, to_string(i % 500, buf));
+    };
+    auto work = [&](vector<atom> &out) {
+        for (int i = 0; i < 2000; ++i) out.push_back(shared.intern(key(i)));
+    };
+    std::thread t1(work, std::ref(seen[0]));
+    std::thread t2(work, std::ref(seen[1]));
+    t1.join();
+    t2.join();
+    assert(shared.size() == 500);
+    for (int i = 0; i < 2000; ++i) assert(seen[0][i] == seen[1][i] && seen[0][i].view() == key(i));
+
+    // Refcounted entries go away with their last atom
+    atom_table counted(true);
+    {
+        atom x = counted.intern("temporary");
+        atom y = x;
+        assert(counted.intern("temporary") == y && counted.size() == 1);
+    }
+    assert(counted.size() == 0 && !counted.find("temporary"));
+    atom z = counted.intern("temporary");
+    assert(z.view() == "temporary" && counted.size() == 1);
+    assert(intern("global") == intern("global"));
+}
+
+void test_string_hash()
+{
+    using namespace acul;
+    using namespace acul::literals;
+
+    // Every length class of the hash, evaluated at compile time and compared with std::hash at run time
+    static constexpr char text[] = "The quick brown fox jumps over the lazy dog, then runs across the field and "
+                                   "hides in the forest until the hunters leave the valley at dawn.";
+    constexpr size_t count = sizeof(text);
+    constexpr auto expected = [] {
+        std::array<u64, count> hashes{};
+        for (size_t i = 0; i < count; ++i) hashes[i] = hash_string(text, i);
+        return hashes;
+    }();
+    static_assert(count > 128);
+    for (size_t i = 0; i < count; ++i)
+    {
+        assert(expected[i] == std::hash<string>()(string(text, i)));
+        assert(expected[i] == std::hash<string_view>()(string_view(text, i)));
+    }
+
+    static_assert("asset.loaded"_hash == hash_string("asset.loaded"));
+    assert("asset.loaded"_hash == std::hash<string>()("asset.loaded"));
+
+    auto level = [](string_view name) {
+        switch (hash_string(name))
+        {
+            case "info"_hash:
+                return 1;
+            case "warn"_hash:
+                return 2;
+            case "error"_hash:
+                return 3;
+            default:
+                return 0;
+        }
+    };
+    assert(level("info") == 1 && level("warn") == 2 && level("error") == 3 && level("debug") == 0);
+}
+
+void test_inline_string()
+{
+    using namespace acul;
+    using key = inline_string<48>;
+    static_assert(std::is_trivially_copyable_v<key>);
+    static_assert(sizeof(key) == 50);
+
+    const char *guid = "6f1c2a9e-33b4-4d8e-9a51-0c7e2f4b8d10.asset";
+    key a(guid);
+    assert(a.size() == strlen(guid) && a == guid && a.view() == string_view(guid));
+    assert(std::hash<key>()(a) == std::hash<string>()(string(guid)));
+    assert(a.find('.') == 36 && a.substr(37) == "asset" && a.str() == string(guid));
+
+    key b = a;
+    b.resize(36);
+    b += ".meta";
+    assert(b != a && a < b && b.c_str()[b.size()] == '\0');
+    b.pop_back();
+    assert(b.back() == 't');
+
+    bool thrown = false;
+    try
+    {
+        b.append(guid, strlen(guid));
+    }
+    catch (const out_of_range &)
+    {
+        thrown = true;
+    }
+    assert(thrown && b.size() == 40);
+
+    stringstream ss;
+    ss << a << '|' << b;
+    assert(ss.str() == string(guid) + "|" + "6f1c2a9e-33b4-4d8e-9a51-0c7e2f4b8d10.met");
+
+    hl_hashmap<key, int> map;
+    for (int i = 0; i < 1000; ++i)
+    {
+        key k(guid);
+        k.resize(30);
+        char buf[16];
+        k.append(buf, to_string(i, buf));
+        map[k] = i;
+    }
+    assert(map.size() == 1000 && map[key("6f1c2a9e-33b4-4d8e-9a51-0c7e2f999")] == 999);
+
+    // UTF-16 orders by code unit, not by byte
+    using wkey = inline_u16string<8>;
+    assert(wkey(u"\u0001") < wkey(u"\u0100"));
+    assert(!(wkey(u"\u0100") < wkey(u"\u0001")));
+    assert(wkey(u"ab").compare(u"ab\u0100") < 0 && wkey(u"b").compare(u"a\uFFFF") > 0);
 }
 
 void test_string()
@@ -203,4 +673,14 @@ void test_string()
     test_string_view_pool();
     test_string_view();
     test_utils();
+    test_search();
+    test_line_reader();
+    test_fill_line_buffer_parallel();
+    test_line_index();
+    test_tokenizer();
+    test_multi_search();
+    test_atom();
+    test_inline_string();
+    test_string_hash();
+    test_format();
 }
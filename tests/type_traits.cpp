@@ -1,6 +1,10 @@
 #include <acul/list.hpp>
 #include <acul/type_traits.hpp>
 #include <acul/functional/unique_function.hpp>
+#include <acul/memory/smart_ptr.hpp>
+#include <acul/pair.hpp>
+#include <acul/small_vector.hpp>
+#include <acul/string/string.hpp>
 #include <acul/vector.hpp>
 #include <cassert>
 #include <iterator>
@@ -98,6 +102,70 @@ void test_is_char_and_integer()
     assert(!is_nonchar3);
 }
 
+struct self_pointing
+{
+    self_pointing *self = this;
+    self_pointing() = default;
+    self_pointing(const self_pointing &) : self(this) {}
+};
+
+struct opted_in
+{
+    using trivially_relocatable = acul::relocatable_tag<opted_in>;
+    acul::string name;
+    opted_in() = default;
+    opted_in(const opted_in &other) : name(other.name) {}
+};
+
+// Inherits the alias of opted_in, but not the promise
+struct derived_from_opted_in : opted_in
+{
+    self_pointing tracker;
+};
+
+struct derived_from_string : acul::string
+{
+    self_pointing tracker;
+};
+
+void test_is_trivially_relocatable()
+{
+    assert(acul::is_trivially_relocatable_v<int>);
+    assert(acul::is_trivially_relocatable_v<acul::string>);
+    assert(acul::is_trivially_relocatable_v<acul::vector<acul::string>>);
+    assert(acul::is_trivially_relocatable_v<acul::shared_ptr<int>>);
+    assert(acul::is_trivially_relocatable_v<acul::unique_ptr<int>>);
+    assert(acul::is_trivially_relocatable_v<acul::unique_function<void()>>);
+    assert((acul::is_trivially_relocatable_v<acul::pair<acul::string, int>>));
+    assert(acul::is_trivially_relocatable_v<opted_in>);
+    assert(!acul::is_trivially_relocatable_v<self_pointing>);
+    assert(!acul::is_trivially_relocatable_v<derived_from_opted_in>);
+    assert(!acul::is_trivially_relocatable_v<derived_from_string>);
+    assert((!acul::is_trivially_relocatable_v<acul::unique_ptr<int, self_pointing>>));
+    assert((!acul::is_trivially_relocatable_v<acul::pair<int, self_pointing>>));
+    assert((!acul::is_trivially_relocatable_v<acul::small_vector<int, 2>>));
+
+    // Growth relocates the strings by copying their bytes
+    acul::vector<acul::string> v;
+    for (int i = 0; i < 100; ++i) v.emplace_back("a string long enough to live on the heap");
+    v.insert(v.begin(), acul::string("front"));
+    v.erase(v.begin() + 1, v.begin() + 50);
+    assert(v.size() == 52);
+    assert(v.front() == "front" && v.back() == "a string long enough to live on the heap");
+
+    // A target that is not relocatable goes to the heap
+    int calls = 0;
+    acul::unique_function<void()> fn = [&calls, sp = self_pointing()] {
+        assert(sp.self == &sp);
+        ++calls;
+    };
+    acul::vector<acul::unique_function<void()>> fns;
+    fns.push_back(std::move(fn));
+    for (int i = 0; i < 16; ++i) fns.emplace_back([&calls] { ++calls; });
+    for (auto &f : fns) f();
+    assert(calls == 17);
+}
+
 void test_type_traits()
 {
     test_lambda_arg_traits();
@@ -105,4 +173,5 @@ void test_type_traits()
     test_is_same_base();
     test_has_args();
     test_is_char_and_integer();
+    test_is_trivially_relocatable();
 }